@@ -437,6 +437,8 @@ endif
     SRC += $(QUANTUM_DIR)/rgb_matrix/rgb_matrix_drivers.c
     SRC += $(LIB_PATH)/lib8tion/lib8tion.c
     CIE1931_CURVE := yes
+    # RGB_MATRIX_GAMMA_CORRECTION reads the 16-bit curve
+    LED_TABLES := yes
     RGB_KEYCODES_ENABLE := yes
 
     ifeq ($(strip $(RGB_MATRIX_DRIVER)), AW20216)
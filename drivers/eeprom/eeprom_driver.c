@@ -19,6 +19,25 @@
 
 #include "eeprom_driver.h"
 
+#if defined(EEPROM_I2C)
+#    include "eeprom_i2c.h"
+#elif defined(EEPROM_SPI)
+#    include "eeprom_spi.h"
+#endif
+
+/*
+    The granularity used when diffing in eeprom_update_block(). External
+    EEPROMs use their page size so that each dirty run maps onto exactly one
+    page write; everything else uses a small fixed-size chunk.
+*/
+#ifndef EEPROM_DRIVER_UPDATE_CHUNK_SIZE
+#    if defined(EXTERNAL_EEPROM_PAGE_SIZE)
+#        define EEPROM_DRIVER_UPDATE_CHUNK_SIZE EXTERNAL_EEPROM_PAGE_SIZE
+#    else
+#        define EEPROM_DRIVER_UPDATE_CHUNK_SIZE 32
+#    endif
+#endif
+
 uint8_t eeprom_read_byte(const uint8_t *addr) {
     uint8_t ret = 0;
     eeprom_read_block(&ret, addr, 1);
@@ -50,10 +69,35 @@ void eeprom_write_dword(uint32_t *addr, uint32_t value) {
 }
 
 void eeprom_update_block(const void *buf, void *addr, size_t len) {
-    uint8_t read_buf[len];
-    eeprom_read_block(read_buf, addr, len);
-    if (memcmp(buf, read_buf, len) != 0) {
-        eeprom_write_block(buf, addr, len);
+    const uint8_t *src         = (const uint8_t *)buf;
+    uintptr_t      target_addr = (uintptr_t)addr;
+    uint8_t        read_buf[EEPROM_DRIVER_UPDATE_CHUNK_SIZE];
+
+    while (len > 0) {
+        // Work in chunks aligned to the chunk size, so that a chunk never straddles a device page
+        size_t chunk_length = EEPROM_DRIVER_UPDATE_CHUNK_SIZE - (target_addr % EEPROM_DRIVER_UPDATE_CHUNK_SIZE);
+        if (chunk_length > len) {
+            chunk_length = len;
+        }
+
+        eeprom_read_block(read_buf, (const void *)target_addr, chunk_length);
+
+        // Merge all changed bytes within the chunk into a single run, and only write that run
+        size_t first = 0;
+        while (first < chunk_length && read_buf[first] == src[first]) {
+            ++first;
+        }
+        if (first < chunk_length) {
+            size_t last = chunk_length - 1;
+            while (read_buf[last] == src[last]) {
+                --last;
+            }
+            eeprom_write_block(&src[first], (void *)(target_addr + first), last - first + 1);
+        }
+
+        src += chunk_length;
+        target_addr += chunk_length;
+        len -= chunk_length;
     }
 }
 
@@ -15,6 +15,7 @@
  */
 
 #include <stdint.h>
+#include <stdbool.h>
 #include <string.h>
 #if defined(EXTERNAL_EEPROM_WP_PIN)
 #    include "gpio.h"
@@ -34,6 +35,7 @@
 */
 
 #include "wait.h"
+#include "timer.h"
 #include "i2c_master.h"
 #include "eeprom.h"
 #include "eeprom_i2c.h"
@@ -41,10 +43,14 @@
 // #define DEBUG_EEPROM_OUTPUT
 
 #if defined(CONSOLE_ENABLE) && defined(DEBUG_EEPROM_OUTPUT)
-#    include "timer.h"
 #    include "debug.h"
 #endif // DEBUG_EEPROM_OUTPUT
 
+#if EXTERNAL_EEPROM_WRITE_TIME > 0
+static bool     write_pending = false;
+static uint16_t write_start_time;
+#endif
+
 static inline void fill_target_address(uint8_t *buffer, const void *addr) {
     uintptr_t p = (uintptr_t)addr;
     for (int i = 0; i < EXTERNAL_EEPROM_ADDRESS_SIZE; ++i) {
@@ -53,6 +59,30 @@ static inline void fill_target_address(uint8_t *buffer, const void *addr) {
     }
 }
 
+/*
+    Page writes are not followed by a fixed delay; instead, the EEPROM is left
+    to complete its internal write cycle in the background, and the next
+    transaction polls the device -- it will NACK its address until the write
+    has finished. Back-to-back page writes therefore only wait as long as the
+    chip actually needs, and a final write costs no wait at all.
+*/
+static void eeprom_i2c_wait_for_write_completion(const void *addr) {
+#if EXTERNAL_EEPROM_WRITE_TIME > 0
+    if (!write_pending) {
+        return;
+    }
+    write_pending = false;
+
+    uint8_t complete_packet[EXTERNAL_EEPROM_ADDRESS_SIZE];
+    fill_target_address(complete_packet, addr);
+    while (timer_elapsed(write_start_time) <= EXTERNAL_EEPROM_WRITE_TIME) {
+        if (i2c_transmit(EXTERNAL_EEPROM_I2C_ADDRESS((uintptr_t)addr), complete_packet, EXTERNAL_EEPROM_ADDRESS_SIZE, 100) == I2C_STATUS_SUCCESS) {
+            return;
+        }
+    }
+#endif
+}
+
 void eeprom_driver_init(void) {
     i2c_init();
 #if defined(EXTERNAL_EEPROM_WP_PIN)
@@ -82,6 +112,7 @@ void eeprom_read_block(void *buf, const void *addr, size_t len) {
     uint8_t complete_packet[EXTERNAL_EEPROM_ADDRESS_SIZE];
     fill_target_address(complete_packet, addr);
 
+    eeprom_i2c_wait_for_write_completion(addr);
     i2c_transmit(EXTERNAL_EEPROM_I2C_ADDRESS((uintptr_t)addr), complete_packet, EXTERNAL_EEPROM_ADDRESS_SIZE, 100);
     i2c_receive(EXTERNAL_EEPROM_I2C_ADDRESS((uintptr_t)addr), buf, len, 100);
 
@@ -124,8 +155,12 @@ void eeprom_write_block(const void *buf, void *addr, size_t len) {
         dprintf("\n");
 #endif // DEBUG_EEPROM_OUTPUT
 
+        eeprom_i2c_wait_for_write_completion((const void *)target_addr);
         i2c_transmit(EXTERNAL_EEPROM_I2C_ADDRESS((uintptr_t)addr), complete_packet, EXTERNAL_EEPROM_ADDRESS_SIZE + write_length, 100);
-        wait_ms(EXTERNAL_EEPROM_WRITE_TIME);
+#if EXTERNAL_EEPROM_WRITE_TIME > 0
+        write_pending    = true;
+        write_start_time = timer_read();
+#endif
 
         read_buf += write_length;
         target_addr += write_length;
@@ -133,6 +168,9 @@ void eeprom_write_block(const void *buf, void *addr, size_t len) {
     }
 
 #if defined(EXTERNAL_EEPROM_WP_PIN)
+    /* Keep the WP pin low until the final page has been committed */
+    eeprom_i2c_wait_for_write_completion(addr);
+
     /* We are setting the WP pin to high in a way that requires at least two bit-flips to change back to 0 */
     writePin(EXTERNAL_EEPROM_WP_PIN, 1);
     setPinInputHigh(EXTERNAL_EEPROM_WP_PIN);
@@ -18,6 +18,7 @@
 #include "print.h"
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
 #include <math.h>
 
 uint8_t DRV2605L_transfer_buffer[2];
@@ -116,7 +117,19 @@ void DRV_amplitude(uint8_t amplitude) {
 }
 
 void DRV_pulse(uint8_t sequence) {
+    DRV_sequence(&sequence, 1);
+}
+
+/* Loads up to DRV_SEQUENCE_LENGTH effects into the waveform sequencer and plays them back to back.
+ * All the slots and the GO register are consecutive, so they are written in a single transfer. */
+void DRV_sequence(const uint8_t *sequence, uint8_t length) {
+    uint8_t registers[DRV_SEQUENCE_LENGTH + 1] = {0}; // unused slots end the sequence
+    if (length > DRV_SEQUENCE_LENGTH) {
+        length = DRV_SEQUENCE_LENGTH;
+    }
+    memcpy(registers, sequence, length);
+    registers[DRV_SEQUENCE_LENGTH] = 0x01; // DRV_GO
+
     DRV_write(DRV_GO, 0x00);
-    DRV_write(DRV_WAVEFORM_SEQ_1, sequence);
-    DRV_write(DRV_GO, 0x01);
+    i2c_writeReg(DRV2605L_BASE_ADDRESS << 1, DRV_WAVEFORM_SEQ_1, registers, sizeof(registers), 100);
 }
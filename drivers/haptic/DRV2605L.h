@@ -144,6 +144,7 @@
 #define DRV_WAVEFORM_SEQ_7 0x0A
 #define DRV_WAVEFORM_SEQ_8 0x0B
 #define DRV_GO 0x0C
+#define DRV_SEQUENCE_LENGTH 8 /* Number of waveform sequencer slots */
 #define DRV_OVERDRIVE_TIME_OFFSET 0x0D
 #define DRV_SUSTAIN_TIME_OFFSET_P 0x0E
 #define DRV_SUSTAIN_TIME_OFFSET_N 0x0F
@@ -173,6 +174,7 @@ uint8_t DRV_read(const uint8_t regaddress);
 void    DRV_rtp_init(void);
 void    DRV_amplitude(const uint8_t amplitude);
 void    DRV_pulse(const uint8_t sequence);
+void    DRV_sequence(const uint8_t *sequence, uint8_t length);
 
 typedef enum DRV_EFFECT {
     clear_sequence                       = 0,
@@ -19,6 +19,7 @@
 #include "is31fl3731.h"
 #include "i2c_master.h"
 #include "wait.h"
+#include <string.h>
 
 // This is a 7-bit address, that gets left-shifted and bit 0
 // set to 0 for write, 1 for read (as per I2C protocol)
@@ -71,6 +72,9 @@ bool    g_pwm_buffer_update_required[DRIVER_COUNT] = {false};
 uint8_t g_led_control_registers[DRIVER_COUNT][18]             = {{0}};
 bool    g_led_control_registers_update_required[DRIVER_COUNT] = {false};
 
+// A register address followed by up to all of the PWM registers, kept off the stack
+static uint8_t g_burst_buffer[1 + 144];
+
 // This is the bit pattern in the LED control registers
 // (for matrix A, add one to register for matrix B)
 //
@@ -98,29 +102,25 @@ void IS31FL3731_write_register(uint8_t addr, uint8_t reg, uint8_t data) {
 #endif
 }
 
-void IS31FL3731_write_pwm_buffer(uint8_t addr, uint8_t *pwm_buffer) {
-    // assumes bank is already selected
-
-    // transmit PWM registers in 9 transfers of 16 bytes
-    // g_twi_transfer_buffer[] is 20 bytes
-
-    // iterate over the pwm_buffer contents at 16 byte intervals
-    for (int i = 0; i < 144; i += 16) {
-        // set the first register, e.g. 0x24, 0x34, 0x44, etc.
-        g_twi_transfer_buffer[0] = 0x24 + i;
-        // copy the data from i to i+15
-        // device will auto-increment register for data after the first byte
-        // thus this sets registers 0x24-0x33, 0x34-0x43, etc. in one transfer
-        memcpy(g_twi_transfer_buffer + 1, pwm_buffer + i, 16);
-
+static void IS31FL3731_write_burst(uint8_t addr, uint8_t reg, const uint8_t *data, uint16_t length) {
+    // device will auto-increment register for data after the first byte,
+    // so a whole block of registers can be set in one transfer
+    g_burst_buffer[0] = reg;
+    memcpy(&g_burst_buffer[1], data, length);
 #if ISSI_PERSISTENCE > 0
-        for (uint8_t i = 0; i < ISSI_PERSISTENCE; i++) {
-            if (i2c_transmit(addr << 1, g_twi_transfer_buffer, 17, ISSI_TIMEOUT) == 0) break;
-        }
+    for (uint8_t i = 0; i < ISSI_PERSISTENCE; i++) {
+        if (i2c_transmit(addr << 1, g_burst_buffer, length + 1, ISSI_TIMEOUT) == 0) break;
+    }
 #else
-        i2c_transmit(addr << 1, g_twi_transfer_buffer, 17, ISSI_TIMEOUT);
+    i2c_transmit(addr << 1, g_burst_buffer, length + 1, ISSI_TIMEOUT);
 #endif
-    }
+}
+
+void IS31FL3731_write_pwm_buffer(uint8_t addr, uint8_t *pwm_buffer) {
+    // assumes bank is already selected
+
+    // transmit all 144 PWM registers (0x24-0xB3) in a single transfer
+    IS31FL3731_write_burst(addr, 0x24, pwm_buffer, 144);
 }
 
 void IS31FL3731_init(uint8_t addr) {
@@ -236,9 +236,7 @@ void IS31FL3731_update_pwm_buffers(uint8_t addr, uint8_t index) {
 
 void IS31FL3731_update_led_control_registers(uint8_t addr, uint8_t index) {
     if (g_led_control_registers_update_required[index]) {
-        for (int i = 0; i < 18; i++) {
-            IS31FL3731_write_register(addr, i, g_led_control_registers[index][i]);
-        }
+        IS31FL3731_write_burst(addr, 0x00, g_led_control_registers[index], 18);
     }
     g_led_control_registers_update_required[index] = false;
 }
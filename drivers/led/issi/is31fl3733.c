@@ -20,6 +20,7 @@
 #include "is31fl3733.h"
 #include "i2c_master.h"
 #include "wait.h"
+#include <string.h>
 
 // This is a 7-bit address, that gets left-shifted and bit 0
 // set to 0 for write, 1 for read (as per I2C protocol)
@@ -88,6 +89,13 @@ bool    g_pwm_buffer_update_required[DRIVER_COUNT] = {false};
 uint8_t g_led_control_registers[DRIVER_COUNT][24]             = {0};
 bool    g_led_control_registers_update_required[DRIVER_COUNT] = {false};
 
+// The page each driver was last left on, plus one so that zero means unknown.
+// Selecting a page takes two writes, which are skipped if it is already selected.
+static uint8_t g_selected_page[DRIVER_COUNT] = {0};
+
+// A register address followed by up to all of the PWM registers, kept off the stack
+static uint8_t g_burst_buffer[1 + 192];
+
 bool IS31FL3733_write_register(uint8_t addr, uint8_t reg, uint8_t data) {
     // If the transaction fails function returns false.
     g_twi_transfer_buffer[0] = reg;
@@ -107,37 +115,44 @@ bool IS31FL3733_write_register(uint8_t addr, uint8_t reg, uint8_t data) {
     return true;
 }
 
-bool IS31FL3733_write_pwm_buffer(uint8_t addr, uint8_t *pwm_buffer) {
-    // Assumes PG1 is already selected.
-    // If any of the transactions fails function returns false.
-    // Transmit PWM registers in 12 transfers of 16 bytes.
-    // g_twi_transfer_buffer[] is 20 bytes
-
-    // Iterate over the pwm_buffer contents at 16 byte intervals.
-    for (int i = 0; i < 192; i += 16) {
-        g_twi_transfer_buffer[0] = i;
-        // Copy the data from i to i+15.
-        // Device will auto-increment register for data after the first byte
-        // Thus this sets registers 0x00-0x0F, 0x10-0x1F, etc. in one transfer.
-        for (int j = 0; j < 16; j++) {
-            g_twi_transfer_buffer[1 + j] = pwm_buffer[i + j];
-        }
-
+static bool IS31FL3733_write_burst(uint8_t addr, uint8_t reg, const uint8_t *data, uint16_t length) {
+    // Device will auto-increment register for data after the first byte,
+    // so a whole page can be set in one transfer.
+    g_burst_buffer[0] = reg;
+    memcpy(&g_burst_buffer[1], data, length);
 #if ISSI_PERSISTENCE > 0
-        for (uint8_t i = 0; i < ISSI_PERSISTENCE; i++) {
-            if (i2c_transmit(addr << 1, g_twi_transfer_buffer, 17, ISSI_TIMEOUT) != 0) {
-                return false;
-            }
+    for (uint8_t i = 0; i < ISSI_PERSISTENCE; i++) {
+        if (i2c_transmit(addr << 1, g_burst_buffer, length + 1, ISSI_TIMEOUT) == 0) {
+            return true;
         }
+    }
+    return false;
 #else
-        if (i2c_transmit(addr << 1, g_twi_transfer_buffer, 17, ISSI_TIMEOUT) != 0) {
-            return false;
-        }
+    return i2c_transmit(addr << 1, g_burst_buffer, length + 1, ISSI_TIMEOUT) == 0;
 #endif
+}
+
+static bool IS31FL3733_select_page(uint8_t addr, uint8_t index, uint8_t page) {
+    if (g_selected_page[index] == page + 1) {
+        return true;
+    }
+
+    // Unlock the command register and select the page.
+    g_selected_page[index] = 0;
+    if (!IS31FL3733_write_register(addr, ISSI_COMMANDREGISTER_WRITELOCK, 0xC5) || !IS31FL3733_write_register(addr, ISSI_COMMANDREGISTER, page)) {
+        return false;
     }
+    g_selected_page[index] = page + 1;
     return true;
 }
 
+bool IS31FL3733_write_pwm_buffer(uint8_t addr, uint8_t *pwm_buffer) {
+    // Assumes PG1 is already selected.
+    // If the transaction fails function returns false.
+    // Transmit all 192 PWM registers in a single transfer.
+    return IS31FL3733_write_burst(addr, 0x00, pwm_buffer, 192);
+}
+
 void IS31FL3733_init(uint8_t addr, uint8_t sync) {
     // In order to avoid the LEDs being driven with garbage data
     // in the LED driver's PWM registers, shutdown is enabled last.
@@ -145,6 +160,9 @@ void IS31FL3733_init(uint8_t addr, uint8_t sync) {
     // then disable software shutdown.
     // Sync is passed so set it according to the datasheet.
 
+    // The page will be left on PG3, the driver index isn't known here.
+    memset(g_selected_page, 0, sizeof(g_selected_page));
+
     // Unlock the command register.
     IS31FL3733_write_register(addr, ISSI_COMMANDREGISTER_WRITELOCK, 0xC5);
 
@@ -234,13 +252,11 @@ void IS31FL3733_set_led_control_register(uint8_t index, bool red, bool green, bo
 
 void IS31FL3733_update_pwm_buffers(uint8_t addr, uint8_t index) {
     if (g_pwm_buffer_update_required[index]) {
-        // Firstly we need to unlock the command register and select PG1.
-        IS31FL3733_write_register(addr, ISSI_COMMANDREGISTER_WRITELOCK, 0xC5);
-        IS31FL3733_write_register(addr, ISSI_COMMANDREGISTER, ISSI_PAGE_PWM);
-
+        // Firstly we need PG1 selected.
         // If any of the transactions fail we risk writing dirty PG0,
         // refresh page 0 just in case.
-        if (!IS31FL3733_write_pwm_buffer(addr, g_pwm_buffer[index])) {
+        if (!IS31FL3733_select_page(addr, index, ISSI_PAGE_PWM) || !IS31FL3733_write_pwm_buffer(addr, g_pwm_buffer[index])) {
+            g_selected_page[index]                         = 0;
             g_led_control_registers_update_required[index] = true;
         }
     }
@@ -249,11 +265,9 @@ void IS31FL3733_update_pwm_buffers(uint8_t addr, uint8_t index) {
 
 void IS31FL3733_update_led_control_registers(uint8_t addr, uint8_t index) {
     if (g_led_control_registers_update_required[index]) {
-        // Firstly we need to unlock the command register and select PG0
-        IS31FL3733_write_register(addr, ISSI_COMMANDREGISTER_WRITELOCK, 0xC5);
-        IS31FL3733_write_register(addr, ISSI_COMMANDREGISTER, ISSI_PAGE_LEDCONTROL);
-        for (int i = 0; i < 24; i++) {
-            IS31FL3733_write_register(addr, i, g_led_control_registers[index][i]);
+        // Firstly we need PG0 selected, then all 24 registers are sent in one transfer.
+        if (!IS31FL3733_select_page(addr, index, ISSI_PAGE_LEDCONTROL) || !IS31FL3733_write_burst(addr, 0x00, g_led_control_registers[index], 24)) {
+            g_selected_page[index] = 0;
         }
     }
     g_led_control_registers_update_required[index] = false;
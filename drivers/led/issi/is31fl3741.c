@@ -90,6 +90,17 @@ bool    g_scaling_registers_update_required[DRIVER_COUNT] = {false};
 
 uint8_t g_scaling_registers[DRIVER_COUNT][ISSI_MAX_LEDS];
 
+// The registers are split over two pages, the first holding CS1_SW1 to CS30_SW6
+#define ISSI_PAGE_0_SIZE (CS1_SW7 - CS1_SW1)
+#define ISSI_PAGE_1_SIZE (ISSI_MAX_LEDS - ISSI_PAGE_0_SIZE)
+
+// The page each driver was last left on, plus one so that zero means unknown.
+// Selecting a page takes two writes, which are skipped if it is already selected.
+static uint8_t g_selected_page[DRIVER_COUNT] = {0};
+
+// A register address followed by up to a whole page of data (the first page being the larger), kept off the stack
+static uint8_t g_burst_buffer[1 + ISSI_PAGE_0_SIZE];
+
 void IS31FL3741_write_register(uint8_t addr, uint8_t reg, uint8_t data) {
     g_twi_transfer_buffer[0] = reg;
     g_twi_transfer_buffer[1] = data;
@@ -103,48 +114,50 @@ void IS31FL3741_write_register(uint8_t addr, uint8_t reg, uint8_t data) {
 #endif
 }
 
-bool IS31FL3741_write_pwm_buffer(uint8_t addr, uint8_t *pwm_buffer) {
-    // Assume PG0 is already selected
-
-    for (int i = 0; i < 342; i += 18) {
-        if (i == 180) {
-            // unlock the command register and select PG1
-            IS31FL3741_write_register(addr, ISSI_COMMANDREGISTER_WRITELOCK, 0xC5);
-            IS31FL3741_write_register(addr, ISSI_COMMANDREGISTER, ISSI_PAGE_PWM1);
-        }
-
-        g_twi_transfer_buffer[0] = i % 180;
-        memcpy(g_twi_transfer_buffer + 1, pwm_buffer + i, 18);
-
+static bool IS31FL3741_write_burst(uint8_t addr, uint8_t reg, const uint8_t *data, uint16_t length) {
+    // Device will auto-increment register for data after the first byte,
+    // so a whole page can be set in one transfer.
+    g_burst_buffer[0] = reg;
+    memcpy(&g_burst_buffer[1], data, length);
 #if ISSI_PERSISTENCE > 0
-        for (uint8_t i = 0; i < ISSI_PERSISTENCE; i++) {
-            if (i2c_transmit(addr << 1, g_twi_transfer_buffer, 19, ISSI_TIMEOUT) != 0) {
-                return false;
-            }
+    for (uint8_t i = 0; i < ISSI_PERSISTENCE; i++) {
+        if (i2c_transmit(addr << 1, g_burst_buffer, length + 1, ISSI_TIMEOUT) == 0) {
+            return true;
         }
+    }
+    return false;
 #else
-        if (i2c_transmit(addr << 1, g_twi_transfer_buffer, 19, ISSI_TIMEOUT) != 0) {
-            return false;
-        }
+    return i2c_transmit(addr << 1, g_burst_buffer, length + 1, ISSI_TIMEOUT) == 0;
 #endif
+}
+
+static void IS31FL3741_select_page(uint8_t addr, uint8_t index, uint8_t page) {
+    if (g_selected_page[index] == page + 1) {
+        return;
     }
 
-    // transfer the left cause the total number is 351
-    g_twi_transfer_buffer[0] = 162;
-    memcpy(g_twi_transfer_buffer + 1, pwm_buffer + 342, 9);
+    // unlock the command register and select the page
+    IS31FL3741_write_register(addr, ISSI_COMMANDREGISTER_WRITELOCK, 0xC5);
+    IS31FL3741_write_register(addr, ISSI_COMMANDREGISTER, page);
+    g_selected_page[index] = page + 1;
+}
 
-#if ISSI_PERSISTENCE > 0
-    for (uint8_t i = 0; i < ISSI_PERSISTENCE; i++) {
-        if (i2c_transmit(addr << 1, g_twi_transfer_buffer, 10, ISSI_TIMEOUT) != 0) {
-            return false;
-        }
+// Writes either half of a buffer to the matching page, the pages holding the first half being even
+static bool IS31FL3741_write_page(uint8_t addr, uint8_t index, uint8_t page, uint8_t *buffer) {
+    IS31FL3741_select_page(addr, index, page);
+    if (page % 2 == 0) {
+        return IS31FL3741_write_burst(addr, 0x00, buffer, ISSI_PAGE_0_SIZE);
+    } else {
+        return IS31FL3741_write_burst(addr, 0x00, buffer + ISSI_PAGE_0_SIZE, ISSI_PAGE_1_SIZE);
     }
-#else
-    if (i2c_transmit(addr << 1, g_twi_transfer_buffer, 10, ISSI_TIMEOUT) != 0) {
+}
+
+bool IS31FL3741_write_pwm_buffer(uint8_t addr, uint8_t index, uint8_t *pwm_buffer) {
+    if (!IS31FL3741_write_page(addr, index, ISSI_PAGE_PWM0, pwm_buffer) || !IS31FL3741_write_page(addr, index, ISSI_PAGE_PWM1, pwm_buffer)) {
+        // the selected page is unknown after a failed transfer
+        g_selected_page[index] = 0;
         return false;
     }
-#endif
-
     return true;
 }
 
@@ -155,6 +168,9 @@ void IS31FL3741_init(uint8_t addr) {
     // then disable software shutdown.
     // Unlock the command register.
 
+    // The page will be left on PG4, the driver index isn't known here.
+    memset(g_selected_page, 0, sizeof(g_selected_page));
+
     // Unlock the command register.
     IS31FL3741_write_register(addr, ISSI_COMMANDREGISTER_WRITELOCK, 0xC5);
 
@@ -220,11 +236,13 @@ void IS31FL3741_set_led_control_register(uint8_t index, bool red, bool green, bo
 
 void IS31FL3741_update_pwm_buffers(uint8_t addr, uint8_t index) {
     if (g_pwm_buffer_update_required[index]) {
-        // unlock the command register and select PG2
-        IS31FL3741_write_register(addr, ISSI_COMMANDREGISTER_WRITELOCK, 0xC5);
-        IS31FL3741_write_register(addr, ISSI_COMMANDREGISTER, ISSI_PAGE_PWM0);
+        // Start with whichever PWM page is still selected from the last update, saving a page switch
+        uint8_t first = g_selected_page[index] == ISSI_PAGE_PWM1 + 1 ? ISSI_PAGE_PWM1 : ISSI_PAGE_PWM0;
+        uint8_t last  = first == ISSI_PAGE_PWM0 ? ISSI_PAGE_PWM1 : ISSI_PAGE_PWM0;
 
-        IS31FL3741_write_pwm_buffer(addr, g_pwm_buffer[index]);
+        if (!IS31FL3741_write_page(addr, index, first, g_pwm_buffer[index]) || !IS31FL3741_write_page(addr, index, last, g_pwm_buffer[index])) {
+            g_selected_page[index] = 0;
+        }
     }
 
     g_pwm_buffer_update_required[index] = false;
@@ -240,22 +258,9 @@ void IS31FL3741_set_pwm_buffer(const is31_led *pled, uint8_t red, uint8_t green,
 
 void IS31FL3741_update_led_control_registers(uint8_t addr, uint8_t index) {
     if (g_scaling_registers_update_required[index]) {
-        // unlock the command register and select PG2
-        IS31FL3741_write_register(addr, ISSI_COMMANDREGISTER_WRITELOCK, 0xC5);
-        IS31FL3741_write_register(addr, ISSI_COMMANDREGISTER, ISSI_PAGE_SCALING_0);
-
-        // CS1_SW1 to CS30_SW6 are on PG2
-        for (int i = CS1_SW1; i <= CS30_SW6; ++i) {
-            IS31FL3741_write_register(addr, i, g_scaling_registers[index][i]);
-        }
-
-        // unlock the command register and select PG3
-        IS31FL3741_write_register(addr, ISSI_COMMANDREGISTER_WRITELOCK, 0xC5);
-        IS31FL3741_write_register(addr, ISSI_COMMANDREGISTER, ISSI_PAGE_SCALING_1);
-
-        // CS1_SW7 to CS39_SW9 are on PG3
-        for (int i = CS1_SW7; i <= CS39_SW9; ++i) {
-            IS31FL3741_write_register(addr, i - CS1_SW7, g_scaling_registers[index][i]);
+        // CS1_SW1 to CS30_SW6 are on PG2, CS1_SW7 to CS39_SW9 are on PG3
+        if (!IS31FL3741_write_page(addr, index, ISSI_PAGE_SCALING_0, g_scaling_registers[index]) || !IS31FL3741_write_page(addr, index, ISSI_PAGE_SCALING_1, g_scaling_registers[index])) {
+            g_selected_page[index] = 0;
         }
 
         g_scaling_registers_update_required[index] = false;
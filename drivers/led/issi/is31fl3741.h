@@ -34,7 +34,7 @@ extern const is31_led PROGMEM g_is31_leds[RGB_MATRIX_LED_COUNT];
 
 void IS31FL3741_init(uint8_t addr);
 void IS31FL3741_write_register(uint8_t addr, uint8_t reg, uint8_t data);
-bool IS31FL3741_write_pwm_buffer(uint8_t addr, uint8_t *pwm_buffer);
+bool IS31FL3741_write_pwm_buffer(uint8_t addr, uint8_t index, uint8_t *pwm_buffer);
 
 void IS31FL3741_set_color(int index, uint8_t red, uint8_t green, uint8_t blue);
 void IS31FL3741_set_color_all(uint8_t red, uint8_t green, uint8_t blue);
@@ -39,9 +39,22 @@ uint8_t g_twi_transfer_buffer[20];
 uint8_t g_pwm_buffer[DRIVER_COUNT][ISSI_MAX_LEDS];
 bool    g_pwm_buffer_update_required[DRIVER_COUNT] = {false};
 
+// Range of PWM registers changed since the last update, so only those need to be sent
+static uint8_t g_pwm_buffer_dirty_first[DRIVER_COUNT];
+static uint8_t g_pwm_buffer_dirty_last[DRIVER_COUNT];
+// The PWM registers hold unknown values until they have been written once
+static bool g_pwm_buffer_written[DRIVER_COUNT] = {false};
+
 uint8_t g_scaling_buffer[DRIVER_COUNT][ISSI_SCALING_SIZE];
 bool    g_scaling_buffer_update_required[DRIVER_COUNT] = {false};
 
+// The page each driver was last left on, plus one so that zero means unknown.
+// Selecting a page takes two writes, which are skipped if it is already selected.
+static uint8_t g_selected_page[DRIVER_COUNT] = {0};
+
+// A register address followed by up to all of the PWM or scaling registers, kept off the stack
+static uint8_t g_burst_buffer[1 + (ISSI_MAX_LEDS > ISSI_SCALING_SIZE ? ISSI_MAX_LEDS : ISSI_SCALING_SIZE)];
+
 // For writing of single register entry
 void IS31FL_write_single_register(uint8_t addr, uint8_t reg, uint8_t data) {
     // Set register address and register data ready to write
@@ -83,6 +96,30 @@ bool IS31FL_write_multi_registers(uint8_t addr, uint8_t *source_buffer, uint8_t
     return true;
 }
 
+// For writing a whole block of registers in one transfer, using address auto increment
+static bool IS31FL_write_burst(uint8_t addr, uint8_t reg, const uint8_t *data, uint16_t length) {
+    g_burst_buffer[0] = reg;
+    memcpy(&g_burst_buffer[1], data, length);
+#if ISSI_PERSISTENCE > 0
+    for (uint8_t i = 0; i < ISSI_PERSISTENCE; i++) {
+        if (i2c_transmit(addr << 1, g_burst_buffer, length + 1, ISSI_TIMEOUT) == 0) {
+            return true;
+        }
+    }
+    return false;
+#else
+    return i2c_transmit(addr << 1, g_burst_buffer, length + 1, ISSI_TIMEOUT) == 0;
+#endif
+}
+
+// Select a page, unless the driver is already on it
+static void IS31FL_select_page(uint8_t addr, uint8_t index, uint8_t page) {
+    if (g_selected_page[index] != page + 1) {
+        IS31FL_unlock_register(addr, page);
+        g_selected_page[index] = page + 1;
+    }
+}
+
 void IS31FL_unlock_register(uint8_t addr, uint8_t page) {
     // unlock the command register and select Page to write
     IS31FL_write_single_register(addr, ISSI_COMMANDREGISTER_WRITELOCK, ISSI_REGISTER_UNLOCK);
@@ -93,6 +130,16 @@ void IS31FL_common_init(uint8_t addr, uint8_t ssr) {
     // Setup phase, need to take out of software shutdown and configure
     // ISSI_SSR_x is passed to allow Master / Slave setting where applicable
 
+    // The page will be left on the Function Register, the driver index isn't known here
+    memset(g_selected_page, 0, sizeof(g_selected_page));
+    // A (re)initialised driver holds unknown PWM values, so the next update sends the whole buffer
+    memset(g_pwm_buffer_written, 0, sizeof(g_pwm_buffer_written));
+    for (uint8_t i = 0; i < DRIVER_COUNT; i++) {
+        g_pwm_buffer_dirty_first[i]     = 0;
+        g_pwm_buffer_dirty_last[i]      = ISSI_MAX_LEDS - 1;
+        g_pwm_buffer_update_required[i] = true;
+    }
+
     // Unlock the command register & select Function Register
     IS31FL_unlock_register(addr, ISSI_PAGE_FUNCTION);
     // Set Configuration Register to remove Software shutdown
@@ -120,14 +167,42 @@ void IS31FL_common_init(uint8_t addr, uint8_t ssr) {
     wait_ms(10);
 }
 
+static void IS31FL_set_pwm(uint8_t index, uint8_t reg, uint8_t value) {
+    if (g_pwm_buffer[index][reg] == value) {
+        return;
+    }
+    g_pwm_buffer[index][reg] = value;
+
+    if (!g_pwm_buffer_update_required[index]) {
+        g_pwm_buffer_dirty_first[index]     = reg;
+        g_pwm_buffer_dirty_last[index]      = reg;
+        g_pwm_buffer_update_required[index] = true;
+    } else if (reg < g_pwm_buffer_dirty_first[index]) {
+        g_pwm_buffer_dirty_first[index] = reg;
+    } else if (reg > g_pwm_buffer_dirty_last[index]) {
+        g_pwm_buffer_dirty_last[index] = reg;
+    }
+}
+
 void IS31FL_common_update_pwm_register(uint8_t addr, uint8_t index) {
+    if (!g_pwm_buffer_written[index]) {
+        g_pwm_buffer_dirty_first[index]     = 0;
+        g_pwm_buffer_dirty_last[index]      = ISSI_MAX_LEDS - 1;
+        g_pwm_buffer_update_required[index] = true;
+    }
+
     if (g_pwm_buffer_update_required[index]) {
+        uint8_t first = g_pwm_buffer_dirty_first[index];
+        uint8_t last  = g_pwm_buffer_dirty_last[index];
         // Queue up the correct page
-        IS31FL_unlock_register(addr, ISSI_PAGE_PWM);
-        // Hand off the update to IS31FL_write_multi_registers
-        IS31FL_write_multi_registers(addr, g_pwm_buffer[index], ISSI_MAX_LEDS, ISSI_PWM_TRF_SIZE, ISSI_PWM_REG_1ST);
+        IS31FL_select_page(addr, index, ISSI_PAGE_PWM);
+        // Send the dirty range in one transfer
+        if (!IS31FL_write_burst(addr, ISSI_PWM_REG_1ST + first, &g_pwm_buffer[index][first], last - first + 1)) {
+            g_selected_page[index] = 0;
+        }
         // Update flags that pwm_buffer has been updated
         g_pwm_buffer_update_required[index] = false;
+        g_pwm_buffer_written[index]         = true;
     }
 }
 
@@ -157,9 +232,11 @@ void IS31FL_set_manual_scaling_buffer(void) {
 void IS31FL_common_update_scaling_register(uint8_t addr, uint8_t index) {
     if (g_scaling_buffer_update_required[index]) {
         // Queue up the correct page
-        IS31FL_unlock_register(addr, ISSI_PAGE_SCALING);
-        // Hand off the update to IS31FL_write_multi_registers
-        IS31FL_write_multi_registers(addr, g_scaling_buffer[index], ISSI_SCALING_SIZE, ISSI_SCALING_TRF_SIZE, ISSI_SCL_REG_1ST);
+        IS31FL_select_page(addr, index, ISSI_PAGE_SCALING);
+        // Send the whole page in one transfer
+        if (!IS31FL_write_burst(addr, ISSI_SCL_REG_1ST, g_scaling_buffer[index], ISSI_SCALING_SIZE)) {
+            g_selected_page[index] = 0;
+        }
         // Update flags that scaling_buffer has been updated
         g_scaling_buffer_update_required[index] = false;
     }
@@ -171,10 +248,9 @@ void IS31FL_RGB_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
     if (index >= 0 && index < RGB_MATRIX_LED_COUNT) {
         is31_led led = g_is31_leds[index];
 
-        g_pwm_buffer[led.driver][led.r]          = red;
-        g_pwm_buffer[led.driver][led.g]          = green;
-        g_pwm_buffer[led.driver][led.b]          = blue;
-        g_pwm_buffer_update_required[led.driver] = true;
+        IS31FL_set_pwm(led.driver, led.r, red);
+        IS31FL_set_pwm(led.driver, led.g, green);
+        IS31FL_set_pwm(led.driver, led.b, blue);
     }
 }
 
@@ -220,8 +296,7 @@ void IS31FL_simple_set_scaling_buffer(uint8_t index, bool value) {
 void IS31FL_simple_set_brightness(int index, uint8_t value) {
     if (index >= 0 && index < LED_MATRIX_LED_COUNT) {
         is31_led led = g_is31_leds[index];
-        g_pwm_buffer[led.driver][led.v] = value;
-        g_pwm_buffer_update_required[led.driver] = true;
+        IS31FL_set_pwm(led.driver, led.v, value);
     }
 }
 
@@ -162,6 +162,13 @@ uint32_t oled_scroll_timeout;
 #if OLED_UPDATE_INTERVAL > 0
 uint16_t oled_update_timeout;
 #endif
+#if OLED_BUS_UTILIZATION < 1 || OLED_BUS_UTILIZATION > 100
+#    error "OLED_BUS_UTILIZATION must be between 1 and 100"
+#endif
+#if OLED_BUS_UTILIZATION < 100
+uint32_t oled_render_timeout;
+uint8_t  oled_render_backoff_remainder;
+#endif
 
 #if defined(OLED_TRANSPORT_SPI)
 #    ifndef OLED_DC_PIN
@@ -384,25 +391,6 @@ void oled_clear(void) {
     oled_dirty  = OLED_ALL_BLOCKS_MASK;
 }
 
-static void calc_bounds(uint8_t update_start, uint8_t *cmd_array) {
-    // Calculate commands to set memory addressing bounds.
-    uint8_t start_page   = OLED_BLOCK_SIZE * update_start / OLED_DISPLAY_WIDTH;
-    uint8_t start_column = OLED_BLOCK_SIZE * update_start % OLED_DISPLAY_WIDTH;
-#if !OLED_IC_HAS_HORIZONTAL_MODE
-    // Commands for Page Addressing Mode. Sets starting page and column; has no end bound.
-    // Column value must be split into high and low nybble and sent as two commands.
-    cmd_array[0] = PAM_PAGE_ADDR | start_page;
-    cmd_array[1] = PAM_SETCOLUMN_LSB | ((OLED_COLUMN_OFFSET + start_column) & 0x0f);
-    cmd_array[2] = PAM_SETCOLUMN_MSB | ((OLED_COLUMN_OFFSET + start_column) >> 4 & 0x0f);
-#else
-    // Commands for use in Horizontal Addressing mode.
-    cmd_array[1] = start_column + OLED_COLUMN_OFFSET;
-    cmd_array[4] = start_page;
-    cmd_array[2] = (OLED_BLOCK_SIZE + OLED_DISPLAY_WIDTH - 1) % OLED_DISPLAY_WIDTH + cmd_array[1];
-    cmd_array[5] = (OLED_BLOCK_SIZE + OLED_DISPLAY_WIDTH - 1) / OLED_DISPLAY_WIDTH - 1 + cmd_array[4];
-#endif
-}
-
 static void calc_bounds_90(uint8_t update_start, uint8_t *cmd_array) {
     // Block numbering starts from the bottom left corner, going up and then to
     // the right.  The controller needs the page and column numbers for the top
@@ -433,30 +421,156 @@ static void calc_bounds_90(uint8_t update_start, uint8_t *cmd_array) {
 #endif
 }
 
-uint8_t crot(uint8_t a, int8_t n) {
-    const uint8_t mask = 0x7;
-    n &= mask;
-    return a << n | a >> (-n & mask);
+// Transposes an 8x8 bit matrix, so bit i of source byte j ends up as bit (7 - j) of target byte i
+static void rotate_90(const uint8_t *src, uint8_t *dest) {
+    uint32_t x = ((uint32_t)src[0] << 24) | ((uint32_t)src[1] << 16) | ((uint32_t)src[2] << 8) | src[3];
+    uint32_t y = ((uint32_t)src[4] << 24) | ((uint32_t)src[5] << 16) | ((uint32_t)src[6] << 8) | src[7];
+    uint32_t t;
+
+    // Swap 1x1, then 2x2, then 4x4 sub-blocks
+    t = (x ^ (x >> 7)) & 0x00AA00AA;
+    x = x ^ t ^ (t << 7);
+    t = (y ^ (y >> 7)) & 0x00AA00AA;
+    y = y ^ t ^ (t << 7);
+    t = (x ^ (x >> 14)) & 0x0000CCCC;
+    x = x ^ t ^ (t << 14);
+    t = (y ^ (y >> 14)) & 0x0000CCCC;
+    y = y ^ t ^ (t << 14);
+    t = (x & 0xF0F0F0F0) | ((y >> 4) & 0x0F0F0F0F);
+    y = ((x << 4) & 0xF0F0F0F0) | (y & 0x0F0F0F0F);
+    x = t;
+
+    dest[0] = y;
+    dest[1] = y >> 8;
+    dest[2] = y >> 16;
+    dest[3] = y >> 24;
+    dest[4] = x;
+    dest[5] = x >> 8;
+    dest[6] = x >> 16;
+    dest[7] = x >> 24;
 }
 
-static void rotate_90(const uint8_t *src, uint8_t *dest) {
-    for (uint8_t i = 0, shift = 7; i < 8; ++i, --shift) {
-        uint8_t selector = (1 << i);
-        for (uint8_t j = 0; j < 8; ++j) {
-            dest[i] |= crot(src[j] & selector, shift - (int8_t)j);
-        }
+#if defined(OLED_TRANSPORT_SPI) && defined(PROTOCOL_CHIBIOS) && !defined(OLED_SPI_SYNCHRONOUS)
+// Keep the bus for the whole render, sending pixel data in the background
+#    define OLED_RENDER_ASYNC
+#endif
+
+static bool oled_render_start(void) {
+#if defined(OLED_RENDER_ASYNC)
+    return spi_start(OLED_CS_PIN, false, OLED_SPI_MODE, OLED_SPI_DIVISOR);
+#else
+    return true;
+#endif
+}
+
+static void oled_render_stop(void) {
+#if defined(OLED_RENDER_ASYNC)
+    // The last transfer completes while the keyboard carries on scanning
+    spi_stop_async();
+#endif
+}
+
+static bool oled_render_cmd(const uint8_t *data, uint16_t size) {
+#if defined(OLED_RENDER_ASYNC)
+    // Data/command selection can only change once the previous transfer is done
+    spi_wait();
+    writePinLow(OLED_DC_PIN);
+    return spi_transmit(&data[1], size - 1) == SPI_STATUS_SUCCESS;
+#else
+    return oled_send_cmd(data, size);
+#endif
+}
+
+static bool oled_render_data(const uint8_t *data, uint16_t size) {
+#if defined(OLED_RENDER_ASYNC)
+    spi_wait();
+    writePinHigh(OLED_DC_PIN);
+    return spi_transmit_async(data, size) == SPI_STATUS_SUCCESS;
+#else
+    return oled_send_data(data, size);
+#endif
+}
+
+// Sends a run of the buffer that does not cross a page boundary
+static bool oled_render_window(uint16_t start, uint16_t length) {
+    uint8_t page   = start / OLED_DISPLAY_WIDTH;
+    uint8_t column = start % OLED_DISPLAY_WIDTH + OLED_COLUMN_OFFSET;
+#if OLED_IC_HAS_HORIZONTAL_MODE
+    uint8_t display_start[] = {I2C_CMD, COLUMN_ADDR, column, column + length - 1, PAGE_ADDR, page, page};
+#else
+    // Page Addressing Mode has no end bound, column value is split into high and low nybble
+    uint8_t display_start[] = {I2C_CMD, PAM_PAGE_ADDR | page, PAM_SETCOLUMN_LSB | (column & 0x0f), PAM_SETCOLUMN_MSB | (column >> 4 & 0x0f)};
+#endif
+    if (!oled_render_cmd(display_start, ARRAY_SIZE(display_start))) {
+        print("oled_render offset command failed\n");
+        return false;
+    }
+
+#if defined(OLED_RENDER_ASYNC)
+    // The data is still being sent after the render returns, so it is taken from a snapshot that drawing into the
+    // buffer cannot tear - the command above has already waited for the previous window to be sent from it
+    static uint8_t window_buffer[OLED_DISPLAY_WIDTH];
+    memcpy(window_buffer, &oled_buffer[start], length);
+    const uint8_t *data = window_buffer;
+#else
+    const uint8_t *data = &oled_buffer[start];
+#endif
+    if (!oled_render_data(data, length)) {
+        print("oled_render data failed\n");
+        return false;
     }
+    return true;
 }
 
-void oled_render(void) {
-    // Do we have work to do?
-    oled_dirty &= OLED_ALL_BLOCKS_MASK;
-    if (!oled_dirty || !oled_initialized || oled_scrolling) {
-        return;
+static void oled_render_blocks(void) {
+    uint8_t update_start  = 0;
+    uint8_t num_processed = 0;
+    while (oled_dirty && num_processed < OLED_UPDATE_PROCESS_LIMIT) { // render all dirty blocks (up to the configured limit)
+        // Find next dirty block
+        while (!(oled_dirty & ((OLED_BLOCK_TYPE)1 << update_start))) {
+            ++update_start;
+        }
+
+        // Extend over the following dirty blocks, so they are sent together
+        uint8_t update_end = update_start + 1;
+        num_processed++;
+        while (num_processed < OLED_UPDATE_PROCESS_LIMIT && update_end < OLED_BLOCK_COUNT && (oled_dirty & ((OLED_BLOCK_TYPE)1 << update_end))) {
+            ++update_end;
+            ++num_processed;
+        }
+
+        // One window per page touched
+        uint16_t start = OLED_BLOCK_SIZE * update_start;
+        uint16_t end   = OLED_BLOCK_SIZE * update_end;
+        while (start < end) {
+            uint16_t length = OLED_DISPLAY_WIDTH - start % OLED_DISPLAY_WIDTH;
+            if (length > end - start) {
+                length = end - start;
+            }
+            if (!oled_render_window(start, length)) {
+                return;
+            }
+            start += length;
+        }
+
+        // Clear dirty flags of just rendered blocks
+        while (update_start < update_end) {
+            oled_dirty &= ~((OLED_BLOCK_TYPE)1 << update_start++);
+        }
     }
+}
 
-    // Turn on display if it is off
-    oled_on();
+static void oled_render_blocks_90(void) {
+    const static uint8_t source_map[] = OLED_SOURCE_MAP;
+    const static uint8_t target_map[] = OLED_TARGET_MAP;
+
+#if defined(OLED_RENDER_ASYNC)
+    // The next block is rotated while the previous one is still being sent
+    static uint8_t temp_buffers[2][OLED_BLOCK_SIZE];
+#else
+    static uint8_t temp_buffers[1][OLED_BLOCK_SIZE];
+#endif
+    uint8_t buffer_index = 0;
 
     uint8_t update_start  = 0;
     uint8_t num_processed = 0;
@@ -466,74 +580,102 @@ void oled_render(void) {
             ++update_start;
         }
 
+        // Rotate the render chunks
+        uint8_t *temp_buffer = temp_buffers[buffer_index];
+        buffer_index         = (buffer_index + 1) % ARRAY_SIZE(temp_buffers);
+        memset(temp_buffer, 0, OLED_BLOCK_SIZE);
+        for (uint8_t i = 0; i < sizeof(source_map); ++i) {
+            rotate_90(&oled_buffer[OLED_BLOCK_SIZE * update_start + source_map[i]], &temp_buffer[target_map[i]]);
+        }
+
         // Set column & page position
 #if OLED_IC_HAS_HORIZONTAL_MODE
-        static uint8_t display_start[] = {I2C_CMD, COLUMN_ADDR, 0, OLED_DISPLAY_WIDTH - 1, PAGE_ADDR, 0, OLED_DISPLAY_HEIGHT / 8 - 1};
+        uint8_t display_start[] = {I2C_CMD, COLUMN_ADDR, 0, OLED_DISPLAY_WIDTH - 1, PAGE_ADDR, 0, OLED_DISPLAY_HEIGHT / 8 - 1};
 #else
-        static uint8_t display_start[] = {I2C_CMD, PAM_PAGE_ADDR, PAM_SETCOLUMN_LSB, PAM_SETCOLUMN_MSB};
+        uint8_t display_start[] = {I2C_CMD, PAM_PAGE_ADDR, PAM_SETCOLUMN_LSB, PAM_SETCOLUMN_MSB};
 #endif
-        if (!HAS_FLAGS(oled_rotation, OLED_ROTATION_90)) {
-            calc_bounds(update_start, &display_start[1]); // Offset from I2C_CMD byte at the start
-        } else {
-            calc_bounds_90(update_start, &display_start[1]); // Offset from I2C_CMD byte at the start
-        }
+        calc_bounds_90(update_start, &display_start[1]); // Offset from I2C_CMD byte at the start
 
         // Send column & page position
-        if (!oled_send_cmd(display_start, ARRAY_SIZE(display_start))) {
+        if (!oled_render_cmd(display_start, ARRAY_SIZE(display_start))) {
             print("oled_render offset command failed\n");
             return;
         }
 
-        if (!HAS_FLAGS(oled_rotation, OLED_ROTATION_90)) {
-            // Send render data chunk as is
-            if (!oled_send_data(&oled_buffer[OLED_BLOCK_SIZE * update_start], OLED_BLOCK_SIZE)) {
-                print("oled_render data failed\n");
-                return;
-            }
-        } else {
-            // Rotate the render chunks
-            const static uint8_t source_map[] = OLED_SOURCE_MAP;
-            const static uint8_t target_map[] = OLED_TARGET_MAP;
-
-            static uint8_t temp_buffer[OLED_BLOCK_SIZE];
-            memset(temp_buffer, 0, sizeof(temp_buffer));
-            for (uint8_t i = 0; i < sizeof(source_map); ++i) {
-                rotate_90(&oled_buffer[OLED_BLOCK_SIZE * update_start + source_map[i]], &temp_buffer[target_map[i]]);
-            }
-
 #if OLED_IC_HAS_HORIZONTAL_MODE
-            // Send render data chunk after rotating
-            if (!oled_send_data(&temp_buffer[0], OLED_BLOCK_SIZE)) {
-                print("oled_render90 data failed\n");
-                return;
-            }
+        // Send render data chunk after rotating
+        if (!oled_render_data(&temp_buffer[0], OLED_BLOCK_SIZE)) {
+            print("oled_render90 data failed\n");
+            return;
+        }
 #else
-            // For SH1106 or SH1107 the data chunk must be split into separate pieces for each page
-            const uint8_t columns_in_block = (OLED_BLOCK_SIZE + OLED_DISPLAY_HEIGHT - 1) / OLED_DISPLAY_HEIGHT * 8;
-            const uint8_t num_pages        = OLED_BLOCK_SIZE / columns_in_block;
-            for (uint8_t i = 0; i < num_pages; ++i) {
-                // Send column & page position for all pages except the first one
-                if (i > 0) {
-                    display_start[1]++;
-                    if (!oled_send_cmd(display_start, ARRAY_SIZE(display_start))) {
-                        print("oled_render offset command failed\n");
-                        return;
-                    }
-                }
-                // Send data for the page
-                if (!oled_send_data(&temp_buffer[columns_in_block * i], columns_in_block)) {
-                    print("oled_render90 data failed\n");
+        // For SH1106 or SH1107 the data chunk must be split into separate pieces for each page
+        const uint8_t columns_in_block = (OLED_BLOCK_SIZE + OLED_DISPLAY_HEIGHT - 1) / OLED_DISPLAY_HEIGHT * 8;
+        const uint8_t num_pages        = OLED_BLOCK_SIZE / columns_in_block;
+        for (uint8_t i = 0; i < num_pages; ++i) {
+            // Send column & page position for all pages except the first one
+            if (i > 0) {
+                display_start[1]++;
+                if (!oled_render_cmd(display_start, ARRAY_SIZE(display_start))) {
+                    print("oled_render offset command failed\n");
                     return;
                 }
             }
-#endif
+            // Send data for the page
+            if (!oled_render_data(&temp_buffer[columns_in_block * i], columns_in_block)) {
+                print("oled_render90 data failed\n");
+                return;
+            }
         }
+#endif
 
         // Clear dirty flag of just rendered block
         oled_dirty &= ~((OLED_BLOCK_TYPE)1 << update_start);
     }
 }
 
+void oled_render(void) {
+    // Do we have work to do?
+    oled_dirty &= OLED_ALL_BLOCKS_MASK;
+    if (!oled_dirty || !oled_initialized || oled_scrolling) {
+        return;
+    }
+
+#if OLED_BUS_UTILIZATION < 100
+    // Hold off until the previous render has been paid for
+    if (!timer_expired32(timer_read32(), oled_render_timeout)) {
+        return;
+    }
+    uint32_t render_start = timer_read32();
+#endif
+
+    // Turn on display if it is off
+    oled_on();
+
+    if (!oled_render_start()) {
+        print("oled_render bus start failed\n");
+        return;
+    }
+
+    if (!HAS_FLAGS(oled_rotation, OLED_ROTATION_90)) {
+        oled_render_blocks();
+    } else {
+        oled_render_blocks_90();
+    }
+
+    oled_render_stop();
+
+#if OLED_BUS_UTILIZATION < 100
+    // A render usually takes about a millisecond, so a single measurement is only ever 0, 1 or 2ms. These average out
+    // to the real render time, as long as the remainder of each back-off is carried over to the next one instead of
+    // being rounded away. Always back off at least one tick, so a render which reads as 0ms cannot repeat every loop.
+    uint32_t backoff              = timer_elapsed32(render_start) * (100 - OLED_BUS_UTILIZATION) + oled_render_backoff_remainder;
+    oled_render_backoff_remainder = backoff % OLED_BUS_UTILIZATION;
+    backoff /= OLED_BUS_UTILIZATION;
+    oled_render_timeout = timer_read32() + (backoff ? backoff : 1);
+#endif
+}
+
 void oled_set_cursor(uint8_t col, uint8_t line) {
     uint16_t index = line * oled_rotation_width + col * OLED_FONT_WIDTH;
 
@@ -708,6 +850,127 @@ void oled_write_pixel(uint8_t x, uint8_t y, bool on) {
     }
 }
 
+// Proportional font layout: a header, one entry per glyph, then the glyph data
+#define OLED_PFONT_HEIGHT 0
+#define OLED_PFONT_FIRST_CHAR 1
+#define OLED_PFONT_GLYPH_COUNT 2
+#define OLED_PFONT_FLAGS 3
+#define OLED_PFONT_SPACING 4
+#define OLED_PFONT_HEADER_SIZE 5
+#define OLED_PFONT_GLYPH_ENTRY_SIZE 3 // width, 16-bit little-endian data offset
+#define OLED_PFONT_FLAG_RLE 0x01
+
+typedef struct {
+    const uint8_t *data;
+    uint8_t        remaining;
+    bool           repeating;
+    bool           rle;
+} oled_font_reader_t;
+
+// Reads the next byte of glyph data, decoding QMK RLE if the font uses it
+static uint8_t oled_font_read(oled_font_reader_t *reader) {
+    if (reader->rle) {
+        if (reader->remaining == 0) {
+            uint8_t marker    = pgm_read_byte(reader->data++);
+            reader->repeating = marker < 128;
+            reader->remaining = reader->repeating ? marker : marker - 127;
+        }
+        reader->remaining--;
+        if (reader->repeating) {
+            // Stay on the repeated byte until the run is done
+            return pgm_read_byte(reader->remaining ? reader->data : reader->data++);
+        }
+    }
+    return pgm_read_byte(reader->data++);
+}
+
+// Combines the masked bits into the buffer, only flagging the block dirty if something changed
+static void oled_merge_byte(uint16_t index, uint8_t data, uint8_t mask) {
+    uint8_t value = (oled_buffer[index] & ~mask) | (data & mask);
+    if (oled_buffer[index] != value) {
+        oled_buffer[index] = value;
+        oled_dirty |= ((OLED_BLOCK_TYPE)1 << (index / OLED_BLOCK_SIZE));
+    }
+}
+
+// Writes one column of a glyph, pages holds the top-to-bottom bytes of the column
+static void oled_write_font_column(uint16_t x, uint8_t y, const uint8_t *pages, uint8_t height) {
+    if (x >= oled_rotation_width) {
+        return;
+    }
+    const uint8_t shift        = y % 8;
+    const uint8_t buffer_pages = OLED_MATRIX_SIZE / oled_rotation_width;
+    for (uint8_t i = 0, page = y / 8; i < (height + 7) / 8 && page < buffer_pages; ++i, ++page) {
+        uint8_t mask = (i == height / 8) ? (1 << (height % 8)) - 1 : 0xFF;
+        oled_merge_byte(page * oled_rotation_width + x, pages[i] << shift, mask << shift);
+        if (shift && page + 1 < buffer_pages) {
+            oled_merge_byte((page + 1) * oled_rotation_width + x, pages[i] >> (8 - shift), mask >> (8 - shift));
+        }
+    }
+}
+
+uint8_t oled_write_font_char(uint8_t x, uint8_t y, const uint8_t *font, const char data, bool invert) {
+    uint8_t cast_data   = (uint8_t)data;
+    uint8_t first_char  = pgm_read_byte(&font[OLED_PFONT_FIRST_CHAR]);
+    uint8_t glyph_count = pgm_read_byte(&font[OLED_PFONT_GLYPH_COUNT]);
+    if (cast_data < first_char || cast_data - first_char >= glyph_count) {
+        return 0;
+    }
+
+    const uint8_t *entry  = &font[OLED_PFONT_HEADER_SIZE + OLED_PFONT_GLYPH_ENTRY_SIZE * (cast_data - first_char)];
+    uint8_t        width  = pgm_read_byte(&entry[0]);
+    uint16_t       offset = pgm_read_byte(&entry[1]) | (uint16_t)pgm_read_byte(&entry[2]) << 8;
+    uint8_t        height = pgm_read_byte(&font[OLED_PFONT_HEIGHT]);
+    uint8_t        pages  = (height + 7) / 8;
+
+    oled_font_reader_t reader = {
+        .data = &font[OLED_PFONT_HEADER_SIZE + OLED_PFONT_GLYPH_ENTRY_SIZE * glyph_count + offset],
+        .rle  = pgm_read_byte(&font[OLED_PFONT_FLAGS]) & OLED_PFONT_FLAG_RLE,
+    };
+
+    // Glyph data is stored a column at a time, so each column is a single pass over the affected pages
+    uint8_t  column[32]; // enough for the tallest glyph, 255 pixels
+    uint16_t column_x = x;
+    for (uint8_t i = 0; i < width; ++i, ++column_x) {
+        for (uint8_t j = 0; j < pages; ++j) {
+            uint8_t bits = oled_font_read(&reader);
+            column[j]    = invert ? ~bits : bits;
+        }
+        oled_write_font_column(column_x, y, column, height);
+    }
+
+    // Clear the gap to the next glyph
+    uint8_t spacing = pgm_read_byte(&font[OLED_PFONT_SPACING]);
+    memset(column, invert ? 0xFF : 0x00, sizeof(column));
+    for (uint8_t i = 0; i < spacing; ++i, ++column_x) {
+        oled_write_font_column(column_x, y, column, height);
+    }
+
+    return width + spacing;
+}
+
+uint16_t oled_write_font_string(uint8_t x, uint8_t y, const uint8_t *font, const char *data, bool invert) {
+    uint16_t width = 0;
+    while (*data && x + width < oled_rotation_width) {
+        width += oled_write_font_char(x + width, y, font, *data++, invert);
+    }
+    return width;
+}
+
+uint16_t oled_font_string_width(const uint8_t *font, const char *data) {
+    uint8_t  first_char  = pgm_read_byte(&font[OLED_PFONT_FIRST_CHAR]);
+    uint8_t  glyph_count = pgm_read_byte(&font[OLED_PFONT_GLYPH_COUNT]);
+    uint8_t  spacing     = pgm_read_byte(&font[OLED_PFONT_SPACING]);
+    uint16_t width       = 0;
+    for (; *data; ++data) {
+        uint8_t cast_data = (uint8_t)*data;
+        if (cast_data >= first_char && cast_data - first_char < glyph_count) {
+            width += pgm_read_byte(&font[OLED_PFONT_HEADER_SIZE + OLED_PFONT_GLYPH_ENTRY_SIZE * (cast_data - first_char)]) + spacing;
+        }
+    }
+    return width;
+}
+
 #if defined(__AVR__)
 void oled_write_P(const char *data, bool invert) {
     uint8_t c = pgm_read_byte(data);
@@ -321,6 +321,12 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #    define OLED_UPDATE_PROCESS_LIMIT 1
 #endif
 
+// Percentage of time oled_render() may spend rendering, further renders are deferred
+// to keep the rest of the time free for matrix scanning. 100 disables the limit.
+#if !defined(OLED_BUS_UTILIZATION)
+#    define OLED_BUS_UTILIZATION 100
+#endif
+
 typedef struct __attribute__((__packed__)) {
     uint8_t *current_element;
     uint16_t remaining_element_count;
@@ -401,6 +407,18 @@ void oled_write_raw_byte(const char data, uint16_t index);
 // Coordinates start at top-left and go right and down for positive x and y
 void oled_write_pixel(uint8_t x, uint8_t y, bool on);
 
+// Writes a character from a proportional font (see `qmk painter-convert-font-oled`)
+// with its top-left corner at the specified pixel, overwriting the area behind it.
+// Returns the number of columns advanced, 0 if the font has no such character
+uint8_t oled_write_font_char(uint8_t x, uint8_t y, const uint8_t *font, const char data, bool invert);
+
+// Writes a string in a proportional font, starting at the specified pixel
+// Stops once it reaches the edge of the display, returns the width written
+uint16_t oled_write_font_string(uint8_t x, uint8_t y, const uint8_t *font, const char *data, bool invert);
+
+// Returns the width of a string in a proportional font, for aligning text
+uint16_t oled_font_string_width(const uint8_t *font, const char *data);
+
 #if defined(__AVR__)
 // Writes a PROGMEM string to the buffer at current cursor position
 // Advances the cursor while writing, inverts the pixels if true
@@ -6,6 +6,13 @@
 #    include "spi_master.h"
 #    include "qp_comms_spi.h"
 
+#    if QUANTUM_PAINTER_PIXDATA_DOUBLE_BUFFER
+#        ifndef PROTOCOL_CHIBIOS
+#            error "QUANTUM_PAINTER_PIXDATA_DOUBLE_BUFFER requires asynchronous SPI transmission, which is only available on ChibiOS"
+#        endif
+#        include "qp_draw.h"
+#    endif
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Base SPI support
 
@@ -35,9 +42,23 @@ uint32_t qp_comms_spi_send_data(painter_device_t device, const void *data, uint3
     const uint8_t *p               = (const uint8_t *)data;
     const uint32_t max_msg_length  = 1024;
 
+#    if QUANTUM_PAINTER_PIXDATA_DOUBLE_BUFFER
+    // Pixel data buffers aren't touched again until the next swap comes back around, so they can be sent in the
+    // background. Anything else may live on the caller's stack, so needs to go out synchronously.
+    const bool async = qp_internal_is_pixdata_buffer(data);
+#    endif
+
     while (bytes_remaining > 0) {
         uint32_t bytes_this_loop = QP_MIN(bytes_remaining, max_msg_length);
+#    if QUANTUM_PAINTER_PIXDATA_DOUBLE_BUFFER
+        if (async) {
+            spi_transmit_async(p, bytes_this_loop);
+        } else {
+            spi_transmit(p, bytes_this_loop);
+        }
+#    else
         spi_transmit(p, bytes_this_loop);
+#    endif
         p += bytes_this_loop;
         bytes_remaining -= bytes_this_loop;
     }
@@ -100,6 +121,10 @@ uint32_t qp_comms_spi_dc_reset_send_data(painter_device_t device, const void *da
 void qp_comms_spi_dc_reset_send_command(painter_device_t device, uint8_t cmd) {
     painter_driver_t *              driver       = (painter_driver_t *)device;
     qp_comms_spi_dc_reset_config_t *comms_config = (qp_comms_spi_dc_reset_config_t *)driver->comms_config;
+#        if QUANTUM_PAINTER_PIXDATA_DOUBLE_BUFFER
+    // Any pixel data still in flight needs to go out before D/C is flipped
+    spi_wait();
+#        endif
     writePinLow(comms_config->dc_pin);
     spi_write(cmd);
 }
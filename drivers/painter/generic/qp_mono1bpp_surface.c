@@ -0,0 +1,101 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include "color.h"
+#include "qp_mono1bpp_surface.h"
+#include "qp_surface_internal.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Common
+
+// Driver storage
+surface_painter_device_t mono1bpp_surface_drivers[MONO1BPP_SURFACE_NUM_DEVICES] = {0};
+
+// Palette used when copying out to other devices
+static const HSV mono1bpp_palette[2] = {
+    {.h = 0, .s = 0, .v = 0},   // black
+    {.h = 0, .s = 0, .v = 255}, // white
+};
+
+static inline uint8_t rgb_to_mono(RGB rgb) {
+    // Approximate luma, weighted 2:5:1
+    uint16_t luma = (2 * (uint16_t)rgb.r + 5 * (uint16_t)rgb.g + (uint16_t)rgb.b) / 8;
+    return luma >= 128 ? 1 : 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Pixel format
+
+static uint32_t mono1bpp_read_pixel(const uint8_t *buffer, uint32_t index) {
+    return (buffer[index / 8] >> (index % 8)) & 0x01;
+}
+
+static void mono1bpp_write_pixel(uint8_t *buffer, uint32_t index, uint32_t native) {
+    if (native) {
+        buffer[index / 8] |= (1 << (index % 8));
+    } else {
+        buffer[index / 8] &= ~(1 << (index % 8));
+    }
+}
+
+static RGB mono1bpp_to_rgb(const surface_painter_device_t *surface, uint32_t native) {
+    uint8_t v = native ? 255 : 0;
+    return (RGB){.r = v, .g = v, .b = v};
+}
+
+static uint32_t mono1bpp_from_rgb(const surface_painter_device_t *surface, RGB rgb) {
+    return rgb_to_mono(rgb);
+}
+
+static const surface_format_t surface_format_mono1bpp = {
+    .read_pixel  = mono1bpp_read_pixel,
+    .write_pixel = mono1bpp_write_pixel,
+    .to_rgb      = mono1bpp_to_rgb,
+    .from_rgb    = mono1bpp_from_rgb,
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Driver vtable
+
+// Pixel colour conversion
+static bool qp_mono1bpp_surface_palette_convert(painter_device_t device, int16_t palette_size, qp_pixel_t *palette) {
+    for (int16_t i = 0; i < palette_size; ++i) {
+        RGB rgb         = hsv_to_rgb_nocie((HSV){palette[i].hsv888.h, palette[i].hsv888.s, palette[i].hsv888.v});
+        palette[i].mono = rgb_to_mono(rgb);
+    }
+    return true;
+}
+
+// Append pixels to the target location, keyed by the pixel index
+static bool qp_mono1bpp_surface_append_pixels(painter_device_t device, uint8_t *target_buffer, qp_pixel_t *palette, uint32_t pixel_offset, uint32_t pixel_count, uint8_t *palette_indices) {
+    for (uint32_t i = 0; i < pixel_count; ++i) {
+        mono1bpp_write_pixel(target_buffer, pixel_offset + i, palette[palette_indices[i]].mono);
+    }
+    return true;
+}
+
+const painter_driver_vtable_t mono1bpp_surface_driver_vtable = {
+    .init            = qp_surface_init,
+    .power           = qp_surface_power,
+    .clear           = qp_surface_clear,
+    .flush           = qp_surface_flush,
+    .pixdata         = qp_surface_pixdata,
+    .viewport        = qp_surface_viewport,
+    .palette_convert = qp_mono1bpp_surface_palette_convert,
+    .append_pixels   = qp_mono1bpp_surface_append_pixels,
+    .append_pixdata  = qp_surface_append_pixdata,
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Factory function for creating a handle to a monochrome surface
+
+painter_device_t qp_mono1bpp_make_surface(uint16_t panel_width, uint16_t panel_height, void *buffer) {
+    for (uint32_t i = 0; i < MONO1BPP_SURFACE_NUM_DEVICES; ++i) {
+        surface_painter_device_t *driver = &mono1bpp_surface_drivers[i];
+        if (!driver->base.driver_vtable) {
+            driver->palette      = mono1bpp_palette;
+            driver->palette_size = ARRAY_SIZE(mono1bpp_palette);
+            return qp_surface_setup(driver, &mono1bpp_surface_driver_vtable, &surface_format_mono1bpp, 1, panel_width, panel_height, buffer);
+        }
+    }
+    return NULL;
+}
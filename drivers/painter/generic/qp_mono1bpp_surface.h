@@ -0,0 +1,33 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+#include "qp_internal.h"
+#include "qp_surface.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Quantum Painter monochrome surface configurables (add to your keyboard's config.h)
+
+#ifndef MONO1BPP_SURFACE_NUM_DEVICES
+/**
+ * @def This controls the maximum number of monochrome surface devices that Quantum Painter can use at any one time.
+ *      Increasing this number allows for multiple framebuffers to be used. Each requires its own RAM allocation.
+ */
+#    define MONO1BPP_SURFACE_NUM_DEVICES 1
+#endif
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Forward declarations
+
+#ifdef QUANTUM_PAINTER_MONO1BPP_SURFACE_ENABLE
+/**
+ * Factory method for a 1bpp monochrome surface (aka framebuffer). Pixels are packed 8 to a byte, least significant
+ * bit first. Colors are reduced to black or white based on their brightness.
+ *
+ * @param panel_width[in] the width of the display panel
+ * @param panel_height[in] the height of the display panel
+ * @param buffer[in] pointer to a preallocated buffer of size `((panel_width * panel_height + 7) / 8)`
+ * @return the device handle used with all drawing routines in Quantum Painter
+ */
+painter_device_t qp_mono1bpp_make_surface(uint16_t panel_width, uint16_t panel_height, void *buffer);
+#endif // QUANTUM_PAINTER_MONO1BPP_SURFACE_ENABLE
@@ -0,0 +1,142 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include "color.h"
+#include "qp_palette_surface.h"
+#include "qp_surface_internal.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Common
+
+// Driver storage
+surface_painter_device_t palette_surface_drivers[PALETTE_SURFACE_NUM_DEVICES] = {0};
+
+static inline RGB palette_entry_rgb(const surface_painter_device_t *surface, uint16_t index) {
+    return hsv_to_rgb_nocie(surface->palette[index]);
+}
+
+// Finds the palette entry closest to the supplied color
+static uint8_t palette_closest(const surface_painter_device_t *surface, RGB rgb) {
+    uint8_t  best_idx  = 0;
+    uint32_t best_dist = UINT32_MAX;
+    for (uint16_t i = 0; i < surface->palette_size; ++i) {
+        RGB      entry = palette_entry_rgb(surface, i);
+        int16_t  dr    = (int16_t)entry.r - rgb.r;
+        int16_t  dg    = (int16_t)entry.g - rgb.g;
+        int16_t  db    = (int16_t)entry.b - rgb.b;
+        uint32_t dist  = (uint32_t)(dr * dr) + (uint32_t)(dg * dg) + (uint32_t)(db * db);
+        if (dist < best_dist) {
+            best_idx  = (uint8_t)i;
+            best_dist = dist;
+            if (dist == 0) {
+                break;
+            }
+        }
+    }
+    return best_idx;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Pixel formats
+
+static uint32_t palette4_read_pixel(const uint8_t *buffer, uint32_t index) {
+    return (buffer[index / 2] >> ((index % 2) * 4)) & 0x0F;
+}
+
+static void palette4_write_pixel(uint8_t *buffer, uint32_t index, uint32_t native) {
+    uint8_t shift     = (index % 2) * 4;
+    buffer[index / 2] = (buffer[index / 2] & ~(0x0F << shift)) | ((native & 0x0F) << shift);
+}
+
+static uint32_t palette8_read_pixel(const uint8_t *buffer, uint32_t index) {
+    return buffer[index];
+}
+
+static void palette8_write_pixel(uint8_t *buffer, uint32_t index, uint32_t native) {
+    buffer[index] = (uint8_t)native;
+}
+
+static RGB palette_to_rgb(const surface_painter_device_t *surface, uint32_t native) {
+    return palette_entry_rgb(surface, native < surface->palette_size ? native : 0);
+}
+
+static uint32_t palette_from_rgb(const surface_painter_device_t *surface, RGB rgb) {
+    return palette_closest(surface, rgb);
+}
+
+static const surface_format_t surface_format_palette4 = {
+    .read_pixel  = palette4_read_pixel,
+    .write_pixel = palette4_write_pixel,
+    .to_rgb      = palette_to_rgb,
+    .from_rgb    = palette_from_rgb,
+};
+
+static const surface_format_t surface_format_palette8 = {
+    .read_pixel  = palette8_read_pixel,
+    .write_pixel = palette8_write_pixel,
+    .to_rgb      = palette_to_rgb,
+    .from_rgb    = palette_from_rgb,
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Driver vtable
+
+// Pixel colour conversion
+static bool qp_palette_surface_palette_convert(painter_device_t device, int16_t palette_size, qp_pixel_t *palette) {
+    surface_painter_device_t *surface = (surface_painter_device_t *)device;
+    for (int16_t i = 0; i < palette_size; ++i) {
+        // Exact matches are the common case, and need no conversion to RGB
+        uint16_t idx;
+        for (idx = 0; idx < surface->palette_size; ++idx) {
+            const HSV *entry = &surface->palette[idx];
+            if (entry->h == palette[i].hsv888.h && entry->s == palette[i].hsv888.s && entry->v == palette[i].hsv888.v) {
+                break;
+            }
+        }
+        if (idx == surface->palette_size) {
+            idx = palette_closest(surface, hsv_to_rgb_nocie((HSV){palette[i].hsv888.h, palette[i].hsv888.s, palette[i].hsv888.v}));
+        }
+        palette[i].palette_idx = (uint8_t)idx;
+    }
+    return true;
+}
+
+// Append pixels to the target location, keyed by the pixel index
+static bool qp_palette_surface_append_pixels(painter_device_t device, uint8_t *target_buffer, qp_pixel_t *palette, uint32_t pixel_offset, uint32_t pixel_count, uint8_t *palette_indices) {
+    surface_painter_device_t *surface = (surface_painter_device_t *)device;
+    for (uint32_t i = 0; i < pixel_count; ++i) {
+        surface->format->write_pixel(target_buffer, pixel_offset + i, palette[palette_indices[i]].palette_idx);
+    }
+    return true;
+}
+
+const painter_driver_vtable_t palette_surface_driver_vtable = {
+    .init            = qp_surface_init,
+    .power           = qp_surface_power,
+    .clear           = qp_surface_clear,
+    .flush           = qp_surface_flush,
+    .pixdata         = qp_surface_pixdata,
+    .viewport        = qp_surface_viewport,
+    .palette_convert = qp_palette_surface_palette_convert,
+    .append_pixels   = qp_palette_surface_append_pixels,
+    .append_pixdata  = qp_surface_append_pixdata,
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Factory function for creating a handle to an indexed-color surface
+
+painter_device_t qp_palette_make_surface(uint16_t panel_width, uint16_t panel_height, uint8_t bits_per_pixel, const HSV *palette, uint16_t palette_size, void *buffer) {
+    if ((bits_per_pixel != 4 && bits_per_pixel != 8) || palette == NULL || palette_size == 0 || palette_size > (1 << bits_per_pixel)) {
+        qp_dprintf("qp_palette_make_surface: fail (invalid bpp or palette)\n");
+        return NULL;
+    }
+
+    for (uint32_t i = 0; i < PALETTE_SURFACE_NUM_DEVICES; ++i) {
+        surface_painter_device_t *driver = &palette_surface_drivers[i];
+        if (!driver->base.driver_vtable) {
+            driver->palette      = palette;
+            driver->palette_size = palette_size;
+            return qp_surface_setup(driver, &palette_surface_driver_vtable, bits_per_pixel == 4 ? &surface_format_palette4 : &surface_format_palette8, bits_per_pixel, panel_width, panel_height, buffer);
+        }
+    }
+    return NULL;
+}
@@ -0,0 +1,41 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+#include "color.h"
+#include "qp_internal.h"
+#include "qp_surface.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Quantum Painter palette surface configurables (add to your keyboard's config.h)
+
+#ifndef PALETTE_SURFACE_NUM_DEVICES
+/**
+ * @def This controls the maximum number of indexed-color surface devices that Quantum Painter can use at any one time.
+ *      Increasing this number allows for multiple framebuffers to be used. Each requires its own RAM allocation.
+ */
+#    define PALETTE_SURFACE_NUM_DEVICES 1
+#endif
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Forward declarations
+
+#ifdef QUANTUM_PAINTER_PALETTE_SURFACE_ENABLE
+/**
+ * Factory method for an indexed-color surface (aka framebuffer), with either 4 or 8 bits per pixel. Pixels smaller
+ * than a byte are packed least significant bits first. Colors drawn to the surface are mapped to the closest entry in
+ * the palette.
+ *
+ * 8bpp surfaces with more than 16 palette entries require `QUANTUM_PAINTER_SUPPORTS_256_PALETTE` in order to be
+ * copied out to displays.
+ *
+ * @param panel_width[in] the width of the display panel
+ * @param panel_height[in] the height of the display panel
+ * @param bits_per_pixel[in] the number of bits used for each pixel, 4 or 8
+ * @param palette[in] the palette colors, which must stay valid for the lifetime of the surface
+ * @param palette_size[in] the number of entries in the palette, at most `1 << bits_per_pixel`
+ * @param buffer[in] pointer to a preallocated buffer of size `((panel_width * panel_height * bits_per_pixel + 7) / 8)`
+ * @return the device handle used with all drawing routines in Quantum Painter
+ */
+painter_device_t qp_palette_make_surface(uint16_t panel_width, uint16_t panel_height, uint8_t bits_per_pixel, const HSV *palette, uint16_t palette_size, void *buffer);
+#endif // QUANTUM_PAINTER_PALETTE_SURFACE_ENABLE
@@ -1,6 +1,9 @@
 // Copyright 2022 Nick Brassel (@tzarc)
 // SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
 #include "qp_internal.h"
+#include "qp_surface.h"
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Quantum Painter RGB565 surface configurables (add to your keyboard's config.h)
@@ -28,9 +31,9 @@
 painter_device_t qp_rgb565_make_surface(uint16_t panel_width, uint16_t panel_height, void *buffer);
 
 /**
- * Helper method to draw the dirty contents of the framebuffer to the target device.
+ * Helper method to draw the dirty contents of the framebuffer to the target device. Equivalent to `qp_surface_draw()`.
  *
- * After successful completion, the dirty area is reset.
+ * Only the dirty regions are transferred. After successful completion, the dirty regions are reset.
  *
  * @param surface[in] the surface to copy from
  * @param display[in] the display to copy into
@@ -0,0 +1,33 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+#include "qp_internal.h"
+#include "qp_surface.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Quantum Painter RGB888 surface configurables (add to your keyboard's config.h)
+
+#ifndef RGB888_SURFACE_NUM_DEVICES
+/**
+ * @def This controls the maximum number of RGB888 surface devices that Quantum Painter can use at any one time.
+ *      Increasing this number allows for multiple framebuffers to be used. Each requires its own RAM allocation.
+ */
+#    define RGB888_SURFACE_NUM_DEVICES 1
+#endif
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Forward declarations
+
+#ifdef QUANTUM_PAINTER_RGB888_SURFACE_ENABLE
+/**
+ * Factory method for an RGB888 surface (aka framebuffer). Copies to 24bpp displays such as the ILI9488 need no
+ * pixel conversion.
+ *
+ * @param panel_width[in] the width of the display panel
+ * @param panel_height[in] the height of the display panel
+ * @param buffer[in] pointer to a preallocated buffer of size `(3 * panel_width * panel_height)`
+ * @return the device handle used with all drawing routines in Quantum Painter
+ */
+painter_device_t qp_rgb888_make_surface(uint16_t panel_width, uint16_t panel_height, void *buffer);
+#endif // QUANTUM_PAINTER_RGB888_SURFACE_ENABLE
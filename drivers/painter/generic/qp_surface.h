@@ -0,0 +1,61 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+#include "qp_internal.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Quantum Painter surface configurables (add to your keyboard's config.h)
+
+#ifndef SURFACE_NUM_DIRTY_RECTS
+/**
+ * @def This controls the maximum number of separate dirty regions each surface keeps track of. Disjoint updates (such
+ *      as a clock in one corner and a WPM readout in another) are transferred independently, rather than as a single
+ *      rectangle spanning both. Once all are in use, new changes are merged into the closest existing region.
+ */
+#    define SURFACE_NUM_DIRTY_RECTS 4
+#endif
+
+#ifndef SURFACE_DIRTY_MERGE_DISTANCE
+/**
+ * @def Changes within this many pixels of an existing dirty region are merged into it instead of starting a new one.
+ */
+#    define SURFACE_DIRTY_MERGE_DISTANCE 8
+#endif
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Forward declarations
+
+#ifdef QUANTUM_PAINTER_SURFACE_ENABLE
+/**
+ * Helper method to draw the dirty contents of a surface to the target device.
+ *
+ * Only the dirty regions are transferred, converting to the target's pixel format where required. After successful
+ * completion, the dirty regions are reset.
+ *
+ * @param surface[in] the surface to copy from
+ * @param target[in] the display or surface to copy into
+ * @param x[in] the x-location of the original position of the surface
+ * @param y[in] the y-location of the original position of the surface
+ * @return whether the draw operation completed successfully
+ */
+bool qp_surface_draw(painter_device_t surface, painter_device_t target, uint16_t x, uint16_t y);
+
+/**
+ * Copies a rectangle of a surface to the target device, regardless of whether or not it is dirty.
+ *
+ * The rectangle is clipped against both the surface and the target. Pixels are converted to the target's pixel format
+ * where required; copies between surfaces of the same format are performed directly.
+ *
+ * @param surface[in] the surface to copy from
+ * @param target[in] the display or surface to copy into
+ * @param left[in] the left edge of the source rectangle, inclusive
+ * @param top[in] the top edge of the source rectangle, inclusive
+ * @param right[in] the right edge of the source rectangle, inclusive
+ * @param bottom[in] the bottom edge of the source rectangle, inclusive
+ * @param x[in] the x-location in the target to copy the top-left corner of the rectangle to
+ * @param y[in] the y-location in the target to copy the top-left corner of the rectangle to
+ * @return whether the copy completed successfully
+ */
+bool qp_surface_blit(painter_device_t surface, painter_device_t target, uint16_t left, uint16_t top, uint16_t right, uint16_t bottom, int16_t x, int16_t y);
+#endif // QUANTUM_PAINTER_SURFACE_ENABLE
@@ -0,0 +1,466 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include "qp_surface_internal.h"
+#include "qp_draw.h"
+#include "qp_comms.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Direct color formats
+
+// RGB565, stored byte-swapped to match the displays' native transfer order
+static uint32_t rgb565_read_pixel(const uint8_t *buffer, uint32_t index) {
+    return ((const uint16_t *)buffer)[index];
+}
+
+static void rgb565_write_pixel(uint8_t *buffer, uint32_t index, uint32_t native) {
+    ((uint16_t *)buffer)[index] = (uint16_t)native;
+}
+
+static RGB rgb565_to_rgb(const surface_painter_device_t *surface, uint32_t native) {
+    uint16_t rgb565 = __builtin_bswap16((uint16_t)native);
+    uint8_t  r      = (rgb565 >> 11) & 0x1F;
+    uint8_t  g      = (rgb565 >> 5) & 0x3F;
+    uint8_t  b      = rgb565 & 0x1F;
+    return (RGB){.r = (r << 3) | (r >> 2), .g = (g << 2) | (g >> 4), .b = (b << 3) | (b >> 2)};
+}
+
+static uint32_t rgb565_from_rgb(const surface_painter_device_t *surface, RGB rgb) {
+    uint16_t rgb565 = (((uint16_t)rgb.r) >> 3) << 11 | (((uint16_t)rgb.g) >> 2) << 5 | (((uint16_t)rgb.b) >> 3);
+    return __builtin_bswap16(rgb565);
+}
+
+const surface_format_t surface_format_rgb565 = {
+    .read_pixel  = rgb565_read_pixel,
+    .write_pixel = rgb565_write_pixel,
+    .to_rgb      = rgb565_to_rgb,
+    .from_rgb    = rgb565_from_rgb,
+};
+
+// RGB888, stored as R, G, B bytes
+static uint32_t rgb888_read_pixel(const uint8_t *buffer, uint32_t index) {
+    const uint8_t *p = &buffer[index * 3];
+    return ((uint32_t)p[0]) << 16 | ((uint32_t)p[1]) << 8 | p[2];
+}
+
+static void rgb888_write_pixel(uint8_t *buffer, uint32_t index, uint32_t native) {
+    uint8_t *p = &buffer[index * 3];
+    p[0]       = (uint8_t)(native >> 16);
+    p[1]       = (uint8_t)(native >> 8);
+    p[2]       = (uint8_t)native;
+}
+
+static RGB rgb888_to_rgb(const surface_painter_device_t *surface, uint32_t native) {
+    return (RGB){.r = (uint8_t)(native >> 16), .g = (uint8_t)(native >> 8), .b = (uint8_t)native};
+}
+
+static uint32_t rgb888_from_rgb(const surface_painter_device_t *surface, RGB rgb) {
+    return ((uint32_t)rgb.r) << 16 | ((uint32_t)rgb.g) << 8 | rgb.b;
+}
+
+const surface_format_t surface_format_rgb888 = {
+    .read_pixel  = rgb888_read_pixel,
+    .write_pixel = rgb888_write_pixel,
+    .to_rgb      = rgb888_to_rgb,
+    .from_rgb    = rgb888_from_rgb,
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Dirty region tracking
+
+static inline bool rect_contains(const surface_dirty_rect_t *rect, uint16_t x, uint16_t y) {
+    return x >= rect->l && x <= rect->r && y >= rect->t && y <= rect->b;
+}
+
+static inline bool rect_overlaps(const surface_dirty_rect_t *a, const surface_dirty_rect_t *b) {
+    return a->l <= b->r && b->l <= a->r && a->t <= b->b && b->t <= a->b;
+}
+
+static inline void rect_extend(surface_dirty_rect_t *rect, const surface_dirty_rect_t *other) {
+    rect->l = QP_MIN(rect->l, other->l);
+    rect->t = QP_MIN(rect->t, other->t);
+    rect->r = QP_MAX(rect->r, other->r);
+    rect->b = QP_MAX(rect->b, other->b);
+}
+
+// Distance from the pixel to the rect, along whichever axis is furthest away
+static inline uint16_t rect_distance(const surface_dirty_rect_t *rect, uint16_t x, uint16_t y) {
+    uint16_t dx = x < rect->l ? rect->l - x : (x > rect->r ? x - rect->r : 0);
+    uint16_t dy = y < rect->t ? rect->t - y : (y > rect->b ? y - rect->b : 0);
+    return QP_MAX(dx, dy);
+}
+
+static void mark_dirty(surface_painter_device_t *surface, uint16_t x, uint16_t y) {
+    // Fast path: consecutive writes nearly always land in the same region
+    if (surface->dirty_count > 0 && rect_contains(&surface->dirty[surface->dirty_last], x, y)) {
+        return;
+    }
+
+    // Find the closest existing region
+    uint8_t  best_idx  = 0;
+    uint16_t best_dist = UINT16_MAX;
+    for (uint8_t i = 0; i < surface->dirty_count; ++i) {
+        uint16_t dist = rect_distance(&surface->dirty[i], x, y);
+        if (dist < best_dist) {
+            best_idx  = i;
+            best_dist = dist;
+        }
+    }
+
+    surface_dirty_rect_t pixel = {.l = x, .t = y, .r = x, .b = y};
+
+    // Start a new region if the pixel is far away from the others and there's room
+    if (best_dist > SURFACE_DIRTY_MERGE_DISTANCE && surface->dirty_count < SURFACE_NUM_DIRTY_RECTS) {
+        surface->dirty_last                    = surface->dirty_count;
+        surface->dirty[surface->dirty_count++] = pixel;
+        return;
+    }
+
+    // Otherwise grow the closest region to fit...
+    rect_extend(&surface->dirty[best_idx], &pixel);
+
+    // ...and absorb any others it now overlaps, so that no pixel gets transferred twice
+    for (uint8_t i = 0; i < surface->dirty_count;) {
+        if (i != best_idx && rect_overlaps(&surface->dirty[best_idx], &surface->dirty[i])) {
+            rect_extend(&surface->dirty[best_idx], &surface->dirty[i]);
+            surface->dirty[i] = surface->dirty[--surface->dirty_count];
+            if (best_idx == surface->dirty_count) {
+                best_idx = i;
+            }
+            i = 0; // the grown region may now overlap ones already checked
+        } else {
+            ++i;
+        }
+    }
+    surface->dirty_last = best_idx;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Helpers
+
+static inline void increment_pixdata_location(surface_painter_device_t *surface) {
+    // Increment the X-position
+    surface->pixdata_x++;
+
+    // If the x-coord has gone past the right-side edge, loop it back around and increment the y-coord
+    if (surface->pixdata_x > surface->viewport_r) {
+        surface->pixdata_x = surface->viewport_l;
+        surface->pixdata_y++;
+    }
+
+    // If the y-coord has gone past the bottom, loop it back to the top
+    if (surface->pixdata_y > surface->viewport_b) {
+        surface->pixdata_y = surface->viewport_t;
+    }
+}
+
+static inline void setpixel(surface_painter_device_t *surface, uint16_t x, uint16_t y, uint32_t native) {
+    uint32_t index = (uint32_t)y * surface->base.panel_width + x;
+
+    // Skip messing with the dirty info if the original value already matches
+    if (surface->format->read_pixel(surface->buffer, index) != native) {
+        // Maintain dirty regions
+        mark_dirty(surface, x, y);
+
+        // Update the pixel data in the buffer
+        surface->format->write_pixel(surface->buffer, index, native);
+    }
+}
+
+static inline void stream_pixdata(surface_painter_device_t *surface, const uint8_t *data, uint32_t native_pixel_count) {
+    for (uint32_t pixel_counter = 0; pixel_counter < native_pixel_count; ++pixel_counter) {
+        setpixel(surface, surface->pixdata_x, surface->pixdata_y, surface->format->read_pixel(data, pixel_counter));
+        increment_pixdata_location(surface);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Driver vtable
+
+bool qp_surface_init(painter_device_t device, painter_rotation_t rotation) {
+    painter_driver_t *        driver  = (painter_driver_t *)device;
+    surface_painter_device_t *surface = (surface_painter_device_t *)driver;
+    memset(surface->buffer, 0, ((uint32_t)driver->panel_width * driver->panel_height * driver->native_bits_per_pixel + 7) / 8);
+
+    // Everything needs to be sent on the first draw
+    surface->dirty_count = 1;
+    surface->dirty_last  = 0;
+    surface->dirty[0]    = (surface_dirty_rect_t){.l = 0, .t = 0, .r = driver->panel_width - 1, .b = driver->panel_height - 1};
+    return true;
+}
+
+bool qp_surface_power(painter_device_t device, bool power_on) {
+    // No-op.
+    return true;
+}
+
+bool qp_surface_clear(painter_device_t device) {
+    painter_driver_t *driver = (painter_driver_t *)device;
+    driver->driver_vtable->init(device, driver->rotation); // Re-init the surface
+    return true;
+}
+
+bool qp_surface_flush(painter_device_t device) {
+    painter_driver_t *        driver  = (painter_driver_t *)device;
+    surface_painter_device_t *surface = (surface_painter_device_t *)driver;
+    surface->dirty_count              = 0;
+    surface->dirty_last               = 0;
+    return true;
+}
+
+bool qp_surface_viewport(painter_device_t device, uint16_t left, uint16_t top, uint16_t right, uint16_t bottom) {
+    painter_driver_t *        driver  = (painter_driver_t *)device;
+    surface_painter_device_t *surface = (surface_painter_device_t *)driver;
+
+    // Set the viewport locations
+    surface->viewport_l = left;
+    surface->viewport_t = top;
+    surface->viewport_r = right;
+    surface->viewport_b = bottom;
+
+    // Reset the write location to the top left
+    surface->pixdata_x = left;
+    surface->pixdata_y = top;
+    return true;
+}
+
+// Stream pixel data to the current write position in GRAM
+bool qp_surface_pixdata(painter_device_t device, const void *pixel_data, uint32_t native_pixel_count) {
+    painter_driver_t *        driver  = (painter_driver_t *)device;
+    surface_painter_device_t *surface = (surface_painter_device_t *)driver;
+    stream_pixdata(surface, (const uint8_t *)pixel_data, native_pixel_count);
+    return true;
+}
+
+// Append data to the target location
+bool qp_surface_append_pixdata(painter_device_t device, uint8_t *target_buffer, uint32_t pixdata_offset, uint8_t pixdata_byte) {
+    target_buffer[pixdata_offset] = pixdata_byte;
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Comms vtable
+
+static bool qp_surface_comms_init(painter_device_t device) {
+    // No-op.
+    return true;
+}
+static bool qp_surface_comms_start(painter_device_t device) {
+    // No-op.
+    return true;
+}
+static void qp_surface_comms_stop(painter_device_t device) {
+    // No-op.
+}
+static uint32_t qp_surface_comms_send(painter_device_t device, const void *data, uint32_t byte_count) {
+    // No-op.
+    return byte_count;
+}
+
+const painter_comms_vtable_t surface_driver_comms_vtable = {
+    // These are all effective no-op's because they're not actually needed.
+    .comms_init  = qp_surface_comms_init,
+    .comms_start = qp_surface_comms_start,
+    .comms_stop  = qp_surface_comms_stop,
+    .comms_send  = qp_surface_comms_send};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Setup
+
+painter_device_t qp_surface_setup(surface_painter_device_t *surface, const painter_driver_vtable_t *driver_vtable, const surface_format_t *format, uint8_t bits_per_pixel, uint16_t panel_width, uint16_t panel_height, void *buffer) {
+    surface->base.driver_vtable         = driver_vtable;
+    surface->base.comms_vtable          = &surface_driver_comms_vtable;
+    surface->base.native_bits_per_pixel = bits_per_pixel;
+    surface->base.panel_width           = panel_width;
+    surface->base.panel_height          = panel_height;
+    surface->base.rotation              = QP_ROTATION_0;
+    surface->base.offset_x              = 0;
+    surface->base.offset_y              = 0;
+    surface->format                     = format;
+    surface->buffer                     = (uint8_t *)buffer;
+    return (painter_device_t)surface;
+}
+
+bool qp_surface_is_surface(painter_device_t device) {
+    painter_driver_t *driver = (painter_driver_t *)device;
+    return driver->comms_vtable == &surface_driver_comms_vtable;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Copying out to other devices
+
+// Rectangle copy between surfaces -- no intermediate buffer required
+static bool surface_to_surface_blit(surface_painter_device_t *surface, surface_painter_device_t *target, uint16_t l, uint16_t t, uint16_t r, uint16_t b, uint16_t x, uint16_t y) {
+    bool same_format = target->format == surface->format && target->palette == surface->palette;
+    for (uint16_t py = t; py <= b; ++py) {
+        for (uint16_t px = l; px <= r; ++px) {
+            uint32_t native = surface->format->read_pixel(surface->buffer, (uint32_t)py * surface->base.panel_width + px);
+            if (!same_format) {
+                native = target->format->from_rgb(target, surface->format->to_rgb(surface, native));
+            }
+            setpixel(target, x + px - l, y + py - t, native);
+        }
+    }
+    return true;
+}
+
+// Rectangle copy to a display, with comms already started
+static bool surface_to_display_blit(surface_painter_device_t *surface, painter_device_t display, uint16_t l, uint16_t t, uint16_t r, uint16_t b, uint16_t x, uint16_t y) {
+    painter_driver_t *driver = (painter_driver_t *)display;
+
+    // Displays with 16bpp and 24bpp share the same pixel layout as the respective direct color surfaces
+    const surface_format_t *display_format = driver->native_bits_per_pixel == 16 ? &surface_format_rgb565 : (driver->native_bits_per_pixel == 24 ? &surface_format_rgb888 : NULL);
+
+    bool same_format = display_format == surface->format;
+    bool use_palette = !same_format && surface->palette != NULL;
+    if (!same_format && !use_palette && display_format == NULL) {
+        qp_dprintf("surface_to_display_blit: fail (no conversion to %dbpp)\n", (int)driver->native_bits_per_pixel);
+        return false;
+    }
+
+    if (use_palette) {
+        // Indexed formats only need their palette converted once, then each pixel is a lookup
+        if (surface->palette_size > ARRAY_SIZE(qp_internal_global_pixel_lookup_table)) {
+            qp_dprintf("surface_to_display_blit: fail (palette too large)\n");
+            return false;
+        }
+        for (uint16_t i = 0; i < surface->palette_size; ++i) {
+            qp_internal_global_pixel_lookup_table[i].hsv888.h = surface->palette[i].h;
+            qp_internal_global_pixel_lookup_table[i].hsv888.s = surface->palette[i].s;
+            qp_internal_global_pixel_lookup_table[i].hsv888.v = surface->palette[i].v;
+        }
+        qp_internal_invalidate_palette();
+        if (!driver->driver_vtable->palette_convert(display, surface->palette_size, qp_internal_global_pixel_lookup_table)) {
+            return false;
+        }
+    }
+
+    if (!driver->driver_vtable->viewport(display, x, y, x + r - l, y + b - t)) {
+        return false;
+    }
+
+    uint32_t total_pixel_count = qp_internal_num_pixels_in_buffer(display);
+    uint32_t pixel_counter     = 0;
+
+    // Fill the global pixdata area so that we can start transferring to the panel
+    for (uint16_t py = t; py <= b; ++py) {
+        for (uint16_t px = l; px <= r; ++px) {
+            uint32_t native = surface->format->read_pixel(surface->buffer, (uint32_t)py * surface->base.panel_width + px);
+            if (same_format) {
+                display_format->write_pixel(qp_internal_global_pixdata_buffer, pixel_counter, native);
+            } else if (use_palette) {
+                uint8_t index = (uint8_t)native;
+                driver->driver_vtable->append_pixels(display, qp_internal_global_pixdata_buffer, qp_internal_global_pixel_lookup_table, pixel_counter, 1, &index);
+            } else {
+                display_format->write_pixel(qp_internal_global_pixdata_buffer, pixel_counter, display_format->from_rgb(NULL, surface->format->to_rgb(surface, native)));
+            }
+
+            // If we've accumulated enough data, send it
+            if (++pixel_counter == total_pixel_count) {
+                if (!driver->driver_vtable->pixdata(display, qp_internal_global_pixdata_buffer, pixel_counter)) {
+                    return false;
+                }
+                qp_internal_swap_pixdata_buffer();
+                pixel_counter = 0;
+            }
+        }
+    }
+
+    // If there's any leftover data, send it
+    if (pixel_counter > 0) {
+        return driver->driver_vtable->pixdata(display, qp_internal_global_pixdata_buffer, pixel_counter);
+    }
+
+    return true;
+}
+
+static bool surface_blit_impl(surface_painter_device_t *surface, painter_device_t target, uint16_t l, uint16_t t, uint16_t r, uint16_t b, uint16_t x, uint16_t y) {
+    if (qp_surface_is_surface(target)) {
+        return surface_to_surface_blit(surface, (surface_painter_device_t *)target, l, t, r, b, x, y);
+    }
+    return surface_to_display_blit(surface, target, l, t, r, b, x, y);
+}
+
+static bool surface_validate(painter_device_t surface, painter_device_t target) {
+    painter_driver_t *surface_driver = (painter_driver_t *)surface;
+    painter_driver_t *target_driver  = (painter_driver_t *)target;
+    if (!qp_surface_is_surface(surface) || !surface_driver->validate_ok || !target_driver->validate_ok) {
+        qp_dprintf("qp_surface: fail (invalid surface or target)\n");
+        return false;
+    }
+    return true;
+}
+
+// Clips the rectangle, then copies what is left of it, with comms already started
+static bool surface_blit_clipped(surface_painter_device_t *surface_handle, painter_device_t target, uint16_t left, uint16_t top, uint16_t right, uint16_t bottom, int16_t x, int16_t y) {
+    // Clip against the surface
+    int32_t l = QP_MIN(left, right);
+    int32_t r = QP_MIN(QP_MAX(left, right), surface_handle->base.panel_width - 1);
+    int32_t t = QP_MIN(top, bottom);
+    int32_t b = QP_MIN(QP_MAX(top, bottom), surface_handle->base.panel_height - 1);
+
+    // Clip against the target
+    uint16_t target_width, target_height;
+    qp_get_geometry(target, &target_width, &target_height, NULL, NULL, NULL);
+    if (x < 0) {
+        l -= x;
+        x = 0;
+    }
+    if (y < 0) {
+        t -= y;
+        y = 0;
+    }
+    r = QP_MIN(r, l + (int32_t)target_width - 1 - x);
+    b = QP_MIN(b, t + (int32_t)target_height - 1 - y);
+
+    // Nothing left to draw
+    if (l > r || t > b) {
+        return true;
+    }
+
+    return surface_blit_impl(surface_handle, target, l, t, r, b, x, y);
+}
+
+bool qp_surface_blit(painter_device_t surface, painter_device_t target, uint16_t left, uint16_t top, uint16_t right, uint16_t bottom, int16_t x, int16_t y) {
+    if (!surface_validate(surface, target)) {
+        return false;
+    }
+
+    if (!qp_comms_start(target)) {
+        qp_dprintf("qp_surface_blit: fail (could not start comms)\n");
+        return false;
+    }
+    bool ok = surface_blit_clipped((surface_painter_device_t *)surface, target, left, top, right, bottom, x, y);
+    qp_comms_stop(target);
+    return ok;
+}
+
+bool qp_surface_draw(painter_device_t surface, painter_device_t target, uint16_t x, uint16_t y) {
+    if (!surface_validate(surface, target)) {
+        return false;
+    }
+
+    surface_painter_device_t *surface_handle = (surface_painter_device_t *)surface;
+
+    // If we're not dirty... we're done.
+    if (surface_handle->dirty_count == 0) {
+        return true;
+    }
+
+    // All regions are sent within a single comms session, each going through the same clipping as qp_surface_blit()
+    if (!qp_comms_start(target)) {
+        qp_dprintf("qp_surface_draw: fail (could not start comms)\n");
+        return false;
+    }
+    bool ok = true;
+    for (uint8_t i = 0; ok && i < surface_handle->dirty_count; ++i) {
+        const surface_dirty_rect_t *rect = &surface_handle->dirty[i];
+        ok                               = surface_blit_clipped(surface_handle, target, rect->l, rect->t, rect->r, rect->b, x + rect->l, y + rect->t);
+    }
+    qp_comms_stop(target);
+    if (!ok) {
+        return false;
+    }
+
+    // Clear the dirty info for the surface
+    return qp_flush(surface);
+}
@@ -0,0 +1,81 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+#include "color.h"
+#include "qp_internal.h"
+#include "qp_surface.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Common surface implementation
+
+typedef struct surface_painter_device_t surface_painter_device_t;
+
+// Handling of a surface's native pixel format. Pixels are addressed by index, both within the framebuffer (where the
+// index is `y * width + x`) and within the pixdata buffer.
+typedef struct surface_format_t {
+    uint32_t (*read_pixel)(const uint8_t *buffer, uint32_t index);
+    void (*write_pixel)(uint8_t *buffer, uint32_t index, uint32_t native);
+    RGB (*to_rgb)(const surface_painter_device_t *surface, uint32_t native);
+    uint32_t (*from_rgb)(const surface_painter_device_t *surface, RGB rgb);
+} surface_format_t;
+
+// Dirty region, inclusive bounds
+typedef struct surface_dirty_rect_t {
+    uint16_t l;
+    uint16_t t;
+    uint16_t r;
+    uint16_t b;
+} surface_dirty_rect_t;
+
+// Device definition
+struct surface_painter_device_t {
+    painter_driver_t base; // must be first, so it can be cast to/from the painter_device_t* type
+
+    // The pixel format of the target buffer
+    const surface_format_t *format;
+
+    // The target buffer
+    uint8_t *buffer;
+
+    // Palette for indexed formats, NULL for direct color formats
+    const HSV *palette;
+    uint16_t   palette_size;
+
+    // Manually manage the viewport for streaming pixel data to the display
+    uint16_t viewport_l;
+    uint16_t viewport_t;
+    uint16_t viewport_r;
+    uint16_t viewport_b;
+
+    // Current write location to the display when streaming pixel data
+    uint16_t pixdata_x;
+    uint16_t pixdata_y;
+
+    // Maintain a set of dirty regions so we can stream only what we need
+    uint8_t              dirty_count;
+    uint8_t              dirty_last; // the region most recently extended, checked first
+    surface_dirty_rect_t dirty[SURFACE_NUM_DIRTY_RECTS];
+};
+
+// Direct color formats, shared with the displays using the same native pixel layout
+extern const surface_format_t surface_format_rgb565;
+extern const surface_format_t surface_format_rgb888;
+
+// Common comms vtable, also used to identify surfaces
+extern const painter_comms_vtable_t surface_driver_comms_vtable;
+
+// Common driver vtable implementations
+bool qp_surface_init(painter_device_t device, painter_rotation_t rotation);
+bool qp_surface_power(painter_device_t device, bool power_on);
+bool qp_surface_clear(painter_device_t device);
+bool qp_surface_flush(painter_device_t device);
+bool qp_surface_viewport(painter_device_t device, uint16_t left, uint16_t top, uint16_t right, uint16_t bottom);
+bool qp_surface_pixdata(painter_device_t device, const void *pixel_data, uint32_t native_pixel_count);
+bool qp_surface_append_pixdata(painter_device_t device, uint8_t *target_buffer, uint32_t pixdata_offset, uint8_t pixdata_byte);
+
+// Fills in a surface device, returning the handle
+painter_device_t qp_surface_setup(surface_painter_device_t *surface, const painter_driver_vtable_t *driver_vtable, const surface_format_t *format, uint8_t bits_per_pixel, uint16_t panel_width, uint16_t panel_height, void *buffer);
+
+// Returns true if the supplied device is a surface
+bool qp_surface_is_surface(painter_device_t device);
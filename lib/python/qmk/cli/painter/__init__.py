@@ -1,2 +1,3 @@
 from . import convert_graphics
 from . import make_font
+from . import make_bundle
@@ -0,0 +1,93 @@
+"""This script packs converted Quantum Painter assets into a bundle suitable for external flash.
+"""
+import struct
+from qmk.path import normpath
+from milc import cli
+
+QPB_MAGIC = b'QPB'
+QPB_VERSION = 0x01
+QPB_ASSET_ENTRY_SIZE = 12
+QPB_HEADER_SIZE = (5 + 14) + 5  # bundle descriptor, followed by the asset table block header
+QPB_ASSET_ALIGNMENT = 4
+
+valid_asset_magic = [b'QGF', b'QFF']
+
+
+def fnv1a_32(data):
+    """Hashes the supplied bytes using 32-bit FNV-1a, matching `qpb_hash_name()` in firmware.
+    """
+    value = 0x811C9DC5
+    for b in data:
+        value ^= b
+        value = (value * 0x01000193) & 0xFFFFFFFF
+    return value
+
+
+def block_header(type_id, length):
+    """Renders a QGF-style block header.
+    """
+    return struct.pack('<BBL', type_id, (~type_id) & 0xFF, length)[:5]
+
+
+@cli.argument('-o', '--output', required=True, help='Specify output bundle file.')
+@cli.argument('inputs', nargs='+', arg_only=True, help='Raw QGF or QFF files to include, as generated with `--raw`. Use NAME=FILE to override the asset name, which otherwise defaults to the file name without extension.')
+@cli.subcommand('Packs converted images and fonts into a bundle for external flash')
+def painter_make_bundle(cli):
+    """Packs raw QGF images and QFF fonts into a single Quantum Painter bundle.
+
+    The bundle is intended to be written to external SPI flash, with individual assets located at runtime by name using `qp_flash_bundle_find()`.
+    """
+    assets = []
+    hashes = {}
+    for input_arg in cli.args.inputs:
+        # Work out the name of the asset
+        if '=' in input_arg:
+            name, input_file = input_arg.split('=', 1)
+            input_file = normpath(input_file)
+        else:
+            input_file = normpath(input_arg)
+            name = input_file.name.split('.')[0]
+
+        if not input_file.exists():
+            cli.log.error(f'Input file {input_file} does not exist!')
+            return False
+
+        data = input_file.read_bytes()
+        if len(data) < 8 or data[5:8] not in valid_asset_magic:
+            cli.log.error(f'Input file {input_file} is not a raw QGF or QFF file!')
+            return False
+
+        # Names are only stored as hashes, so make sure they're unique
+        name_hash = fnv1a_32(name.encode('utf-8'))
+        if name_hash in hashes:
+            cli.log.error(f'Asset name "{name}" clashes with "{hashes[name_hash]}", rename one of them using NAME=FILE.')
+            return False
+        hashes[name_hash] = name
+
+        assets.append((name, name_hash, data))
+
+    if len(assets) > 0xFFFF:
+        cli.log.error('Too many assets for a single bundle!')
+        return False
+
+    # Lay out the asset data after the asset table, aligned for efficient reads
+    table = b''
+    payload = b''
+    offset = QPB_HEADER_SIZE + len(assets) * QPB_ASSET_ENTRY_SIZE
+    for name, name_hash, data in assets:
+        padding = (-offset) % QPB_ASSET_ALIGNMENT
+        payload += b'\0' * padding
+        offset += padding
+        table += struct.pack('<LLL', name_hash, offset, len(data))
+        payload += data
+        offset += len(data)
+        cli.log.info(f'{name}: {len(data)} bytes')
+
+    total_size = offset
+    descriptor = block_header(0x00, 14) + QPB_MAGIC + struct.pack('<BLLH', QPB_VERSION, total_size, (~total_size) & 0xFFFFFFFF, len(assets))
+    out_bytes = descriptor + block_header(0x01, len(table)) + table + payload
+
+    output = normpath(cli.args.output)
+    with open(output, 'wb') as out:
+        print(f"Writing {output}...")
+        out.write(out_bytes)
@@ -4,6 +4,7 @@
 import re
 import datetime
 from io import BytesIO
+from string import Template
 from qmk.path import normpath
 from qmk.painter_qff import QFFFont
 from qmk.painter import render_header, render_source, render_license, render_bytes, valid_formats
@@ -93,3 +94,82 @@ def painter_convert_font_image(cli):
         print(f"Writing {source_file}...")
         source.write(source_text)
         source.close()
+
+
+oled_header_file_template = """\
+${license}
+#pragma once
+
+#include <stdint.h>
+
+extern const uint8_t oled_font_${sane_name}[${byte_count}];
+"""
+
+oled_source_file_template = """\
+${license}
+#include "progmem.h"
+
+// clang-format off
+const uint8_t oled_font_${sane_name}[${byte_count}] PROGMEM = {
+${bytes_lines}
+};
+// clang-format on
+"""
+
+
+@cli.argument('-i', '--input', help='Specify input graphic file.')
+@cli.argument('-o', '--output', default='', help='Specify output directory. Defaults to same directory as input.')
+@cli.argument('-n', '--no-ascii', arg_only=True, action='store_true', help='Disables output of the full ASCII character set (0x20..0x7E), exporting only the glyphs specified.')
+@cli.argument('-u', '--unicode-glyphs', default='', help='Also generate the specified glyphs, which must be 8-bit characters.')
+@cli.argument('-s', '--spacing', default=1, help='Specify the number of blank columns between glyphs. Default 1.')
+@cli.argument('-r', '--no-rle', arg_only=True, action='store_true', help='Disable the use of RLE to minimise converted font size.')
+@cli.subcommand('Converts an input font image to a proportional font for the OLED driver')
+def painter_convert_font_oled(cli):
+    # Create the font object
+    font = QFFFont(cli.log)
+
+    # Read from the input file
+    cli.args.input = normpath(cli.args.input)
+    font.read_from_image(cli.args.input, include_ascii_glyphs=(not cli.args.no_ascii), unicode_glyphs=cli.args.unicode_glyphs)
+
+    # Work out the output directory
+    if len(cli.args.output) == 0:
+        cli.args.output = cli.args.input.parent
+    cli.args.output = normpath(cli.args.output)
+
+    # Render out the data
+    out_data = BytesIO()
+    font.save_to_oled_font(int(cli.args.spacing), (False if cli.args.no_rle else True), out_data)
+    out_bytes = out_data.getvalue()
+    if len(out_bytes) == 0:
+        return False
+
+    # Work out the text substitutions for rendering the output data
+    subs = {
+        'generated_type': 'font',
+        'generator_command': f'qmk painter-convert-font-oled -i {cli.args.input.name}',
+        'year': datetime.date.today().strftime("%Y"),
+        'input_file': cli.args.input.name,
+        'sane_name': re.sub(r"[^a-zA-Z0-9]", "_", cli.args.input.stem),
+        'byte_count': len(out_bytes),
+        'bytes_lines': render_bytes(out_bytes),
+    }
+
+    # Render the license
+    subs.update({'license': render_license(subs)})
+
+    # Render and write the header file
+    header_text = Template(oled_header_file_template).substitute(subs)
+    header_file = cli.args.output / (cli.args.input.stem + ".oledfont.h")
+    with open(header_file, 'w') as header:
+        print(f"Writing {header_file}...")
+        header.write(header_text)
+        header.close()
+
+    # Render and write the source file
+    source_text = Template(oled_source_file_template).substitute(subs)
+    source_file = cli.args.output / (cli.args.input.stem + ".oledfont.c")
+    with open(source_file, 'w') as source:
+        print(f"Writing {source_file}...")
+        source.write(source_text)
+        source.close()
@@ -239,6 +239,8 @@ def convert_image_bytes(im, format):
         # Export the palette
         palette = []
         pal = im.getpalette()
+        # Newer versions of Pillow only return the palette entries in use, pad back out to the full size
+        pal = pal + [0] * (ncolors * 3 - len(pal))
         for n in range(0, ncolors * 3, 3):
             palette.append((pal[n + 0], pal[n + 1], pal[n + 2]))
 
@@ -328,3 +330,61 @@ def compress_bytes_qmk_rle(bytearray):
                 temp = []
                 repeat = False
     return output
+
+
+def compress_bytes_qmk_lz(bytearray):
+    """Compresses the supplied bytes using the QMK LZ scheme, a byte-oriented LZ77 variant with a 256-byte window.
+
+    See docs/quantum_painter_lz.md for the format.
+    """
+    window_size = 256
+    min_match = 3
+    max_match = 130
+    max_literals = 128
+
+    output = []
+    literals = []
+    positions = {}  # 3-byte prefix -> positions it was seen at, most recent last
+
+    def flush_literals():
+        if len(literals) > 0:
+            output.append(len(literals) - 1)
+            output.extend(literals)
+            literals.clear()
+
+    def remember(pos):
+        if pos + min_match <= len(bytearray):
+            positions.setdefault(tuple(bytearray[pos:pos + min_match]), []).append(pos)
+
+    n = 0
+    while n < len(bytearray):
+        # Find the longest match within the window, preferring the closest on ties
+        best_len = 0
+        best_dist = 0
+        for candidate in reversed(positions.get(tuple(bytearray[n:n + min_match]), [])):
+            dist = n - candidate
+            if dist > window_size:
+                break
+            length = 0
+            while length < max_match and n + length < len(bytearray) and bytearray[candidate + length] == bytearray[n + length]:
+                length += 1
+            if length > best_len:
+                best_len = length
+                best_dist = dist
+
+        if best_len >= min_match:
+            flush_literals()
+            output.append(0x80 | (best_len - min_match))
+            output.append(best_dist - 1)
+            for pos in range(n, n + best_len):
+                remember(pos)
+            n += best_len
+        else:
+            literals.append(bytearray[n])
+            if len(literals) == max_literals:
+                flush_literals()
+            remember(n)
+            n += 1
+
+    flush_literals()
+    return output
@@ -399,3 +399,62 @@ class QFFFont:
         font_descriptor.total_file_size = fp.tell()
         fp.seek(font_descriptor_location, 0)
         font_descriptor.write(fp)
+
+    def save_to_oled_font(self, spacing: int, use_rle: bool, fp):
+        # Drop out if there's no image loaded
+        if self.image is None:
+            self.logger.error('No image is loaded.')
+            return
+
+        # The OLED driver indexes glyphs by 8-bit character, as a contiguous range
+        code_points = sorted([ord(c) for c in self.glyph_data.keys()])
+        if code_points[-1] > 0xFF or (code_points[-1] - code_points[0] + 1) > 0xFF:
+            self.logger.error('OLED fonts only support up to 255 consecutive 8-bit characters.')
+            return
+        if self.glyph_height > 0xFF:
+            self.logger.error('OLED fonts only support glyphs up to 255 pixels tall.')
+            return
+
+        # Pixels are on if they're at least half brightness, packed into pages of 8 rows, least significant bit at the top
+        mono_img = self.image.convert('L').point(lambda p: 255 if p >= 128 else 0)
+        pages = (self.glyph_height + 7) // 8
+        glyphs = {}
+        for code_point, glyph_entry in self.glyph_data.items():
+            pixels = mono_img.crop((glyph_entry.x, 1, glyph_entry.x + glyph_entry.w, 1 + self.glyph_height)).load()
+            glyph_bytes = []
+            for x in range(glyph_entry.w):
+                for page in range(pages):
+                    value = 0
+                    for bit in range(8):
+                        y = page * 8 + bit
+                        if y < self.glyph_height and pixels[x, y]:
+                            value |= 1 << bit
+                    glyph_bytes.append(value)
+            glyphs[ord(code_point)] = glyph_bytes
+
+        # Glyphs are compressed individually so each can be decoded from its own offset; only use RLE if it's smaller overall
+        if use_rle:
+            compressed = {k: qmk.painter.compress_bytes_qmk_rle(v) for k, v in glyphs.items()}
+            use_rle = sum(map(len, compressed.values())) < sum(map(len, glyphs.values()))
+            if use_rle:
+                glyphs = compressed
+
+        # Missing characters within the range get a zero-width glyph
+        glyph_table = bytes()
+        glyph_buffer = bytes()
+        for code_point in range(code_points[0], code_points[-1] + 1):
+            width = self.glyph_data[chr(code_point)].w if code_point in glyphs else 0
+            if width > 0xFF or len(glyph_buffer) > 0xFFFF:
+                self.logger.error('Glyphs are too large for an OLED font.')
+                return
+            glyph_table += o8(width) + o16(len(glyph_buffer))
+            glyph_buffer += bytes(glyphs.get(code_point, []))
+
+        # Header, then the glyph table and data -- see drivers/oled/oled_driver.c
+        fp.write(o8(self.glyph_height))
+        fp.write(o8(code_points[0]))
+        fp.write(o8(code_points[-1] - code_points[0] + 1))
+        fp.write(o8(0x01 if use_rle else 0x00))
+        fp.write(o8(spacing))
+        fp.write(glyph_table)
+        fp.write(glyph_buffer)
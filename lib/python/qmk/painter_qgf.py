@@ -131,6 +131,17 @@ class QGFFrameDescriptorV1:
         else:
             self.flags &= ~0x02
 
+    @property
+    def is_tiled(self):
+        return (self.flags & 0x04) == 0x04
+
+    @is_tiled.setter
+    def is_tiled(self, val):
+        if val:
+            self.flags |= 0x04
+        else:
+            self.flags &= ~0x04
+
 
 ########################################################################################################################
 
@@ -184,6 +195,28 @@ class QGFFrameDeltaDescriptorV1:
 ########################################################################################################################
 
 
+class QGFFrameTilesDescriptorV1:
+    type_id = 0x06
+    length = 3
+
+    def __init__(self):
+        self.header = QGFBlockHeader()
+        self.header.type_id = QGFFrameTilesDescriptorV1.type_id
+        self.header.length = QGFFrameTilesDescriptorV1.length
+        self.tile_size = 8
+        self.run_count = 0
+
+    def write(self, fp):
+        self.header.write(fp)
+        fp.write(b''  # start off with empty bytes...
+                 + o8(self.tile_size)  # tile size
+                 + o16(self.run_count)  # run count
+                 )
+
+
+########################################################################################################################
+
+
 class QGFFrameDataDescriptorV1:
     type_id = 0x05
 
@@ -229,7 +262,10 @@ def _save(im, fp, filename):
     append_images = list(encoderinfo.get("append_images", []))
     verbose = encoderinfo.get("verbose", False)
     use_deltas = encoderinfo.get("use_deltas", True)
+    use_tiles = encoderinfo.get("use_tiles", True)
     use_rle = encoderinfo.get("use_rle", True)
+    use_lz = encoderinfo.get("use_lz", False)
+    tile_size = encoderinfo.get("tile_size", 8)
 
     # Helper for inline verbose prints
     def vprint(s):
@@ -276,6 +312,52 @@ def _save(im, fp, filename):
     vprint(f'{"Frame offsets block":26s} {fp.tell():5d}d / {fp.tell():04X}h')
     frame_offsets.write(fp)
 
+    # Helper to pick the smallest of the enabled compression schemes, returning the scheme and the resulting data
+    def _compress(data):
+        candidates = [(0x00, data)]  # See qp.h, painter_compression_t
+        if use_rle:
+            candidates.append((0x01, qmk.painter.compress_bytes_qmk_rle(data)))
+        if use_lz:
+            candidates.append((0x02, qmk.painter.compress_bytes_qmk_lz(data)))
+        return min(candidates, key=lambda c: len(c[1]))
+
+    # Helper to build the data for a tiled delta frame -- each horizontal run of changed tiles is encoded as a run header
+    # followed by the pixels covered by the run. Returns the run count and the uncompressed data.
+    def _tiled_frame_data(frame, last_frame, converted, format):
+        (width, height) = frame.size
+        tiles_x = (width + tile_size - 1) // tile_size
+        tiles_y = (height + tile_size - 1) // tile_size
+        if tiles_x > 256 or tiles_y > 256:
+            return None
+
+        diff = ImageChops.difference(frame, last_frame)
+
+        def _tile_changed(tx, ty):
+            return diff.crop((tx * tile_size, ty * tile_size, min((tx + 1) * tile_size, width), min((ty + 1) * tile_size, height))).getbbox() is not None
+
+        runs = []
+        for ty in range(tiles_y):
+            tx = 0
+            while tx < tiles_x:
+                if not _tile_changed(tx, ty):
+                    tx += 1
+                    continue
+                start = tx
+                while tx < tiles_x and tx - start < 255 and _tile_changed(tx, ty):
+                    tx += 1
+                runs.append((start, ty, tx - start))
+
+        if len(runs) > 0xFFFF:
+            return None
+
+        data = []
+        for (tx, ty, count) in runs:
+            run_area = converted.crop((tx * tile_size, ty * tile_size, min((tx + count) * tile_size, width), min((ty + 1) * tile_size, height)))
+            data.extend([tx, ty, count])
+            data.extend(qmk.painter.convert_image_bytes(run_area, format)[1])
+
+        return (len(runs), data)
+
     # Helper function to save each frame to the output file
     def _write_frame(idx, frame, last_frame):
         # If we replace the frame we're going to output with a delta, we can override it here
@@ -290,12 +372,10 @@ def _save(im, fp, filename):
         converted = qmk.painter.convert_requested_format(this_frame, format)
         graphic_data = qmk.painter.convert_image_bytes(converted, format)
 
-        # Convert the raw data to RLE-encoded if requested
-        raw_data = graphic_data[1]
-        if use_rle:
-            rle_data = qmk.painter.compress_bytes_qmk_rle(graphic_data[1])
-        use_raw_this_frame = not use_rle or len(raw_data) <= len(rle_data)
-        image_data = raw_data if use_raw_this_frame else rle_data
+        # Compress the raw data if requested
+        compression, image_data = _compress(graphic_data[1])
+        full_converted = converted
+        full_graphic_data = graphic_data
 
         # Work out if a delta frame is smaller than injecting it directly
         use_delta_this_frame = False
@@ -318,11 +398,7 @@ def _save(im, fp, filename):
                 delta_graphic_data = qmk.painter.convert_image_bytes(delta_converted, format)
 
                 # Work out how large the delta frame is going to be with compression etc.
-                delta_raw_data = delta_graphic_data[1]
-                if use_rle:
-                    delta_rle_data = qmk.painter.compress_bytes_qmk_rle(delta_graphic_data[1])
-                delta_use_raw_this_frame = not use_rle or len(delta_raw_data) <= len(delta_rle_data)
-                delta_image_data = delta_raw_data if delta_use_raw_this_frame else delta_rle_data
+                delta_compression, delta_image_data = _compress(delta_graphic_data[1])
 
                 # If the size of the delta frame (plus delta descriptor) is smaller than the original, use that instead
                 # This ensures that if a non-delta is overall smaller in size, we use that in preference due to flash
@@ -334,20 +410,35 @@ def _save(im, fp, filename):
                     size = delta_size
                     converted = delta_converted
                     graphic_data = delta_graphic_data
-                    raw_data = delta_raw_data
-                    rle_data = delta_rle_data
-                    use_raw_this_frame = delta_use_raw_this_frame
+                    compression = delta_compression
                     image_data = delta_image_data
                     use_delta_this_frame = True
 
+        # Work out if only sending the changed tiles is smaller still. The tiles are cut from the full converted frame,
+        # so they share its palette.
+        use_tiles_this_frame = False
+        if use_tiles and last_frame is not None:
+            tiled = _tiled_frame_data(frame, last_frame, full_converted, format)
+            if tiled is not None:
+                tiled_compression, tiled_image_data = _compress(tiled[1])
+                current_size = len(image_data) + (QGFFrameDeltaDescriptorV1.length if use_delta_this_frame else 0)
+                if (len(tiled_image_data) + QGFFrameTilesDescriptorV1.length) < current_size:
+                    graphic_data = full_graphic_data
+                    compression = tiled_compression
+                    image_data = tiled_image_data
+                    tile_run_count = tiled[0]
+                    use_delta_this_frame = False
+                    use_tiles_this_frame = True
+
         # Write out the frame descriptor
         frame_offsets.frame_offsets[idx] = fp.tell()
         vprint(f'{f"Frame {idx:3d} base":26s} {fp.tell():5d}d / {fp.tell():04X}h')
         frame_descriptor = QGFFrameDescriptorV1()
         frame_descriptor.is_delta = use_delta_this_frame
+        frame_descriptor.is_tiled = use_tiles_this_frame
         frame_descriptor.is_transparent = False
         frame_descriptor.format = format['image_format_byte']
-        frame_descriptor.compression = 0x00 if use_raw_this_frame else 0x01  # See qp.h, painter_compression_t
+        frame_descriptor.compression = compression
         frame_descriptor.delay = frame.info['duration'] if 'duration' in frame.info else 1000  # If we're not an animation, just pretend we're delaying for 1000ms
         frame_descriptor.write(fp)
 
@@ -379,6 +470,14 @@ def _save(im, fp, filename):
             vprint(f'{f"Frame {idx:3d} delta":26s} {fp.tell():5d}d / {fp.tell():04X}h')
             delta_descriptor.write(fp)
 
+        # Write out the tile info if required
+        if use_tiles_this_frame:
+            tiles_descriptor = QGFFrameTilesDescriptorV1()
+            tiles_descriptor.tile_size = tile_size
+            tiles_descriptor.run_count = tile_run_count
+            vprint(f'{f"Frame {idx:3d} tiles":26s} {fp.tell():5d}d / {fp.tell():04X}h')
+            tiles_descriptor.write(fp)
+
         # Write out the data for this frame to the output
         data_descriptor = QGFFrameDataDescriptorV1()
         data_descriptor.data = image_data
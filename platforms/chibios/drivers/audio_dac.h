@@ -121,6 +121,6 @@
 #endif
 
 /**
- *user overridable sample generation/processing
+ * user provided sample generation - if implemented, it is called for each sample instead of mixing the built-in waveform
  */
 uint16_t dac_value_generate(void);
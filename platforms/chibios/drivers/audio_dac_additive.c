@@ -28,9 +28,11 @@
 
   which utilizes the dac unit many STM32 are equipped with, to output a modulated waveform from samples stored in the dac_buffer_* array who are passed to the hardware through DMA
 
-  it is also possible to have a custom sample-LUT by implementing/overriding 'dac_value_generate'
+  it is also possible to generate custom samples by implementing 'dac_value_generate', which then replaces the mixing below;
+  defining AUDIO_DAC_SAMPLE_WAVEFORM_CUSTOM additionally leaves the built-in wavetables and voices out of the firmware
 
-  this driver allows for multiple simultaneous tones to be played through one single channel by doing additive wave-synthesis
+  this driver allows for multiple simultaneous tones to be played through one single channel by doing additive wave-synthesis:
+  each tone is assigned a voice with its own phase and gain, which are mixed in fixed point once per half buffer
 */
 
 #if !defined(AUDIO_PIN)
@@ -45,7 +47,7 @@
 #    define AUDIO_PIN_ALT PAL_NOLINE
 #endif
 
-#if !defined(AUDIO_DAC_SAMPLE_WAVEFORM_SINE) && !defined(AUDIO_DAC_SAMPLE_WAVEFORM_TRIANGLE) && !defined(AUDIO_DAC_SAMPLE_WAVEFORM_SQUARE) && !defined(AUDIO_DAC_SAMPLE_WAVEFORM_TRAPEZOID)
+#if !defined(AUDIO_DAC_SAMPLE_WAVEFORM_SINE) && !defined(AUDIO_DAC_SAMPLE_WAVEFORM_TRIANGLE) && !defined(AUDIO_DAC_SAMPLE_WAVEFORM_SQUARE) && !defined(AUDIO_DAC_SAMPLE_WAVEFORM_TRAPEZOID) && !defined(AUDIO_DAC_SAMPLE_WAVEFORM_CUSTOM)
 #    define AUDIO_DAC_SAMPLE_WAVEFORM_SINE
 #endif
 
@@ -66,7 +68,7 @@ static const dacsample_t dac_buffer_triangle[AUDIO_DAC_BUFFER_SIZE] = {
 #ifdef AUDIO_DAC_SAMPLE_WAVEFORM_SQUARE
 static const dacsample_t dac_buffer_square[AUDIO_DAC_BUFFER_SIZE] = {
     [0 ... AUDIO_DAC_BUFFER_SIZE / 2 - 1]                     = 0,                    // first and
-    [AUDIO_DAC_BUFFER_SIZE / 2 ... AUDIO_DAC_BUFFER_SIZE - 1] = AUDIO_DAC_SAMPLE_MAX, // second half
+    [AUDIO_DAC_BUFFER_SIZE / 2 ... AUDIO_DAC_BUFFER_SIZE - 1] = 0xfff,                // second half
 };
 #endif // AUDIO_DAC_SAMPLE_WAVEFORM_SQUARE
 /*
@@ -85,84 +87,224 @@ static const dacsample_t dac_buffer_trapezoid[AUDIO_DAC_BUFFER_SIZE] = {0x0,   0
 
 static dacsample_t dac_buffer_empty[AUDIO_DAC_BUFFER_SIZE] = {AUDIO_DAC_OFF_VALUE};
 
-/* keep track of the sample position for for each frequency */
-static float dac_if[AUDIO_MAX_SIMULTANEOUS_TONES] = {0.0};
+#ifndef AUDIO_DAC_SAMPLE_WAVEFORM_CUSTOM
+#    if defined(AUDIO_DAC_SAMPLE_WAVEFORM_SINE)
+#        define DAC_WAVETABLE dac_buffer_sine
+#    elif defined(AUDIO_DAC_SAMPLE_WAVEFORM_TRIANGLE)
+#        define DAC_WAVETABLE dac_buffer_triangle
+#    elif defined(AUDIO_DAC_SAMPLE_WAVEFORM_TRAPEZOID)
+#        define DAC_WAVETABLE dac_buffer_trapezoid
+#    elif defined(AUDIO_DAC_SAMPLE_WAVEFORM_SQUARE)
+#        define DAC_WAVETABLE dac_buffer_square
+#    endif
+
+#    if AUDIO_DAC_BUFFER_SIZE != 256
+#        error "AUDIO_DAC: the wavetable lookup expects AUDIO_DAC_BUFFER_SIZE to be 256"
+#    endif
+
+// full volume, shared between all voices
+#    define DAC_GAIN_MAX 0x10000
+
+// the wavetables span the full 12 bit range, and are scaled to AUDIO_DAC_SAMPLE_MAX by the mixing
+#    define DAC_WAVETABLE_MAX 0xfff
+#    define DAC_WAVETABLE_MID 0x800
+#    define DAC_MIX_SCALE (((uint32_t)AUDIO_DAC_SAMPLE_MAX << 16) / DAC_WAVETABLE_MAX)
+#    define DAC_MIX_CENTER ((AUDIO_DAC_SAMPLE_MAX + 1) / 2)
+
+/* each simultaneous tone is played by a voice: the phase is a 24.8 fixed point position in the wavetable, whose top
+ * 8 bits are the sample index; and the gain is relative to DAC_GAIN_MAX.
+ *
+ * when the tones change, the gain of each voice is ramped to its target over the next half buffer - which acts as the
+ * attack and release envelope, so tones can start, stop and change at any point without clicks.
+ */
+typedef struct {
+    uint32_t phase;
+    uint32_t increment;
+    uint32_t gain;
+    uint32_t target;
+} dac_voice_t;
+
+static dac_voice_t dac_voices[AUDIO_MAX_SIMULTANEOUS_TONES];
+
+/* the voices swing around the middle of the output range; while they sound the output is moved there from
+ * AUDIO_DAC_OFF_VALUE (and back afterwards) with the same ramp as the gains - a no-op for the default AUDIO_DAC_OFF_VALUE.
+ * 16.16 fixed point.
+ */
+static int32_t dac_mix_offset = (int32_t)AUDIO_DAC_OFF_VALUE << 16;
+#endif // AUDIO_DAC_SAMPLE_WAVEFORM_CUSTOM
+
+#ifndef AUDIO_DAC_SAMPLE_WAVEFORM_CUSTOM
+/* weak reference: resolves to NULL unless the keyboard/user implements its own sample generation */
+__attribute__((weak)) uint16_t dac_value_generate(void);
+#endif
 
-static float   active_tones_snapshot[AUDIO_MAX_SIMULTANEOUS_TONES] = {0, 0};
-static uint8_t active_tones_snapshot_length                        = 0;
+static bool tones_changed = false;
 
 typedef enum {
-    OUTPUT_SHOULD_START,
     OUTPUT_RUN_NORMALLY,
-    // path 1: wait for zero, then change/update active tones
-    OUTPUT_TONES_CHANGED,
-    OUTPUT_REACHED_ZERO_BEFORE_TONE_CHANGE,
-    // path 2: hardware should stop, wait for zero then turn output off = stop the timer
+    // hardware should stop: release all voices over one half buffer, then turn the output off = stop the timer
     OUTPUT_SHOULD_STOP,
-    OUTPUT_REACHED_ZERO_BEFORE_OFF,
     OUTPUT_OFF,
     OUTPUT_OFF_1,
     OUTPUT_OFF_2, // trailing off: giving the DAC two more conversion cycles until the AUDIO_DAC_OFF_VALUE reaches the output, then turn the timer off, which leaves the output at that level
     number_of_output_states
 } output_states_t;
-output_states_t state = OUTPUT_OFF_2;
+static output_states_t state = OUTPUT_OFF_2;
+
+#ifndef AUDIO_DAC_SAMPLE_WAVEFORM_CUSTOM
+static uint32_t dac_phase_increment(float frequency) {
+    /* Note: the 2/3 are necessary to get the correct frequencies on the
+     *       DAC output (as measured with an oscilloscope), since the gpt
+     *       timer runs with 3*AUDIO_DAC_SAMPLE_RATE; and the DAC callback
+     *       is called twice per conversion. */
+    return (uint32_t)(frequency * (4294967296.0f * 2 / 3 / AUDIO_DAC_SAMPLE_RATE));
+}
 
 /**
- * Generation of the waveform being passed to the callback. Declared weak so users
- * can override it with their own wave-forms/noises.
+ * Assigns the currently playing tones to the voices, and sets the gain each voice should ramp to.
  */
-__attribute__((weak)) uint16_t dac_value_generate(void) {
-    // DAC is running/asking for values but snapshot length is zero -> must be playing a pause
-    if (active_tones_snapshot_length == 0) {
-        return AUDIO_DAC_OFF_VALUE;
+static void dac_voices_update(void) {
+    uint32_t increments[AUDIO_MAX_SIMULTANEOUS_TONES];
+    uint8_t  count = 0;
+
+    if (OUTPUT_SHOULD_STOP != state) {
+        uint8_t active_tones = MIN(AUDIO_MAX_SIMULTANEOUS_TONES, audio_get_number_of_active_tones());
+        for (uint8_t i = 0; i < active_tones; i++) {
+            float freq = audio_get_processed_frequency(i);
+            if (freq > 0) { // disregard 'rest' notes, with valid frequency 0.0f; which would only lower the resulting waveform volume during the additive synthesis step
+                increments[count++] = dac_phase_increment(freq);
+            }
+        }
     }
 
-    /* doing additive wave synthesis over all currently playing tones = adding up
-     * sine-wave-samples for each frequency, scaled by the number of active tones
-     */
-    uint16_t value     = 0;
-    float    frequency = 0.0f;
-
-    for (uint8_t i = 0; i < active_tones_snapshot_length; i++) {
-        /* Note: a user implementation does not have to rely on the active_tones_snapshot, but
-         * could directly query the active frequencies through audio_get_processed_frequency */
-        frequency = active_tones_snapshot[i];
-
-        dac_if[i] = dac_if[i] + ((frequency * AUDIO_DAC_BUFFER_SIZE) / AUDIO_DAC_SAMPLE_RATE) * 2 / 3;
-        /*Note: the 2/3 are necessary to get the correct frequencies on the
-         *      DAC output (as measured with an oscilloscope), since the gpt
-         *      timer runs with 3*AUDIO_DAC_SAMPLE_RATE; and the DAC callback
-         *      is called twice per conversion.*/
-
-        dac_if[i] = fmod(dac_if[i], AUDIO_DAC_BUFFER_SIZE);
-
-        // Wavetable generation/lookup
-        uint16_t dac_i = (uint16_t)dac_if[i];
-
-#if defined(AUDIO_DAC_SAMPLE_WAVEFORM_SINE)
-        value += dac_buffer_sine[dac_i] / active_tones_snapshot_length;
-#elif defined(AUDIO_DAC_SAMPLE_WAVEFORM_TRIANGLE)
-        value += dac_buffer_triangle[dac_i] / active_tones_snapshot_length;
-#elif defined(AUDIO_DAC_SAMPLE_WAVEFORM_TRAPEZOID)
-        value += dac_buffer_trapezoid[dac_i] / active_tones_snapshot_length;
-#elif defined(AUDIO_DAC_SAMPLE_WAVEFORM_SQUARE)
-        value += dac_buffer_square[dac_i] / active_tones_snapshot_length;
-#endif
-        /*
-        // SINE
-        value += dac_buffer_sine[dac_i] / active_tones_snapshot_length / 3;
-        // TRIANGLE
-        value += dac_buffer_triangle[dac_i] / active_tones_snapshot_length / 3;
-        // SQUARE
-        value += dac_buffer_square[dac_i] / active_tones_snapshot_length / 3;
-        //NOTE: combination of these three wave-forms is more exemplary - and doesn't sound particularly good :-P
-        */
-
-        // STAIRS (mostly usefully as test-pattern)
-        // value_avg = dac_buffer_staircase[dac_i] / active_tones_snapshot_length;
+    uint32_t target = count ? DAC_GAIN_MAX / count : 0;
+    bool     assigned[AUDIO_MAX_SIMULTANEOUS_TONES] = {false};
+    uint8_t  pending                                = 0;
+
+    // tones which are still playing keep their voice
+    for (uint8_t t = 0; t < count; t++) {
+        uint8_t v = 0;
+        while (v < AUDIO_MAX_SIMULTANEOUS_TONES && (assigned[v] || dac_voices[v].target == 0 || dac_voices[v].increment != increments[t])) {
+            v++;
+        }
+        if (v < AUDIO_MAX_SIMULTANEOUS_TONES) {
+            assigned[v]          = true;
+            dac_voices[v].target = target;
+        } else {
+            increments[pending++] = increments[t];
+        }
+    }
+
+    // new tones take over the loudest remaining voice: if it is still sounding, the waveform carries on at the new
+    // frequency - e.g. the next note of a melody, or a vibrato
+    for (uint8_t t = 0; t < pending; t++) {
+        uint8_t loudest = 0;
+        while (assigned[loudest]) {
+            loudest++;
+        }
+        for (uint8_t v = loudest + 1; v < AUDIO_MAX_SIMULTANEOUS_TONES; v++) {
+            if (!assigned[v] && dac_voices[v].gain > dac_voices[loudest].gain) {
+                loudest = v;
+            }
+        }
+        assigned[loudest]             = true;
+        dac_voices[loudest].increment = increments[t];
+        dac_voices[loudest].target    = target;
+    }
+
+    // and the rest are released
+    for (uint8_t v = 0; v < AUDIO_MAX_SIMULTANEOUS_TONES; v++) {
+        if (!assigned[v]) {
+            dac_voices[v].target = 0;
+        }
+    }
+}
+
+/**
+ * Additive wave synthesis of all voices into a block of samples, scaled to AUDIO_DAC_SAMPLE_MAX.
+ */
+static void dac_voices_mix(dacsample_t *samples, uint16_t count) {
+    bool sounding = false;
+
+    for (uint16_t s = 0; s < count; s++) {
+        samples[s] = 0;
+    }
+
+    for (uint8_t v = 0; v < AUDIO_MAX_SIMULTANEOUS_TONES; v++) {
+        dac_voice_t *voice = &dac_voices[v];
+        if (voice->gain == 0 && voice->target == 0) {
+            continue;
+        }
+        sounding |= voice->target != 0;
+
+        // the samples are accumulated relative to the wavetable midpoint with wrap-around, the total is within range
+        // again once all voices are added
+        int32_t  gain  = voice->gain;
+        int32_t  step  = ((int32_t)voice->target - gain) / count;
+        uint32_t phase = voice->phase;
+        for (uint16_t s = 0; s < count; s++) {
+            gain += step;
+            phase += voice->increment;
+            samples[s] += ((int32_t)DAC_WAVETABLE[phase >> 24] - DAC_WAVETABLE_MID) * gain >> 16;
+        }
+        voice->phase = phase;
+        voice->gain  = voice->target;
+    }
+
+    int32_t target = (int32_t)(sounding ? DAC_MIX_CENTER : AUDIO_DAC_OFF_VALUE) << 16;
+    int32_t offset = dac_mix_offset;
+    int32_t step   = (target - offset) / count;
+    for (uint16_t s = 0; s < count; s++) {
+        offset += step;
+        int32_t value = (offset + (int16_t)samples[s] * (int32_t)DAC_MIX_SCALE) >> 16;
+
+        // rounding of the individual voices can overshoot by a little
+        if (value < 0) {
+            value = 0;
+        } else if (value > (int32_t)AUDIO_DAC_SAMPLE_MAX) {
+            value = AUDIO_DAC_SAMPLE_MAX;
+        }
+        samples[s] = value;
     }
+    dac_mix_offset = target;
+}
+#endif // AUDIO_DAC_SAMPLE_WAVEFORM_CUSTOM
 
-    return value;
+/**
+ * Fills a block of samples from dac_value_generate(). When stopping, the output is handed over to AUDIO_DAC_OFF_VALUE
+ * at the first zero crossing - or faded out towards it over the block, should the generated waveform not come by.
+ */
+static void dac_generate(dacsample_t *samples, uint16_t count) {
+    for (uint16_t s = 0; s < count; s++) {
+        int32_t value = dac_value_generate();
+
+        if (OUTPUT_SHOULD_STOP == state) {
+            /* zero crossing (or approach, whereas zero == DAC_OFF_VALUE, which can be configured to anything from 0 to DAC_SAMPLE_MAX)
+             * ============================*=*========================== AUDIO_DAC_SAMPLE_MAX
+             *                          *       *
+             *                        *           *
+             * ---------------------------------------------------------
+             *                     *                 *                  } AUDIO_DAC_SAMPLE_MAX/100
+             * --------------------------------------------------------- AUDIO_DAC_OFF_VALUE
+             *                  *                       *               } AUDIO_DAC_SAMPLE_MAX/100
+             * ---------------------------------------------------------
+             *               *
+             * *           *
+             *   *       *
+             * =====*=*================================================= 0x0
+             */
+            if (((value + (int32_t)(AUDIO_DAC_SAMPLE_MAX / 100)) > (int32_t)AUDIO_DAC_OFF_VALUE) && // value approaches from below
+                (value < (int32_t)(AUDIO_DAC_OFF_VALUE + (AUDIO_DAC_SAMPLE_MAX / 100)))              // or above
+            ) {
+                for (; s < count; s++) {
+                    samples[s] = AUDIO_DAC_OFF_VALUE;
+                }
+                return;
+            }
+            value = (int32_t)AUDIO_DAC_OFF_VALUE + (value - (int32_t)AUDIO_DAC_OFF_VALUE) * (count - 1 - s) / count;
+        }
+        samples[s] = value;
+    }
 }
 
 /**
@@ -178,71 +320,32 @@ static void dac_end(DACDriver *dacp) {
         sample_p += AUDIO_DAC_BUFFER_SIZE / 2; // 'half_index'
     }
 
-    for (uint8_t s = 0; s < AUDIO_DAC_BUFFER_SIZE / 2; s++) {
-        if (OUTPUT_OFF <= state) {
+    if (OUTPUT_OFF <= state) {
+        for (uint8_t s = 0; s < AUDIO_DAC_BUFFER_SIZE / 2; s++) {
             sample_p[s] = AUDIO_DAC_OFF_VALUE;
-            continue;
-        } else {
-            sample_p[s] = dac_value_generate();
         }
-
-        /* zero crossing (or approach, whereas zero == DAC_OFF_VALUE, which can be configured to anything from 0 to DAC_SAMPLE_MAX)
-         * ============================*=*========================== AUDIO_DAC_SAMPLE_MAX
-         *                          *       *
-         *                        *           *
-         * ---------------------------------------------------------
-         *                     *                 *                  } AUDIO_DAC_SAMPLE_MAX/100
-         * --------------------------------------------------------- AUDIO_DAC_OFF_VALUE
-         *                  *                       *               } AUDIO_DAC_SAMPLE_MAX/100
-         * ---------------------------------------------------------
-         *               *
-         * *           *
-         *   *       *
-         * =====*=*================================================= 0x0
-         */
-        if (((sample_p[s] + (AUDIO_DAC_SAMPLE_MAX / 100)) > AUDIO_DAC_OFF_VALUE) && // value approaches from below
-            (sample_p[s] < (AUDIO_DAC_OFF_VALUE + (AUDIO_DAC_SAMPLE_MAX / 100)))    // or above
-        ) {
-            if ((OUTPUT_SHOULD_START == state) && (active_tones_snapshot_length > 0)) {
-                state = OUTPUT_RUN_NORMALLY;
-            } else if (OUTPUT_TONES_CHANGED == state) {
-                state = OUTPUT_REACHED_ZERO_BEFORE_TONE_CHANGE;
-            } else if (OUTPUT_SHOULD_STOP == state) {
-                state = OUTPUT_REACHED_ZERO_BEFORE_OFF;
+    } else {
+#ifdef AUDIO_DAC_SAMPLE_WAVEFORM_CUSTOM
+        dac_generate(sample_p, AUDIO_DAC_BUFFER_SIZE / 2);
+#else
+        if (dac_value_generate) {
+            dac_generate(sample_p, AUDIO_DAC_BUFFER_SIZE / 2);
+        } else {
+            if (tones_changed || (OUTPUT_SHOULD_STOP == state)) {
+                tones_changed = false;
+                dac_voices_update();
             }
+            dac_voices_mix(sample_p, AUDIO_DAC_BUFFER_SIZE / 2);
         }
-
-        // still 'ramping up', reset the output to OFF_VALUE until the generated values reach that value, to do a smooth handover
-        if (OUTPUT_SHOULD_START == state) {
-            sample_p[s] = AUDIO_DAC_OFF_VALUE;
-        }
-
-        if ((OUTPUT_SHOULD_START == state) || (OUTPUT_REACHED_ZERO_BEFORE_OFF == state) || (OUTPUT_REACHED_ZERO_BEFORE_TONE_CHANGE == state)) {
-            uint8_t active_tones         = MIN(AUDIO_MAX_SIMULTANEOUS_TONES, audio_get_number_of_active_tones());
-            active_tones_snapshot_length = 0;
-            // update the snapshot - once, and only on occasion that something changed;
-            // -> saves cpu cycles (?)
-            for (uint8_t i = 0; i < active_tones; i++) {
-                float freq = audio_get_processed_frequency(i);
-                if (freq > 0) { // disregard 'rest' notes, with valid frequency 0.0f; which would only lower the resulting waveform volume during the additive synthesis step
-                    active_tones_snapshot[active_tones_snapshot_length++] = freq;
-                }
-            }
-
-            if ((0 == active_tones_snapshot_length) && (OUTPUT_REACHED_ZERO_BEFORE_OFF == state)) {
-                state = OUTPUT_OFF;
-            }
-            if (OUTPUT_REACHED_ZERO_BEFORE_TONE_CHANGE == state) {
-                state = OUTPUT_RUN_NORMALLY;
-            }
+#endif
+        if (OUTPUT_SHOULD_STOP == state) {
+            state = OUTPUT_OFF;
         }
     }
 
     // update audio internal state (note position, current_note, ...)
     if (audio_update_state()) {
-        if (OUTPUT_SHOULD_STOP != state) {
-            state = OUTPUT_TONES_CHANGED;
-        }
+        tones_changed = true;
     }
 
     if (OUTPUT_OFF <= state) {
@@ -330,14 +433,16 @@ void audio_driver_stop(void) {
 }
 
 void audio_driver_start(void) {
-    gptStartContinuous(&GPTD6, 2U);
-
+#ifndef AUDIO_DAC_SAMPLE_WAVEFORM_CUSTOM
     for (uint8_t i = 0; i < AUDIO_MAX_SIMULTANEOUS_TONES; i++) {
-        dac_if[i]                = 0.0f;
-        active_tones_snapshot[i] = 0.0f;
+        dac_voices[i] = (dac_voice_t){0};
     }
-    active_tones_snapshot_length = 0;
-    state                        = OUTPUT_SHOULD_START;
+#endif
+    tones_changed = true;
+    state         = OUTPUT_RUN_NORMALLY;
+
+    // start the timer last, so the DAC callback never sees voices left over from the previous start
+    gptStartContinuous(&GPTD6, 2U);
 }
 
 #pragma GCC diagnostic pop
@@ -19,6 +19,8 @@
 #include "timer.h"
 
 static pin_t currentSlavePin = NO_PIN;
+static bool  asyncPending    = false;
+static bool  stopPending     = false;
 
 #if defined(K20x) || defined(KL2x) || defined(RP2040)
 static SPIConfig spiConfig = {NULL, 0, 0, 0};
@@ -52,6 +54,14 @@ __attribute__((weak)) void spi_init(void) {
 }
 
 bool spi_start(pin_t slavePin, bool lsbFirst, uint8_t mode, uint16_t divisor) {
+    // Never reconfigure the peripheral underneath an asynchronous transfer
+    spi_wait();
+
+    // Finish releasing the bus from a previous spi_stop_async()
+    if (stopPending) {
+        spi_stop();
+    }
+
     if (currentSlavePin != NO_PIN || slavePin == NO_PIN) {
         return false;
     }
@@ -259,6 +269,8 @@ bool spi_start(pin_t slavePin, bool lsbFirst, uint8_t mode, uint16_t divisor) {
 }
 
 spi_status_t spi_write(uint8_t data) {
+    spi_wait();
+
     uint8_t rxData;
     spiExchange(&SPI_DRIVER, 1, &data, &rxData);
 
@@ -266,6 +278,8 @@ spi_status_t spi_write(uint8_t data) {
 }
 
 spi_status_t spi_read(void) {
+    spi_wait();
+
     uint8_t data = 0;
     spiReceive(&SPI_DRIVER, 1, &data);
 
@@ -273,19 +287,63 @@ spi_status_t spi_read(void) {
 }
 
 spi_status_t spi_transmit(const uint8_t *data, uint16_t length) {
+    spi_wait();
+
     spiSend(&SPI_DRIVER, length, data);
     return SPI_STATUS_SUCCESS;
 }
 
+spi_status_t spi_transmit_async(const uint8_t *data, uint16_t length) {
+    // Only one transfer can be in flight at a time
+    spi_wait();
+
+    asyncPending = true;
+    spiStartSend(&SPI_DRIVER, length, data);
+    return SPI_STATUS_SUCCESS;
+}
+
+void spi_wait(void) {
+    if (asyncPending) {
+        // With no end callback configured, the driver returns to SPI_READY as soon as the transfer completes
+#if SPI_USE_WAIT == TRUE
+        // Sleep until the end of transfer interrupt wakes us, the same way the synchronous HAL calls wait
+        osalSysLock();
+        if (SPI_DRIVER.state == SPI_ACTIVE) {
+            osalThreadSuspendS(&SPI_DRIVER.thread);
+        }
+        osalSysUnlock();
+#else
+        while (*(volatile spistate_t *)&SPI_DRIVER.state == SPI_ACTIVE) {
+        }
+#endif
+        asyncPending = false;
+    }
+}
+
 spi_status_t spi_receive(uint8_t *data, uint16_t length) {
+    spi_wait();
+
     spiReceive(&SPI_DRIVER, length, data);
     return SPI_STATUS_SUCCESS;
 }
 
 void spi_stop(void) {
+    spi_wait();
+    stopPending = false;
+
     if (currentSlavePin != NO_PIN) {
         spiUnselect(&SPI_DRIVER);
         spiStop(&SPI_DRIVER);
         currentSlavePin = NO_PIN;
     }
 }
+
+void spi_stop_async(void) {
+    if (!asyncPending) {
+        spi_stop();
+        return;
+    }
+
+    // Leave the transfer running, the bus is released by the next spi_start() or spi_stop()
+    stopPending = true;
+}
@@ -70,6 +70,10 @@
 #    endif
 #endif
 
+#ifndef WS2812_PWM_STREAM_LEDS
+#    define WS2812_PWM_STREAM_LEDS 4 // Number of LEDs encoded at a time, each half of the DMA buffer holds this many
+#endif
+
 #ifndef WS2812_PWM_TARGET_PERIOD
 //#    define WS2812_PWM_TARGET_PERIOD 800000 // Original code is 800k...?
 #    define WS2812_PWM_TARGET_PERIOD 80000 // TODO: work out why 10x less on f303/f4x1
@@ -131,141 +135,22 @@
 /* --- PRIVATE MACROS ------------------------------------------------------- */
 
 /**
- * @brief   Determine the index in @ref ws2812_frame_buffer "the frame buffer" of a given bit
- *
- * @param[in] led:                  The led index [0, @ref WS2812_LED_COUNT)
- * @param[in] byte:                 The byte number [0, 2]
- * @param[in] bit:                  The bit number [0, 7]
- *
- * @return                          The bit index
+ * @brief   Offsets of each color within an LED's packet, in transmission order
  */
-#define WS2812_BIT(led, byte, bit) (WS2812_COLOR_BITS * (led) + 8 * (byte) + (7 - (bit)))
-
 #if (WS2812_BYTE_ORDER == WS2812_BYTE_ORDER_GRB)
-/**
- * @brief   Determine the index in @ref ws2812_frame_buffer "the frame buffer" of a given red bit
- *
- * @note    The red byte is the middle byte in the color packet
- *
- * @param[in] led:                  The led index [0, @ref WS2812_LED_COUNT)
- * @param[in] bit:                  The bit number [0, 7]
- *
- * @return                          The bit index
- */
-#    define WS2812_RED_BIT(led, bit) WS2812_BIT((led), 1, (bit))
-
-/**
- * @brief   Determine the index in @ref ws2812_frame_buffer "the frame buffer" of a given green bit
- *
- * @note    The red byte is the first byte in the color packet
- *
- * @param[in] led:                  The led index [0, @ref WS2812_LED_COUNT)
- * @param[in] bit:                  The bit number [0, 7]
- *
- * @return                          The bit index
- */
-#    define WS2812_GREEN_BIT(led, bit) WS2812_BIT((led), 0, (bit))
-
-/**
- * @brief   Determine the index in @ref ws2812_frame_buffer "the frame buffer" of a given blue bit
- *
- * @note    The red byte is the last byte in the color packet
- *
- * @param[in] led:                  The led index [0, @ref WS2812_LED_COUNT)
- * @param[in] bit:                  The bit index [0, 7]
- *
- * @return                          The bit index
- */
-#    define WS2812_BLUE_BIT(led, bit) WS2812_BIT((led), 2, (bit))
-
+#    define WS2812_RED_BYTE 1
+#    define WS2812_GREEN_BYTE 0
+#    define WS2812_BLUE_BYTE 2
 #elif (WS2812_BYTE_ORDER == WS2812_BYTE_ORDER_RGB)
-/**
- * @brief   Determine the index in @ref ws2812_frame_buffer "the frame buffer" of a given red bit
- *
- * @note    The red byte is the middle byte in the color packet
- *
- * @param[in] led:                  The led index [0, @ref WS2812_LED_COUNT)
- * @param[in] bit:                  The bit number [0, 7]
- *
- * @return                          The bit index
- */
-#    define WS2812_RED_BIT(led, bit) WS2812_BIT((led), 0, (bit))
-
-/**
- * @brief   Determine the index in @ref ws2812_frame_buffer "the frame buffer" of a given green bit
- *
- * @note    The red byte is the first byte in the color packet
- *
- * @param[in] led:                  The led index [0, @ref WS2812_LED_COUNT)
- * @param[in] bit:                  The bit number [0, 7]
- *
- * @return                          The bit index
- */
-#    define WS2812_GREEN_BIT(led, bit) WS2812_BIT((led), 1, (bit))
-
-/**
- * @brief   Determine the index in @ref ws2812_frame_buffer "the frame buffer" of a given blue bit
- *
- * @note    The red byte is the last byte in the color packet
- *
- * @param[in] led:                  The led index [0, @ref WS2812_LED_COUNT)
- * @param[in] bit:                  The bit index [0, 7]
- *
- * @return                          The bit index
- */
-#    define WS2812_BLUE_BIT(led, bit) WS2812_BIT((led), 2, (bit))
-
+#    define WS2812_RED_BYTE 0
+#    define WS2812_GREEN_BYTE 1
+#    define WS2812_BLUE_BYTE 2
 #elif (WS2812_BYTE_ORDER == WS2812_BYTE_ORDER_BGR)
-/**
- * @brief   Determine the index in @ref ws2812_frame_buffer "the frame buffer" of a given red bit
- *
- * @note    The red byte is the middle byte in the color packet
- *
- * @param[in] led:                  The led index [0, @ref WS2812_LED_COUNT)
- * @param[in] bit:                  The bit number [0, 7]
- *
- * @return                          The bit index
- */
-#    define WS2812_RED_BIT(led, bit) WS2812_BIT((led), 2, (bit))
-
-/**
- * @brief   Determine the index in @ref ws2812_frame_buffer "the frame buffer" of a given green bit
- *
- * @note    The red byte is the first byte in the color packet
- *
- * @param[in] led:                  The led index [0, @ref WS2812_LED_COUNT)
- * @param[in] bit:                  The bit number [0, 7]
- *
- * @return                          The bit index
- */
-#    define WS2812_GREEN_BIT(led, bit) WS2812_BIT((led), 1, (bit))
-
-/**
- * @brief   Determine the index in @ref ws2812_frame_buffer "the frame buffer" of a given blue bit
- *
- * @note    The red byte is the last byte in the color packet
- *
- * @param[in] led:                  The led index [0, @ref WS2812_LED_COUNT)
- * @param[in] bit:                  The bit index [0, 7]
- *
- * @return                          The bit index
- */
-#    define WS2812_BLUE_BIT(led, bit) WS2812_BIT((led), 0, (bit))
-#endif
-
-#ifdef RGBW
-/**
- * @brief   Determine the index in @ref ws2812_frame_buffer "the frame buffer" of a given white bit
- *
- * @note    The white byte is the last byte in the color packet
- *
- * @param[in] led:                  The led index [0, @ref WS2812_LED_N)
- * @param[in] bit:                  The bit index [0, 7]
- *
- * @return                          The bit index
- */
-#    define WS2812_WHITE_BIT(led, bit) WS2812_BIT((led), 3, (bit))
+#    define WS2812_RED_BYTE 2
+#    define WS2812_GREEN_BYTE 1
+#    define WS2812_BLUE_BYTE 0
 #endif
+#define WS2812_WHITE_BYTE 3
 
 /* --- PRIVATE VARIABLES ---------------------------------------------------- */
 
@@ -291,22 +176,103 @@ typedef uint16_t ws2812_buffer_t;
 typedef uint8_t ws2812_buffer_t;
 #endif
 
-static ws2812_buffer_t ws2812_frame_buffer[WS2812_BIT_N + 1]; /**< Buffer for a frame */
+#if defined(WB32F3G71xx) || defined(WB32FQ95xx)
+// The whole frame is encoded up front, and the DMA transmits it repeatedly in circular mode
+#    define WS2812_DMA_BUFFER_N (WS2812_BIT_N + 1)
+#else
+// The frame is encoded on the fly into a small circular buffer: whenever the DMA finishes transmitting one half of the
+// buffer, the half-transfer/transfer-complete interrupt encodes the next LEDs into it while the other half is sent.
+// Neither the RAM nor the CPU time spent with interrupts disabled depends on the number of LEDs.
+#    define WS2812_PWM_STREAMING
+#    define WS2812_DMA_HALF_N (WS2812_PWM_STREAM_LEDS * WS2812_COLOR_BITS)
+#    define WS2812_DMA_BUFFER_N (2 * WS2812_DMA_HALF_N)
+#    define WS2812_DMA_MODE (STM32_DMA_CR_CHSEL(WS2812_DMA_CHANNEL) | STM32_DMA_CR_DIR_M2P | WS2812_DMA_PERIPHERAL_WIDTH | WS2812_DMA_MEMORY_WIDTH | STM32_DMA_CR_MINC | STM32_DMA_CR_CIRC | STM32_DMA_CR_HTIE | STM32_DMA_CR_TCIE | STM32_DMA_CR_PL(3))
+#endif
 
-/* --- PUBLIC FUNCTIONS ----------------------------------------------------- */
-/*
- * Gedanke: Double-buffer type transactions: double buffer transfers using two memory pointers for
- * the memory (while the DMA is reading/writing from/to a buffer, the application can
- * write/read to/from the other buffer).
+static ws2812_buffer_t ws2812_dma_buffer[WS2812_DMA_BUFFER_N]; /**< Buffer read by the DMA */
+
+/**
+ * @brief   Encodes a byte into a duty cycle per bit, most significant bit first
  */
+static inline void ws2812_encode_byte(ws2812_buffer_t* out, uint8_t value) {
+    for (uint8_t mask = 0x80; mask; mask >>= 1) {
+        *out++ = (value & mask) ? WS2812_DUTYCYCLE_1 : WS2812_DUTYCYCLE_0;
+    }
+}
+
+#ifdef WS2812_PWM_STREAMING
+static uint8_t            ws2812_colors[WS2812_LED_COUNT * WS2812_CHANNELS]; /**< Colors for the frame, in transmission order */
+static uint16_t           ws2812_stream_pos;                                 /**< Next byte of @ref ws2812_colors to encode */
+static uint16_t           ws2812_stream_len;                                 /**< Number of bytes in the frame */
+static uint16_t           ws2812_half_zeros[2];                              /**< Trailing reset bits queued in each half of the buffer */
+static uint16_t           ws2812_sent_zeros;                                 /**< Reset bits transmitted so far */
+static volatile bool      ws2812_busy;
+static thread_reference_t ws2812_waiting_thread;
+
+/**
+ * @brief   Encodes the next LEDs of the frame into one half of the DMA buffer, padding with reset bits once done
+ */
+static void ws2812_fill_half(uint8_t half) {
+    ws2812_buffer_t* out = &ws2812_dma_buffer[half * WS2812_DMA_HALF_N];
+    uint16_t         n   = 0;
+    while (n < WS2812_DMA_HALF_N && ws2812_stream_pos < ws2812_stream_len) {
+        ws2812_encode_byte(&out[n], ws2812_colors[ws2812_stream_pos++]);
+        n += 8;
+    }
+    ws2812_half_zeros[half] = WS2812_DMA_HALF_N - n;
+    while (n < WS2812_DMA_HALF_N) {
+        out[n++] = 0;
+    }
+}
+
+static void ws2812_dma_half_complete(uint8_t half) {
+    ws2812_sent_zeros += ws2812_half_zeros[half];
+    if (ws2812_sent_zeros < WS2812_RESET_BIT_N) {
+        ws2812_fill_half(half);
+        return;
+    }
+
+    // The reset period has elapsed, the last duty cycle written was zero so the output stays low
+    dmaStreamDisable(WS2812_DMA_STREAM);
+    osalSysLockFromISR();
+    ws2812_busy = false;
+    osalThreadResumeI(&ws2812_waiting_thread, MSG_OK);
+    osalSysUnlockFromISR();
+}
+
+static void ws2812_dma_isr(void* param, uint32_t flags) {
+    if (!ws2812_busy) {
+        return;
+    }
+    if (flags & STM32_DMA_ISR_HTIF) {
+        ws2812_dma_half_complete(0);
+    }
+    if ((flags & STM32_DMA_ISR_TCIF) && ws2812_busy) {
+        ws2812_dma_half_complete(1);
+    }
+}
+#endif // WS2812_PWM_STREAMING
+
+static inline void ws2812_set_color(uint16_t led_number, uint8_t byte, uint8_t value) {
+#ifdef WS2812_PWM_STREAMING
+    ws2812_colors[led_number * WS2812_CHANNELS + byte] = value;
+#else
+    ws2812_encode_byte(&ws2812_dma_buffer[led_number * WS2812_COLOR_BITS + byte * 8], value);
+#endif
+}
+
+/* --- PUBLIC FUNCTIONS ----------------------------------------------------- */
 
 void ws2812_init(void) {
-    // Initialize led frame buffer
-    uint32_t i;
-    for (i = 0; i < WS2812_COLOR_BIT_N; i++)
-        ws2812_frame_buffer[i] = WS2812_DUTYCYCLE_0; // All color bits are zero duty cycle
-    for (i = 0; i < WS2812_RESET_BIT_N; i++)
-        ws2812_frame_buffer[i + WS2812_COLOR_BIT_N] = 0; // All reset bits are zero
+    // Initialize led frame buffer, all bits are zero duty cycle (including the reset bits)
+    for (uint32_t i = 0; i < WS2812_DMA_BUFFER_N; i++) {
+        ws2812_dma_buffer[i] = 0;
+    }
+#ifndef WS2812_PWM_STREAMING
+    for (uint32_t i = 0; i < WS2812_COLOR_BIT_N; i++) {
+        ws2812_dma_buffer[i] = WS2812_DUTYCYCLE_0; // All color bits are zero
+    }
+#endif
 
     palSetLineMode(WS2812_DI_PIN, WS2812_OUTPUT_MODE);
 
@@ -330,16 +296,16 @@ void ws2812_init(void) {
     // dmaInit(); // Joe added this
 #if defined(WB32F3G71xx) || defined(WB32FQ95xx)
     dmaStreamAlloc(WS2812_DMA_STREAM - WB32_DMA_STREAM(0), 10, NULL, NULL);
-    dmaStreamSetSource(WS2812_DMA_STREAM, ws2812_frame_buffer);
+    dmaStreamSetSource(WS2812_DMA_STREAM, ws2812_dma_buffer);
     dmaStreamSetDestination(WS2812_DMA_STREAM, &(WS2812_PWM_DRIVER.tim->CCR[WS2812_PWM_CHANNEL - 1])); // Ziel ist der An-Zeit im Cap-Comp-Register
     dmaStreamSetMode(WS2812_DMA_STREAM, WB32_DMA_CHCFG_HWHIF(WS2812_DMA_CHANNEL) | WB32_DMA_CHCFG_DIR_M2P | WB32_DMA_CHCFG_PSIZE_WORD | WB32_DMA_CHCFG_MSIZE_WORD | WB32_DMA_CHCFG_MINC | WB32_DMA_CHCFG_CIRC | WB32_DMA_CHCFG_TCIE | WB32_DMA_CHCFG_PL(3));
 #else
-    dmaStreamAlloc(WS2812_DMA_STREAM - STM32_DMA_STREAM(0), 10, NULL, NULL);
+    dmaStreamAlloc(WS2812_DMA_STREAM - STM32_DMA_STREAM(0), 10, ws2812_dma_isr, NULL);
     dmaStreamSetPeripheral(WS2812_DMA_STREAM, &(WS2812_PWM_DRIVER.tim->CCR[WS2812_PWM_CHANNEL - 1])); // Ziel ist der An-Zeit im Cap-Comp-Register
-    dmaStreamSetMemory0(WS2812_DMA_STREAM, ws2812_frame_buffer);
-    dmaStreamSetMode(WS2812_DMA_STREAM, STM32_DMA_CR_CHSEL(WS2812_DMA_CHANNEL) | STM32_DMA_CR_DIR_M2P | WS2812_DMA_PERIPHERAL_WIDTH | WS2812_DMA_MEMORY_WIDTH | STM32_DMA_CR_MINC | STM32_DMA_CR_CIRC | STM32_DMA_CR_PL(3));
+    dmaStreamSetMemory0(WS2812_DMA_STREAM, ws2812_dma_buffer);
+    dmaStreamSetMode(WS2812_DMA_STREAM, WS2812_DMA_MODE);
 #endif
-    dmaStreamSetTransactionSize(WS2812_DMA_STREAM, WS2812_BIT_N);
+    dmaStreamSetTransactionSize(WS2812_DMA_STREAM, WS2812_DMA_BUFFER_N);
     // M2P: Memory 2 Periph; PL: Priority Level
 
 #if (STM32_DMA_SUPPORTS_DMAMUX == TRUE)
@@ -347,8 +313,10 @@ void ws2812_init(void) {
     dmaSetRequestSource(WS2812_DMA_STREAM, WS2812_DMAMUX_ID);
 #endif
 
-    // Start DMA
+#ifndef WS2812_PWM_STREAMING
+    // Start DMA, the frame buffer is transmitted continuously from here on
     dmaStreamEnable(WS2812_DMA_STREAM);
+#endif
 
     // Configure PWM
     // NOTE: It's required that preload be enabled on the timer channel CCR register. This is currently enabled in the
@@ -359,23 +327,15 @@ void ws2812_init(void) {
 }
 
 void ws2812_write_led(uint16_t led_number, uint8_t r, uint8_t g, uint8_t b) {
-    // Write color to frame buffer
-    for (uint8_t bit = 0; bit < 8; bit++) {
-        ws2812_frame_buffer[WS2812_RED_BIT(led_number, bit)]   = ((r >> bit) & 0x01) ? WS2812_DUTYCYCLE_1 : WS2812_DUTYCYCLE_0;
-        ws2812_frame_buffer[WS2812_GREEN_BIT(led_number, bit)] = ((g >> bit) & 0x01) ? WS2812_DUTYCYCLE_1 : WS2812_DUTYCYCLE_0;
-        ws2812_frame_buffer[WS2812_BLUE_BIT(led_number, bit)]  = ((b >> bit) & 0x01) ? WS2812_DUTYCYCLE_1 : WS2812_DUTYCYCLE_0;
-    }
+    ws2812_set_color(led_number, WS2812_RED_BYTE, r);
+    ws2812_set_color(led_number, WS2812_GREEN_BYTE, g);
+    ws2812_set_color(led_number, WS2812_BLUE_BYTE, b);
 }
 void ws2812_write_led_rgbw(uint16_t led_number, uint8_t r, uint8_t g, uint8_t b, uint8_t w) {
-    // Write color to frame buffer
-    for (uint8_t bit = 0; bit < 8; bit++) {
-        ws2812_frame_buffer[WS2812_RED_BIT(led_number, bit)]   = ((r >> bit) & 0x01) ? WS2812_DUTYCYCLE_1 : WS2812_DUTYCYCLE_0;
-        ws2812_frame_buffer[WS2812_GREEN_BIT(led_number, bit)] = ((g >> bit) & 0x01) ? WS2812_DUTYCYCLE_1 : WS2812_DUTYCYCLE_0;
-        ws2812_frame_buffer[WS2812_BLUE_BIT(led_number, bit)]  = ((b >> bit) & 0x01) ? WS2812_DUTYCYCLE_1 : WS2812_DUTYCYCLE_0;
+    ws2812_write_led(led_number, r, g, b);
 #ifdef RGBW
-        ws2812_frame_buffer[WS2812_WHITE_BIT(led_number, bit)] = ((w >> bit) & 0x01) ? WS2812_DUTYCYCLE_1 : WS2812_DUTYCYCLE_0;
+    ws2812_set_color(led_number, WS2812_WHITE_BYTE, w);
 #endif
-    }
 }
 
 // Setleds for standard RGB
@@ -386,6 +346,15 @@ void ws2812_setleds(LED_TYPE* ledarray, uint16_t leds) {
         s_init = true;
     }
 
+#ifdef WS2812_PWM_STREAMING
+    // Wait for the previous frame to finish, the colors are read while it is transmitted
+    osalSysLock();
+    while (ws2812_busy) {
+        osalThreadSuspendS(&ws2812_waiting_thread);
+    }
+    osalSysUnlock();
+#endif
+
     for (uint16_t i = 0; i < leds; i++) {
 #ifdef RGBW
         ws2812_write_led_rgbw(i, ledarray[i].r, ledarray[i].g, ledarray[i].b, ledarray[i].w);
@@ -393,4 +362,20 @@ void ws2812_setleds(LED_TYPE* ledarray, uint16_t leds) {
         ws2812_write_led(i, ledarray[i].r, ledarray[i].g, ledarray[i].b);
 #endif
     }
+
+#ifdef WS2812_PWM_STREAMING
+    // Prime both halves of the buffer, the interrupts take it from there
+    ws2812_stream_pos = 0;
+    ws2812_stream_len = leds * WS2812_CHANNELS;
+    ws2812_sent_zeros = 0;
+    ws2812_fill_half(0);
+    ws2812_fill_half(1);
+    ws2812_busy = true;
+
+    // Disabling the stream clears the interrupt enables along with everything else, so the mode is set up again
+    dmaStreamSetMemory0(WS2812_DMA_STREAM, ws2812_dma_buffer);
+    dmaStreamSetTransactionSize(WS2812_DMA_STREAM, WS2812_DMA_BUFFER_N);
+    dmaStreamSetMode(WS2812_DMA_STREAM, WS2812_DMA_MODE);
+    dmaStreamEnable(WS2812_DMA_STREAM);
+#endif
 }
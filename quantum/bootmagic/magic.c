@@ -34,7 +34,8 @@ __attribute__((weak)) void bootmagic(void) {}
  * FIXME: Needs doc
  */
 void magic(void) {
-    /* check signature */
+    /* check signature, after converting settings written by older firmware */
+    eeconfig_upgrade();
     if (!eeconfig_is_enabled()) {
         eeconfig_init();
     }
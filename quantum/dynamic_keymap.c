@@ -14,6 +14,8 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <string.h>
+
 #include "keymap_introspection.h" // to get keymaps[][][]
 #include "eeprom.h"
 #include "progmem.h" // to read default from flash
@@ -98,56 +100,203 @@ _Static_assert((DYNAMIC_KEYMAP_EEPROM_MAX_ADDR) - (DYNAMIC_KEYMAP_MACRO_EEPROM_A
 #    define DYNAMIC_KEYMAP_MACRO_DELAY TAP_CODE_DELAY
 #endif
 
+#define DYNAMIC_KEYMAP_KEYMAP_SIZE (DYNAMIC_KEYMAP_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS * 2)
+#define DYNAMIC_KEYMAP_ENCODER_SIZE (DYNAMIC_KEYMAP_LAYER_COUNT * NUM_ENCODERS * 2 * 2)
+
+#ifdef DYNAMIC_KEYMAP_RAM_CACHE
+// Time since the last edit after which pending changes are written back to EEPROM
+#    ifndef DYNAMIC_KEYMAP_RAM_CACHE_FLUSH_DELAY
+#        define DYNAMIC_KEYMAP_RAM_CACHE_FLUSH_DELAY 500
+#    endif
+// Time since a hold was last renewed after which it is assumed abandoned, and the held changes discarded
+#    ifndef DYNAMIC_KEYMAP_HOLD_TIMEOUT
+#        define DYNAMIC_KEYMAP_HOLD_TIMEOUT 5000
+#    endif
+
+// RAM mirror of a region of EEPROM, in the same big-endian layout as the EEPROM itself.
+// Changes are accumulated into a single dirty range, and written back in one go.
+typedef struct {
+    uint8_t * data;
+    uintptr_t eeprom_addr;
+    uint16_t  size;
+    uint16_t  dirty_start;
+    uint16_t  dirty_end; // exclusive, dirty_start == dirty_end means clean
+} dynamic_keymap_cache_t;
+
+static uint8_t                dynamic_keymap_cache_data[DYNAMIC_KEYMAP_KEYMAP_SIZE];
+static dynamic_keymap_cache_t dynamic_keymap_cache = {.data = dynamic_keymap_cache_data, .eeprom_addr = DYNAMIC_KEYMAP_EEPROM_ADDR, .size = DYNAMIC_KEYMAP_KEYMAP_SIZE};
+#    ifdef ENCODER_MAP_ENABLE
+static uint8_t                dynamic_keymap_encoder_cache_data[DYNAMIC_KEYMAP_ENCODER_SIZE];
+static dynamic_keymap_cache_t dynamic_keymap_encoder_cache = {.data = dynamic_keymap_encoder_cache_data, .eeprom_addr = DYNAMIC_KEYMAP_ENCODER_EEPROM_ADDR, .size = DYNAMIC_KEYMAP_ENCODER_SIZE};
+#    endif
+static uint16_t dynamic_keymap_cache_last_write = 0;
+static bool     dynamic_keymap_cache_held       = false;
+static uint16_t dynamic_keymap_cache_held_time  = 0;
+
+static void dynamic_keymap_cache_load(dynamic_keymap_cache_t *cache) {
+    eeprom_read_block(cache->data, (const void *)cache->eeprom_addr, cache->size);
+    cache->dirty_start = cache->dirty_end = 0;
+}
+
+static void dynamic_keymap_cache_write(dynamic_keymap_cache_t *cache, uint16_t offset, const uint8_t *data, uint16_t size) {
+    if (offset >= cache->size) return;
+    if (size > cache->size - offset) size = cache->size - offset;
+    if (memcmp(&cache->data[offset], data, size) == 0) return;
+
+    memcpy(&cache->data[offset], data, size);
+    if (cache->dirty_start == cache->dirty_end) {
+        cache->dirty_start = offset;
+        cache->dirty_end   = offset + size;
+    } else {
+        if (offset < cache->dirty_start) cache->dirty_start = offset;
+        if (offset + size > cache->dirty_end) cache->dirty_end = offset + size;
+    }
+    dynamic_keymap_cache_last_write = timer_read();
+}
+
+static void dynamic_keymap_cache_flush(dynamic_keymap_cache_t *cache) {
+    if (cache->dirty_start == cache->dirty_end) return;
+    eeprom_update_block(&cache->data[cache->dirty_start], (void *)(cache->eeprom_addr + cache->dirty_start), cache->dirty_end - cache->dirty_start);
+    cache->dirty_start = cache->dirty_end = 0;
+}
+#endif // DYNAMIC_KEYMAP_RAM_CACHE
+
 uint8_t dynamic_keymap_get_layer_count(void) {
     return DYNAMIC_KEYMAP_LAYER_COUNT;
 }
 
+static inline uint16_t dynamic_keymap_key_to_offset(uint8_t layer, uint8_t row, uint8_t column) {
+    return (layer * MATRIX_ROWS * MATRIX_COLS * 2) + (row * MATRIX_COLS * 2) + (column * 2);
+}
+
 void *dynamic_keymap_key_to_eeprom_address(uint8_t layer, uint8_t row, uint8_t column) {
-    // TODO: optimize this with some left shifts
-    return ((void *)DYNAMIC_KEYMAP_EEPROM_ADDR) + (layer * MATRIX_ROWS * MATRIX_COLS * 2) + (row * MATRIX_COLS * 2) + (column * 2);
+    return ((void *)DYNAMIC_KEYMAP_EEPROM_ADDR) + dynamic_keymap_key_to_offset(layer, row, column);
 }
 
 uint16_t dynamic_keymap_get_keycode(uint8_t layer, uint8_t row, uint8_t column) {
     if (layer >= DYNAMIC_KEYMAP_LAYER_COUNT || row >= MATRIX_ROWS || column >= MATRIX_COLS) return KC_NO;
+#ifdef DYNAMIC_KEYMAP_RAM_CACHE
+    const uint8_t *p = &dynamic_keymap_cache_data[dynamic_keymap_key_to_offset(layer, row, column)];
+    return ((uint16_t)p[0] << 8) | p[1];
+#else
     void *address = dynamic_keymap_key_to_eeprom_address(layer, row, column);
     // Big endian, so we can read/write EEPROM directly from host if we want
     uint16_t keycode = eeprom_read_byte(address) << 8;
     keycode |= eeprom_read_byte(address + 1);
     return keycode;
+#endif
 }
 
 void dynamic_keymap_set_keycode(uint8_t layer, uint8_t row, uint8_t column, uint16_t keycode) {
     if (layer >= DYNAMIC_KEYMAP_LAYER_COUNT || row >= MATRIX_ROWS || column >= MATRIX_COLS) return;
+#ifdef DYNAMIC_KEYMAP_RAM_CACHE
+    uint8_t data[2] = {(uint8_t)(keycode >> 8), (uint8_t)(keycode & 0xFF)};
+    dynamic_keymap_cache_write(&dynamic_keymap_cache, dynamic_keymap_key_to_offset(layer, row, column), data, sizeof(data));
+#else
     void *address = dynamic_keymap_key_to_eeprom_address(layer, row, column);
     // Big endian, so we can read/write EEPROM directly from host if we want
     eeprom_update_byte(address, (uint8_t)(keycode >> 8));
     eeprom_update_byte(address + 1, (uint8_t)(keycode & 0xFF));
+#endif
 }
 
 #ifdef ENCODER_MAP_ENABLE
+static inline uint16_t dynamic_keymap_encoder_to_offset(uint8_t layer, uint8_t encoder_id, bool clockwise) {
+    return (layer * NUM_ENCODERS * 2 * 2) + (encoder_id * 2 * 2) + (clockwise ? 0 : 2);
+}
+
 void *dynamic_keymap_encoder_to_eeprom_address(uint8_t layer, uint8_t encoder_id) {
-    return ((void *)DYNAMIC_KEYMAP_ENCODER_EEPROM_ADDR) + (layer * NUM_ENCODERS * 2 * 2) + (encoder_id * 2 * 2);
+    return ((void *)DYNAMIC_KEYMAP_ENCODER_EEPROM_ADDR) + dynamic_keymap_encoder_to_offset(layer, encoder_id, true);
 }
 
 uint16_t dynamic_keymap_get_encoder(uint8_t layer, uint8_t encoder_id, bool clockwise) {
     if (layer >= DYNAMIC_KEYMAP_LAYER_COUNT || encoder_id >= NUM_ENCODERS) return KC_NO;
+#    ifdef DYNAMIC_KEYMAP_RAM_CACHE
+    const uint8_t *p = &dynamic_keymap_encoder_cache_data[dynamic_keymap_encoder_to_offset(layer, encoder_id, clockwise)];
+    return ((uint16_t)p[0] << 8) | p[1];
+#    else
     void *address = dynamic_keymap_encoder_to_eeprom_address(layer, encoder_id);
     // Big endian, so we can read/write EEPROM directly from host if we want
     uint16_t keycode = ((uint16_t)eeprom_read_byte(address + (clockwise ? 0 : 2))) << 8;
     keycode |= eeprom_read_byte(address + (clockwise ? 0 : 2) + 1);
     return keycode;
+#    endif
 }
 
 void dynamic_keymap_set_encoder(uint8_t layer, uint8_t encoder_id, bool clockwise, uint16_t keycode) {
     if (layer >= DYNAMIC_KEYMAP_LAYER_COUNT || encoder_id >= NUM_ENCODERS) return;
+#    ifdef DYNAMIC_KEYMAP_RAM_CACHE
+    uint8_t data[2] = {(uint8_t)(keycode >> 8), (uint8_t)(keycode & 0xFF)};
+    dynamic_keymap_cache_write(&dynamic_keymap_encoder_cache, dynamic_keymap_encoder_to_offset(layer, encoder_id, clockwise), data, sizeof(data));
+#    else
     void *address = dynamic_keymap_encoder_to_eeprom_address(layer, encoder_id);
     // Big endian, so we can read/write EEPROM directly from host if we want
     eeprom_update_byte(address + (clockwise ? 0 : 2), (uint8_t)(keycode >> 8));
     eeprom_update_byte(address + (clockwise ? 0 : 2) + 1, (uint8_t)(keycode & 0xFF));
+#    endif
 }
 #endif // ENCODER_MAP_ENABLE
 
+void dynamic_keymap_init(void) {
+#ifdef DYNAMIC_KEYMAP_RAM_CACHE
+    dynamic_keymap_cache_load(&dynamic_keymap_cache);
+#    ifdef ENCODER_MAP_ENABLE
+    dynamic_keymap_cache_load(&dynamic_keymap_encoder_cache);
+#    endif
+#endif
+}
+
+void dynamic_keymap_hold(bool hold) {
+#ifdef DYNAMIC_KEYMAP_RAM_CACHE
+    if (hold && !dynamic_keymap_cache_held) {
+        // only what is changed from here on should be held back
+        dynamic_keymap_flush();
+    }
+    dynamic_keymap_cache_held      = hold;
+    dynamic_keymap_cache_held_time = timer_read();
+#endif
+}
+
+bool dynamic_keymap_is_held(void) {
+#ifdef DYNAMIC_KEYMAP_RAM_CACHE
+    return dynamic_keymap_cache_held;
+#else
+    return false;
+#endif
+}
+
+void dynamic_keymap_flush(void) {
+#ifdef DYNAMIC_KEYMAP_RAM_CACHE
+    if (dynamic_keymap_cache_held) {
+        return;
+    }
+    dynamic_keymap_cache_flush(&dynamic_keymap_cache);
+#    ifdef ENCODER_MAP_ENABLE
+    dynamic_keymap_cache_flush(&dynamic_keymap_encoder_cache);
+#    endif
+#endif
+}
+
+void dynamic_keymap_task(void) {
+#ifdef DYNAMIC_KEYMAP_RAM_CACHE
+    // Whoever took the hold has gone away (e.g. the host was unplugged mid-transfer), so drop what they left behind
+    if (dynamic_keymap_cache_held && timer_elapsed(dynamic_keymap_cache_held_time) >= DYNAMIC_KEYMAP_HOLD_TIMEOUT) {
+        dynamic_keymap_init();
+        dynamic_keymap_cache_held = false;
+    }
+    // Coalesce bursts of edits (e.g. from VIA) into a single write-back
+    if (timer_elapsed(dynamic_keymap_cache_last_write) >= DYNAMIC_KEYMAP_RAM_CACHE_FLUSH_DELAY) {
+        dynamic_keymap_flush();
+    }
+#endif
+}
+
 void dynamic_keymap_reset(void) {
+#ifdef DYNAMIC_KEYMAP_RAM_CACHE
+    // The EEPROM may have just been erased underneath the cache, so drop any pending changes and compare against
+    // what is actually stored, otherwise entries matching the stale cache would never be written back.
+    dynamic_keymap_init();
+#endif
     // Reset the keymaps in EEPROM to what is in flash.
     for (int layer = 0; layer < DYNAMIC_KEYMAP_LAYER_COUNT; layer++) {
         for (int row = 0; row < MATRIX_ROWS; row++) {
@@ -171,10 +320,20 @@ void dynamic_keymap_reset(void) {
         }
 #endif // ENCODER_MAP_ENABLE
     }
+    // Callers rely on the reset having hit EEPROM before they mark it as valid
+    dynamic_keymap_flush();
 }
 
 void dynamic_keymap_get_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
-    uint16_t dynamic_keymap_eeprom_size = DYNAMIC_KEYMAP_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS * 2;
+#ifdef DYNAMIC_KEYMAP_RAM_CACHE
+    uint16_t cached = 0;
+    if (offset < DYNAMIC_KEYMAP_KEYMAP_SIZE) {
+        cached = (size < DYNAMIC_KEYMAP_KEYMAP_SIZE - offset) ? size : (DYNAMIC_KEYMAP_KEYMAP_SIZE - offset);
+        memcpy(data, &dynamic_keymap_cache_data[offset], cached);
+    }
+    memset(data + cached, 0x00, size - cached);
+#else
+    uint16_t dynamic_keymap_eeprom_size = DYNAMIC_KEYMAP_KEYMAP_SIZE;
     void *   source                     = (void *)(DYNAMIC_KEYMAP_EEPROM_ADDR + offset);
     uint8_t *target                     = data;
     for (uint16_t i = 0; i < size; i++) {
@@ -186,10 +345,14 @@ void dynamic_keymap_get_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
         source++;
         target++;
     }
+#endif
 }
 
 void dynamic_keymap_set_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
-    uint16_t dynamic_keymap_eeprom_size = DYNAMIC_KEYMAP_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS * 2;
+#ifdef DYNAMIC_KEYMAP_RAM_CACHE
+    dynamic_keymap_cache_write(&dynamic_keymap_cache, offset, data, size);
+#else
+    uint16_t dynamic_keymap_eeprom_size = DYNAMIC_KEYMAP_KEYMAP_SIZE;
     void *   target                     = (void *)(DYNAMIC_KEYMAP_EEPROM_ADDR + offset);
     uint8_t *source                     = data;
     for (uint16_t i = 0; i < size; i++) {
@@ -199,6 +362,7 @@ void dynamic_keymap_set_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
         source++;
         target++;
     }
+#endif
 }
 
 uint16_t keycode_at_keymap_location(uint8_t layer_num, uint8_t row, uint8_t column) {
@@ -27,6 +27,18 @@ uint16_t dynamic_keymap_get_encoder(uint8_t layer, uint8_t encoder_id, bool cloc
 void     dynamic_keymap_set_encoder(uint8_t layer, uint8_t encoder_id, bool clockwise, uint16_t keycode);
 #endif // ENCODER_MAP_ENABLE
 void dynamic_keymap_reset(void);
+// Loads the RAM copy of the keymap when DYNAMIC_KEYMAP_RAM_CACHE is enabled, discarding any pending changes.
+// Must also be called whenever the EEPROM has been changed behind its back (e.g. erased).
+void dynamic_keymap_init(void);
+// Writes any pending keymap changes held in RAM back to EEPROM
+void dynamic_keymap_flush(void);
+// While held, changes made from then on are kept in RAM only, so they can still be discarded with
+// dynamic_keymap_init() (e.g. until a transfer has been verified). Does nothing without DYNAMIC_KEYMAP_RAM_CACHE.
+// Calling it again with true renews the hold; one not renewed within DYNAMIC_KEYMAP_HOLD_TIMEOUT is released and
+// the held changes discarded.
+void dynamic_keymap_hold(bool hold);
+bool dynamic_keymap_is_held(void);
+void dynamic_keymap_task(void);
 // These get/set the keycodes as stored in the EEPROM buffer
 // Data is big-endian 16-bit values (the keycodes)
 // Order is by layer/row/column
@@ -4,6 +4,7 @@
 #include "eeprom.h"
 #include "eeconfig.h"
 #include "action_layer.h"
+#include "timer.h"
 
 #if defined(EEPROM_DRIVER)
 #    include "eeprom_driver.h"
@@ -19,6 +20,159 @@ void via_eeprom_set_valid(bool valid);
 void eeconfig_init_via(void);
 #endif
 
+#if defined(DYNAMIC_KEYMAP_ENABLE)
+void dynamic_keymap_init(void);
+#endif
+
+/*
+    RAM copy of the core settings region. It is loaded with a single read on
+    first use, and changed bytes are tracked individually so that flushing
+    only ever writes bytes that went through this API. Anything writing
+    directly to EEPROM needs to call eeconfig_reload() afterwards.
+*/
+static uint8_t  eeconfig_cache[EECONFIG_BASE_SIZE];
+static uint8_t  eeconfig_cache_dirty[(EECONFIG_BASE_SIZE + 7) / 8];
+static bool     eeconfig_cache_loaded  = false;
+static bool     eeconfig_cache_pending = false;
+static uint16_t eeconfig_cache_last_update;
+
+static inline bool eeconfig_cache_is_dirty(uintptr_t offset) {
+    return eeconfig_cache_dirty[offset / 8] & (1 << (offset % 8));
+}
+
+static void eeconfig_cache_discard(void) {
+    memset(eeconfig_cache_dirty, 0, sizeof(eeconfig_cache_dirty));
+    eeconfig_cache_pending = false;
+}
+
+/** \brief eeconfig reload
+ *
+ * Rereads the core settings from EEPROM, keeping any changes that are still pending.
+ */
+void eeconfig_reload(void) {
+    uint8_t stored[EECONFIG_BASE_SIZE];
+    eeprom_read_block(stored, (const void *)0, EECONFIG_BASE_SIZE);
+    for (uintptr_t offset = 0; offset < EECONFIG_BASE_SIZE; offset++) {
+        if (!eeconfig_cache_is_dirty(offset)) {
+            eeconfig_cache[offset] = stored[offset];
+        }
+    }
+    eeconfig_cache_loaded = true;
+}
+
+void eeconfig_read_block(void *data, const void *addr, size_t size) {
+    uintptr_t offset = (uintptr_t)addr;
+    uint8_t * dest   = (uint8_t *)data;
+
+    if (offset < EECONFIG_BASE_SIZE && size > 0) {
+        if (!eeconfig_cache_loaded) {
+            eeconfig_reload();
+        }
+        size_t cached = (size < EECONFIG_BASE_SIZE - offset) ? size : (EECONFIG_BASE_SIZE - offset);
+        memcpy(dest, &eeconfig_cache[offset], cached);
+        dest += cached;
+        offset += cached;
+        size -= cached;
+    }
+
+    if (size > 0) {
+        eeprom_read_block(dest, (const void *)offset, size);
+    }
+}
+
+void eeconfig_update_block(const void *data, void *addr, size_t size) {
+    uintptr_t      offset = (uintptr_t)addr;
+    const uint8_t *src    = (const uint8_t *)data;
+
+    if (offset < EECONFIG_BASE_SIZE && size > 0) {
+        if (!eeconfig_cache_loaded) {
+            eeconfig_reload();
+        }
+        while (offset < EECONFIG_BASE_SIZE && size > 0) {
+            if (eeconfig_cache[offset] != *src) {
+                eeconfig_cache[offset] = *src;
+                eeconfig_cache_dirty[offset / 8] |= (1 << (offset % 8));
+                eeconfig_cache_pending     = true;
+                eeconfig_cache_last_update = timer_read();
+            }
+            src++;
+            offset++;
+            size--;
+        }
+    }
+
+    if (size > 0) {
+        eeprom_update_block(src, (void *)offset, size);
+    }
+}
+
+uint8_t eeconfig_read_byte(const uint8_t *addr) {
+    uint8_t ret = 0;
+    eeconfig_read_block(&ret, addr, sizeof(ret));
+    return ret;
+}
+
+void eeconfig_update_byte(uint8_t *addr, uint8_t value) {
+    eeconfig_update_block(&value, addr, sizeof(value));
+}
+
+uint16_t eeconfig_read_word(const uint16_t *addr) {
+    uint16_t ret = 0;
+    eeconfig_read_block(&ret, addr, sizeof(ret));
+    return ret;
+}
+
+void eeconfig_update_word(uint16_t *addr, uint16_t value) {
+    eeconfig_update_block(&value, addr, sizeof(value));
+}
+
+uint32_t eeconfig_read_dword(const uint32_t *addr) {
+    uint32_t ret = 0;
+    eeconfig_read_block(&ret, addr, sizeof(ret));
+    return ret;
+}
+
+void eeconfig_update_dword(uint32_t *addr, uint32_t value) {
+    eeconfig_update_block(&value, addr, sizeof(value));
+}
+
+/** \brief eeconfig flush
+ *
+ * Commits all pending changes to the core settings, writing each run of changed bytes in one go.
+ */
+void eeconfig_flush(void) {
+    if (!eeconfig_cache_pending) {
+        return;
+    }
+
+    uintptr_t offset = 0;
+    while (offset < EECONFIG_BASE_SIZE) {
+        if (!eeconfig_cache_is_dirty(offset)) {
+            offset++;
+            continue;
+        }
+        uintptr_t end = offset;
+        while (end < EECONFIG_BASE_SIZE && eeconfig_cache_is_dirty(end)) {
+            end++;
+        }
+        eeprom_update_block(&eeconfig_cache[offset], (void *)offset, end - offset);
+        offset = end;
+    }
+
+    memset(eeconfig_cache_dirty, 0, sizeof(eeconfig_cache_dirty));
+    eeconfig_cache_pending = false;
+}
+
+/** \brief eeconfig task
+ *
+ * Commits pending changes once EECONFIG_FLUSH_DELAY has passed since the last one.
+ */
+void eeconfig_task(void) {
+    if (eeconfig_cache_pending && timer_elapsed(eeconfig_cache_last_update) >= (EECONFIG_FLUSH_DELAY)) {
+        eeconfig_flush();
+    }
+}
+
 /** \brief eeconfig enable
  *
  * FIXME: needs doc
@@ -45,24 +199,30 @@ __attribute__((weak)) void eeconfig_init_kb(void) {
 void eeconfig_init_quantum(void) {
 #if defined(EEPROM_DRIVER)
     eeprom_driver_erase();
+    // Anything pending or held in RAM was meant for what has just been erased
+    eeconfig_cache_discard();
+    eeconfig_reload();
+#    if defined(DYNAMIC_KEYMAP_ENABLE)
+    dynamic_keymap_init();
+#    endif
 #endif
 
-    eeprom_update_word(EECONFIG_MAGIC, EECONFIG_MAGIC_NUMBER);
-    eeprom_update_byte(EECONFIG_DEBUG, 0);
-    eeprom_update_byte(EECONFIG_DEFAULT_LAYER, 0);
+    eeconfig_update_word(EECONFIG_MAGIC, EECONFIG_MAGIC_NUMBER);
+    eeconfig_update_byte(EECONFIG_DEBUG, 0);
+    eeconfig_update_byte(EECONFIG_DEFAULT_LAYER, 0);
     default_layer_state = 0;
     // Enable oneshot and autocorrect by default: 0b0001 0100 0000 0000
-    eeprom_update_word(EECONFIG_KEYMAP, 0x1400);
-    eeprom_update_byte(EECONFIG_BACKLIGHT, 0);
-    eeprom_update_byte(EECONFIG_AUDIO, 0xFF); // On by default
-    eeprom_update_dword(EECONFIG_RGBLIGHT, 0);
-    eeprom_update_byte(EECONFIG_RGBLIGHT_EXTENDED, 0);
-    eeprom_update_byte(EECONFIG_VELOCIKEY, 0);
-    eeprom_update_byte(EECONFIG_UNICODEMODE, 0);
-    eeprom_update_byte(EECONFIG_STENOMODE, 0);
+    eeconfig_update_word(EECONFIG_KEYMAP, 0x1400);
+    eeconfig_update_byte(EECONFIG_BACKLIGHT, 0);
+    eeconfig_update_byte(EECONFIG_AUDIO, 0xFF); // On by default
+    eeconfig_update_dword(EECONFIG_RGBLIGHT, 0);
+    eeconfig_update_byte(EECONFIG_RGBLIGHT_EXTENDED, 0);
+    eeconfig_update_byte(EECONFIG_VELOCIKEY, 0);
+    eeconfig_update_byte(EECONFIG_UNICODEMODE, 0);
+    eeconfig_update_byte(EECONFIG_STENOMODE, 0);
     uint64_t dummy = 0;
-    eeprom_update_block(&dummy, EECONFIG_RGB_MATRIX, sizeof(uint64_t));
-    eeprom_update_dword(EECONFIG_HAPTIC, 0);
+    eeconfig_update_block(&dummy, EECONFIG_RGB_MATRIX, sizeof(uint64_t));
+    eeconfig_update_dword(EECONFIG_HAPTIC, 0);
 #if defined(HAPTIC_ENABLE)
     haptic_reset();
 #endif
@@ -84,6 +244,9 @@ void eeconfig_init_quantum(void) {
 #endif
 
     eeconfig_init_kb();
+
+    // Commit the whole reset as one batch
+    eeconfig_flush();
 }
 
 /** \brief eeconfig initialization
@@ -99,7 +262,8 @@ void eeconfig_init(void) {
  * FIXME: needs doc
  */
 void eeconfig_enable(void) {
-    eeprom_update_word(EECONFIG_MAGIC, EECONFIG_MAGIC_NUMBER);
+    eeconfig_update_word(EECONFIG_MAGIC, EECONFIG_MAGIC_NUMBER);
+    eeconfig_flush();
 }
 
 /** \brief eeconfig disable
@@ -109,8 +273,14 @@ void eeconfig_enable(void) {
 void eeconfig_disable(void) {
 #if defined(EEPROM_DRIVER)
     eeprom_driver_erase();
+    eeconfig_cache_discard();
+    eeconfig_reload();
+#    if defined(DYNAMIC_KEYMAP_ENABLE)
+    dynamic_keymap_init();
+#    endif
 #endif
-    eeprom_update_word(EECONFIG_MAGIC, EECONFIG_MAGIC_NUMBER_OFF);
+    eeconfig_update_word(EECONFIG_MAGIC, EECONFIG_MAGIC_NUMBER_OFF);
+    eeconfig_flush();
 }
 
 /** \brief eeconfig is enabled
@@ -118,7 +288,7 @@ void eeconfig_disable(void) {
  * FIXME: needs doc
  */
 bool eeconfig_is_enabled(void) {
-    bool is_eeprom_enabled = (eeprom_read_word(EECONFIG_MAGIC) == EECONFIG_MAGIC_NUMBER);
+    bool is_eeprom_enabled = (eeconfig_read_word(EECONFIG_MAGIC) == EECONFIG_MAGIC_NUMBER);
 #ifdef VIA_ENABLE
     if (is_eeprom_enabled) {
         is_eeprom_enabled = via_eeprom_is_valid();
@@ -132,7 +302,7 @@ bool eeconfig_is_enabled(void) {
  * FIXME: needs doc
  */
 bool eeconfig_is_disabled(void) {
-    bool is_eeprom_disabled = (eeprom_read_word(EECONFIG_MAGIC) == EECONFIG_MAGIC_NUMBER_OFF);
+    bool is_eeprom_disabled = (eeconfig_read_word(EECONFIG_MAGIC) == EECONFIG_MAGIC_NUMBER_OFF);
 #ifdef VIA_ENABLE
     if (!is_eeprom_disabled) {
         is_eeprom_disabled = !via_eeprom_is_valid();
@@ -146,14 +316,14 @@ bool eeconfig_is_disabled(void) {
  * FIXME: needs doc
  */
 uint8_t eeconfig_read_debug(void) {
-    return eeprom_read_byte(EECONFIG_DEBUG);
+    return eeconfig_read_byte(EECONFIG_DEBUG);
 }
 /** \brief eeconfig update debug
  *
  * FIXME: needs doc
  */
 void eeconfig_update_debug(uint8_t val) {
-    eeprom_update_byte(EECONFIG_DEBUG, val);
+    eeconfig_update_byte(EECONFIG_DEBUG, val);
 }
 
 /** \brief eeconfig read default layer
@@ -161,14 +331,14 @@ void eeconfig_update_debug(uint8_t val) {
  * FIXME: needs doc
  */
 uint8_t eeconfig_read_default_layer(void) {
-    return eeprom_read_byte(EECONFIG_DEFAULT_LAYER);
+    return eeconfig_read_byte(EECONFIG_DEFAULT_LAYER);
 }
 /** \brief eeconfig update default layer
  *
  * FIXME: needs doc
  */
 void eeconfig_update_default_layer(uint8_t val) {
-    eeprom_update_byte(EECONFIG_DEFAULT_LAYER, val);
+    eeconfig_update_byte(EECONFIG_DEFAULT_LAYER, val);
 }
 
 /** \brief eeconfig read keymap
@@ -176,14 +346,14 @@ void eeconfig_update_default_layer(uint8_t val) {
  * FIXME: needs doc
  */
 uint16_t eeconfig_read_keymap(void) {
-    return eeprom_read_word(EECONFIG_KEYMAP);
+    return eeconfig_read_word(EECONFIG_KEYMAP);
 }
 /** \brief eeconfig update keymap
  *
  * FIXME: needs doc
  */
 void eeconfig_update_keymap(uint16_t val) {
-    eeprom_update_word(EECONFIG_KEYMAP, val);
+    eeconfig_update_word(EECONFIG_KEYMAP, val);
 }
 
 /** \brief eeconfig read audio
@@ -191,14 +361,14 @@ void eeconfig_update_keymap(uint16_t val) {
  * FIXME: needs doc
  */
 uint8_t eeconfig_read_audio(void) {
-    return eeprom_read_byte(EECONFIG_AUDIO);
+    return eeconfig_read_byte(EECONFIG_AUDIO);
 }
 /** \brief eeconfig update audio
  *
  * FIXME: needs doc
  */
 void eeconfig_update_audio(uint8_t val) {
-    eeprom_update_byte(EECONFIG_AUDIO, val);
+    eeconfig_update_byte(EECONFIG_AUDIO, val);
 }
 
 #if (EECONFIG_KB_DATA_SIZE) == 0
@@ -207,14 +377,14 @@ void eeconfig_update_audio(uint8_t val) {
  * FIXME: needs doc
  */
 uint32_t eeconfig_read_kb(void) {
-    return eeprom_read_dword(EECONFIG_KEYBOARD);
+    return eeconfig_read_dword(EECONFIG_KEYBOARD);
 }
 /** \brief eeconfig update kb
  *
  * FIXME: needs doc
  */
 void eeconfig_update_kb(uint32_t val) {
-    eeprom_update_dword(EECONFIG_KEYBOARD, val);
+    eeconfig_update_dword(EECONFIG_KEYBOARD, val);
 }
 #endif // (EECONFIG_KB_DATA_SIZE) == 0
 
@@ -224,14 +394,14 @@ void eeconfig_update_kb(uint32_t val) {
  * FIXME: needs doc
  */
 uint32_t eeconfig_read_user(void) {
-    return eeprom_read_dword(EECONFIG_USER);
+    return eeconfig_read_dword(EECONFIG_USER);
 }
 /** \brief eeconfig update user
  *
  * FIXME: needs doc
  */
 void eeconfig_update_user(uint32_t val) {
-    eeprom_update_dword(EECONFIG_USER, val);
+    eeconfig_update_dword(EECONFIG_USER, val);
 }
 #endif // (EECONFIG_USER_DATA_SIZE) == 0
 
@@ -240,14 +410,14 @@ void eeconfig_update_user(uint32_t val) {
  * FIXME: needs doc
  */
 uint32_t eeconfig_read_haptic(void) {
-    return eeprom_read_dword(EECONFIG_HAPTIC);
+    return eeconfig_read_dword(EECONFIG_HAPTIC);
 }
 /** \brief eeconfig update haptic
  *
  * FIXME: needs doc
  */
 void eeconfig_update_haptic(uint32_t val) {
-    eeprom_update_dword(EECONFIG_HAPTIC, val);
+    eeconfig_update_dword(EECONFIG_HAPTIC, val);
 }
 
 /** \brief eeconfig read split handedness
@@ -255,42 +425,109 @@ void eeconfig_update_haptic(uint32_t val) {
  * FIXME: needs doc
  */
 bool eeconfig_read_handedness(void) {
-    return !!eeprom_read_byte(EECONFIG_HANDEDNESS);
+    return !!eeconfig_read_byte(EECONFIG_HANDEDNESS);
 }
 /** \brief eeconfig update split handedness
  *
  * FIXME: needs doc
  */
 void eeconfig_update_handedness(bool val) {
-    eeprom_update_byte(EECONFIG_HANDEDNESS, !!val);
+    eeconfig_update_byte(EECONFIG_HANDEDNESS, !!val);
+}
+
+#if ((EECONFIG_KB_DATA_SIZE) > 0) || ((EECONFIG_USER_DATA_SIZE) > 0)
+typedef struct {
+    uint32_t *version_addr;
+    uint8_t * checksum_addr;
+    uint8_t * data_addr;
+    uint16_t  size;
+    uint32_t  version;
+    bool (*migrate)(uint32_t version, void *data);
+} eeconfig_datablock_t;
+
+// CRC-8, polynomial 0x07
+static uint8_t eeconfig_datablock_checksum(const void *data, uint16_t size) {
+    const uint8_t *p   = (const uint8_t *)data;
+    uint8_t        crc = 0;
+    while (size--) {
+        crc ^= *p++;
+        for (uint8_t i = 0; i < 8; i++) {
+            crc = (crc & 0x80) ? (crc << 1) ^ 0x07 : (crc << 1);
+        }
+    }
+    return crc;
+}
+
+static bool eeconfig_is_datablock_valid(const eeconfig_datablock_t *block, void *scratch) {
+    if (eeconfig_read_dword(block->version_addr) != block->version) {
+        return false;
+    }
+    eeprom_read_block(scratch, block->data_addr, block->size);
+    return eeprom_read_byte(block->checksum_addr) == eeconfig_datablock_checksum(scratch, block->size);
+}
+
+static void eeconfig_update_datablock(const eeconfig_datablock_t *block, const void *data) {
+    eeprom_update_block(data, block->data_addr, block->size);
+    eeprom_update_byte(block->checksum_addr, eeconfig_datablock_checksum(data, block->size));
+    // The version lives in the core region; commit it together with the data
+    eeconfig_update_dword(block->version_addr, block->version);
+    eeconfig_flush();
 }
 
+static void eeconfig_read_datablock(const eeconfig_datablock_t *block, void *data) {
+    if (eeconfig_is_datablock_valid(block, data)) {
+        return;
+    }
+
+    // Give the owner a chance to convert data written by a previous version
+    uint32_t stored_version = eeconfig_read_dword(block->version_addr);
+    if (stored_version != block->version) {
+        eeprom_read_block(data, block->data_addr, block->size);
+        if (block->migrate(stored_version, data)) {
+            eeconfig_update_datablock(block, data);
+            return;
+        }
+    }
+
+    memset(data, 0, block->size);
+}
+#endif
+
 #if (EECONFIG_KB_DATA_SIZE) > 0
+__attribute__((weak)) bool eeconfig_migrate_kb_datablock(uint32_t version, void *data) {
+    return false;
+}
+
+static const eeconfig_datablock_t eeconfig_kb_datablock = {
+    .version_addr  = EECONFIG_KEYBOARD,
+    .checksum_addr = EECONFIG_KB_DATA_CHECKSUM,
+    .data_addr     = EECONFIG_KB_DATABLOCK,
+    .size          = (EECONFIG_KB_DATA_SIZE),
+    .version       = (EECONFIG_KB_DATA_VERSION),
+    .migrate       = eeconfig_migrate_kb_datablock,
+};
+
 /** \brief eeconfig assert keyboard data block version
  *
  * FIXME: needs doc
  */
 bool eeconfig_is_kb_datablock_valid(void) {
-    return eeprom_read_dword(EECONFIG_KEYBOARD) == (EECONFIG_KB_DATA_VERSION);
+    uint8_t scratch[(EECONFIG_KB_DATA_SIZE)];
+    return eeconfig_is_datablock_valid(&eeconfig_kb_datablock, scratch);
 }
 /** \brief eeconfig read keyboard data block
  *
  * FIXME: needs doc
  */
 void eeconfig_read_kb_datablock(void *data) {
-    if (eeconfig_is_kb_datablock_valid()) {
-        eeprom_read_block(data, EECONFIG_KB_DATABLOCK, (EECONFIG_KB_DATA_SIZE));
-    } else {
-        memset(data, 0, (EECONFIG_KB_DATA_SIZE));
-    }
+    eeconfig_read_datablock(&eeconfig_kb_datablock, data);
 }
 /** \brief eeconfig update keyboard data block
  *
  * FIXME: needs doc
  */
 void eeconfig_update_kb_datablock(const void *data) {
-    eeprom_update_dword(EECONFIG_KEYBOARD, (EECONFIG_KB_DATA_VERSION));
-    eeprom_update_block(data, EECONFIG_KB_DATABLOCK, (EECONFIG_KB_DATA_SIZE));
+    eeconfig_update_datablock(&eeconfig_kb_datablock, data);
 }
 /** \brief eeconfig init keyboard data block
  *
@@ -303,31 +540,40 @@ __attribute__((weak)) void eeconfig_init_kb_datablock(void) {
 #endif // (EECONFIG_KB_DATA_SIZE) > 0
 
 #if (EECONFIG_USER_DATA_SIZE) > 0
+__attribute__((weak)) bool eeconfig_migrate_user_datablock(uint32_t version, void *data) {
+    return false;
+}
+
+static const eeconfig_datablock_t eeconfig_user_datablock = {
+    .version_addr  = EECONFIG_USER,
+    .checksum_addr = EECONFIG_USER_DATA_CHECKSUM,
+    .data_addr     = EECONFIG_USER_DATABLOCK,
+    .size          = (EECONFIG_USER_DATA_SIZE),
+    .version       = (EECONFIG_USER_DATA_VERSION),
+    .migrate       = eeconfig_migrate_user_datablock,
+};
+
 /** \brief eeconfig assert user data block version
  *
  * FIXME: needs doc
  */
 bool eeconfig_is_user_datablock_valid(void) {
-    return eeprom_read_dword(EECONFIG_USER) == (EECONFIG_USER_DATA_VERSION);
+    uint8_t scratch[(EECONFIG_USER_DATA_SIZE)];
+    return eeconfig_is_datablock_valid(&eeconfig_user_datablock, scratch);
 }
 /** \brief eeconfig read user data block
  *
  * FIXME: needs doc
  */
 void eeconfig_read_user_datablock(void *data) {
-    if (eeconfig_is_user_datablock_valid()) {
-        eeprom_read_block(data, EECONFIG_USER_DATABLOCK, (EECONFIG_USER_DATA_SIZE));
-    } else {
-        memset(data, 0, (EECONFIG_USER_DATA_SIZE));
-    }
+    eeconfig_read_datablock(&eeconfig_user_datablock, data);
 }
 /** \brief eeconfig update user data block
  *
  * FIXME: needs doc
  */
 void eeconfig_update_user_datablock(const void *data) {
-    eeprom_update_dword(EECONFIG_USER, (EECONFIG_USER_DATA_VERSION));
-    eeprom_update_block(data, EECONFIG_USER_DATABLOCK, (EECONFIG_USER_DATA_SIZE));
+    eeconfig_update_datablock(&eeconfig_user_datablock, data);
 }
 /** \brief eeconfig init user data block
  *
@@ -338,3 +584,58 @@ __attribute__((weak)) void eeconfig_init_user_datablock(void) {
     eeconfig_update_user_datablock(dummy_user);
 }
 #endif // (EECONFIG_USER_DATA_SIZE) > 0
+
+#ifdef EECONFIG_MAGIC_NUMBER_NO_DATABLOCK_CHECKSUM
+#    if ((EECONFIG_KB_DATA_SIZE) > 0) || ((EECONFIG_USER_DATA_SIZE) > 0)
+// Moves a datablock stored without a checksum into place. The stored version is kept, so that the usual migration
+// still applies on the next read if it is out of date.
+static void eeconfig_upgrade_datablock(const eeconfig_datablock_t *block, const void *old_addr, void *scratch) {
+    eeprom_read_block(scratch, old_addr, block->size);
+    eeprom_update_block(scratch, block->data_addr, block->size);
+    eeprom_update_byte(block->checksum_addr, eeconfig_datablock_checksum(scratch, block->size));
+}
+
+// Everything stored after eeconfig, such as VIA's settings and the dynamic keymap, is addressed relative to
+// EECONFIG_SIZE, so moves up along with the datablocks. Copied from the top down, so nothing is overwritten before it
+// has moved -- only the last few bytes of EEPROM, which no longer fit, are lost.
+static void eeconfig_upgrade_move_tail(uintptr_t old_start, uintptr_t shift) {
+    uint8_t   scratch[32];
+    uintptr_t end = (TOTAL_EEPROM_BYTE_COUNT) - shift;
+    while (end > old_start) {
+        size_t len = (end - old_start < sizeof(scratch)) ? (end - old_start) : sizeof(scratch);
+        end -= len;
+        eeprom_read_block(scratch, (const void *)end, len);
+        eeprom_update_block(scratch, (void *)(end + shift), len);
+    }
+}
+#    endif
+#endif
+
+/** \brief eeconfig upgrade
+ *
+ * Settings written before the datablocks gained their checksum byte are otherwise still valid, so the blocks, and
+ * everything stored after them, are moved up to make room for it rather than resetting everything.
+ */
+void eeconfig_upgrade(void) {
+#ifdef EECONFIG_MAGIC_NUMBER_NO_DATABLOCK_CHECKSUM
+    if (eeconfig_read_word(EECONFIG_MAGIC) != EECONFIG_MAGIC_NUMBER_NO_DATABLOCK_CHECKSUM) {
+        return;
+    }
+
+    // Everything moves up, so it's moved from the top down to avoid overwriting anything before it has moved
+#    if ((EECONFIG_KB_DATA_SIZE) > 0) || ((EECONFIG_USER_DATA_SIZE) > 0)
+    eeconfig_upgrade_move_tail((EECONFIG_BASE_SIZE) + (EECONFIG_KB_DATA_SIZE) + (EECONFIG_USER_DATA_SIZE), (EECONFIG_KB_DATABLOCK_SIZE) - (EECONFIG_KB_DATA_SIZE) + (EECONFIG_USER_DATABLOCK_SIZE) - (EECONFIG_USER_DATA_SIZE));
+#    endif
+#    if (EECONFIG_USER_DATA_SIZE) > 0
+    uint8_t user_scratch[(EECONFIG_USER_DATA_SIZE)];
+    eeconfig_upgrade_datablock(&eeconfig_user_datablock, (const void *)((EECONFIG_BASE_SIZE) + (EECONFIG_KB_DATA_SIZE)), user_scratch);
+#    endif
+#    if (EECONFIG_KB_DATA_SIZE) > 0
+    uint8_t kb_scratch[(EECONFIG_KB_DATA_SIZE)];
+    eeconfig_upgrade_datablock(&eeconfig_kb_datablock, (const void *)(EECONFIG_BASE_SIZE), kb_scratch);
+#    endif
+
+    eeconfig_update_word(EECONFIG_MAGIC, EECONFIG_MAGIC_NUMBER);
+    eeconfig_flush();
+#endif
+}
@@ -19,9 +19,12 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <stddef.h>
 
 #ifndef EECONFIG_MAGIC_NUMBER
-#    define EECONFIG_MAGIC_NUMBER (uint16_t)0xFEE6 // When changing, decrement this value to avoid future re-init issues
+#    define EECONFIG_MAGIC_NUMBER (uint16_t)0xFEE5 // When changing, decrement this value to avoid future re-init issues
+// Written by firmware storing the datablocks without a checksum, which eeconfig_upgrade() converts from
+#    define EECONFIG_MAGIC_NUMBER_NO_DATABLOCK_CHECKSUM (uint16_t)0xFEE6
 #endif
 #define EECONFIG_MAGIC_NUMBER_OFF (uint16_t)0xFFFF
 
@@ -64,11 +67,30 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #    define EECONFIG_USER_DATA_VERSION (EECONFIG_USER_DATA_SIZE)
 #endif
 
-#define EECONFIG_KB_DATABLOCK ((uint8_t *)(EECONFIG_BASE_SIZE))
-#define EECONFIG_USER_DATABLOCK ((uint8_t *)((EECONFIG_BASE_SIZE) + (EECONFIG_KB_DATA_SIZE)))
+// Each datablock is preceded by a checksum byte, so that corrupted or relocated data is detected
+#if (EECONFIG_KB_DATA_SIZE) > 0
+#    define EECONFIG_KB_DATABLOCK_SIZE ((EECONFIG_KB_DATA_SIZE) + 1)
+#else
+#    define EECONFIG_KB_DATABLOCK_SIZE 0
+#endif
+#if (EECONFIG_USER_DATA_SIZE) > 0
+#    define EECONFIG_USER_DATABLOCK_SIZE ((EECONFIG_USER_DATA_SIZE) + 1)
+#else
+#    define EECONFIG_USER_DATABLOCK_SIZE 0
+#endif
+
+#define EECONFIG_KB_DATA_CHECKSUM ((uint8_t *)(EECONFIG_BASE_SIZE))
+#define EECONFIG_KB_DATABLOCK (EECONFIG_KB_DATA_CHECKSUM + 1)
+#define EECONFIG_USER_DATA_CHECKSUM ((uint8_t *)((EECONFIG_BASE_SIZE) + (EECONFIG_KB_DATABLOCK_SIZE)))
+#define EECONFIG_USER_DATABLOCK (EECONFIG_USER_DATA_CHECKSUM + 1)
 
 // Size of EEPROM being used, other code can refer to this for available EEPROM
-#define EECONFIG_SIZE ((EECONFIG_BASE_SIZE) + (EECONFIG_KB_DATA_SIZE) + (EECONFIG_USER_DATA_SIZE))
+#define EECONFIG_SIZE ((EECONFIG_BASE_SIZE) + (EECONFIG_KB_DATABLOCK_SIZE) + (EECONFIG_USER_DATABLOCK_SIZE))
+
+// Delay after the last change before the RAM copy of the core settings is committed to EEPROM
+#ifndef EECONFIG_FLUSH_DELAY
+#    define EECONFIG_FLUSH_DELAY 0
+#endif
 
 /* debug bit */
 #define EECONFIG_DEBUG_ENABLE (1 << 0)
@@ -89,6 +111,25 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 bool eeconfig_is_enabled(void);
 bool eeconfig_is_disabled(void);
 
+// Accessors for the core settings region. It is read from EEPROM once and served from RAM,
+// and changes are committed in batches by eeconfig_task() or eeconfig_flush(). Code writing
+// EECONFIG_* addresses directly must call eeconfig_reload() afterwards.
+// Addresses outside of the core region are passed straight through to EEPROM.
+uint8_t  eeconfig_read_byte(const uint8_t *addr);
+void     eeconfig_update_byte(uint8_t *addr, uint8_t value);
+uint16_t eeconfig_read_word(const uint16_t *addr);
+void     eeconfig_update_word(uint16_t *addr, uint16_t value);
+uint32_t eeconfig_read_dword(const uint32_t *addr);
+void     eeconfig_update_dword(uint32_t *addr, uint32_t value);
+void     eeconfig_read_block(void *data, const void *addr, size_t size);
+void     eeconfig_update_block(const void *data, void *addr, size_t size);
+void     eeconfig_flush(void);
+void     eeconfig_task(void);
+void     eeconfig_reload(void);
+
+// Converts settings written by older firmware to the current layout, if it knows how to
+void eeconfig_upgrade(void);
+
 void eeconfig_init(void);
 void eeconfig_init_quantum(void);
 void eeconfig_init_kb(void);
@@ -135,6 +176,9 @@ bool eeconfig_is_kb_datablock_valid(void);
 void eeconfig_read_kb_datablock(void *data);
 void eeconfig_update_kb_datablock(const void *data);
 void eeconfig_init_kb_datablock(void);
+// Called with the stored data when its version does not match EECONFIG_KB_DATA_VERSION.
+// Return true if `data` was converted to the current version, false to reset it.
+bool eeconfig_migrate_kb_datablock(uint32_t version, void *data);
 #endif // (EECONFIG_KB_DATA_SIZE) > 0
 
 #if (EECONFIG_USER_DATA_SIZE) > 0
@@ -142,6 +186,9 @@ bool eeconfig_is_user_datablock_valid(void);
 void eeconfig_read_user_datablock(void *data);
 void eeconfig_update_user_datablock(const void *data);
 void eeconfig_init_user_datablock(void);
+// Called with the stored data when its version does not match EECONFIG_USER_DATA_VERSION.
+// Return true if `data` was converted to the current version, false to reset it.
+bool eeconfig_migrate_user_datablock(uint32_t version, void *data);
 #endif // (EECONFIG_USER_DATA_SIZE) > 0
 
 // Any "checked" debounce variant used requires implementation of:
@@ -156,13 +203,13 @@ void eeconfig_init_user_datablock(void);
     static inline void eeconfig_init_##name(void) {                     \
         dirty_##name = true;                                            \
         if (eeconfig_check_valid_##name()) {                            \
-            eeprom_read_block(&config, offset, sizeof(config));         \
+            eeconfig_read_block(&config, offset, sizeof(config));       \
             dirty_##name = false;                                       \
         }                                                               \
     }                                                                   \
     static inline void eeconfig_flush_##name(bool force) {              \
         if (force || dirty_##name) {                                    \
-            eeprom_update_block(&config, offset, sizeof(config));       \
+            eeconfig_update_block(&config, offset, sizeof(config));     \
             eeconfig_post_flush_##name();                               \
             dirty_##name = false;                                       \
         }                                                               \
@@ -185,6 +185,8 @@ static bool encoder_update(uint8_t index, uint8_t state) {
     bool    changed = false;
     uint8_t i       = index;
 
+    keyboard_deferred_init_finish();
+
 #ifdef ENCODER_RESOLUTIONS
     const uint8_t resolution = encoder_resolutions[i];
 #else
@@ -264,6 +266,9 @@ void encoder_update_raw(uint8_t *slave_state) {
     for (uint8_t i = 0; i < thatCount; i++) { // Note inverted logic -- we want the opposite side
         const uint8_t index = i + thatHand;
         int8_t        delta = slave_state[i] - encoder_value[index];
+        if (delta) {
+            keyboard_deferred_init_finish();
+        }
         while (delta > 0) {
             delta--;
             encoder_value[index]++;
@@ -31,6 +31,12 @@ extern uint8_t split_haptic_play;
 
 haptic_config_t haptic_config;
 
+#ifdef DRV2605L
+// Effects requested since the last haptic_task(), played back to back as one sequence
+static uint8_t haptic_queue[DRV_SEQUENCE_LENGTH];
+static uint8_t haptic_queue_length = 0;
+#endif
+
 static void update_haptic_enable_gpios(void) {
     if (haptic_config.enable && ((!HAPTIC_OFF_IN_LOW_POWER) || (usb_device_state == USB_DEVICE_STATE_CONFIGURED))) {
 #if defined(HAPTIC_ENABLE_PIN)
@@ -95,6 +101,13 @@ void haptic_init(void) {
 }
 
 void haptic_task(void) {
+#ifdef DRV2605L
+    // Deferred from haptic_play(), so the I2C transfers happen after the keypress has been processed
+    if (haptic_queue_length) {
+        DRV_sequence(haptic_queue, haptic_queue_length);
+        haptic_queue_length = 0;
+    }
+#endif
 #ifdef SOLENOID_ENABLE
     solenoid_check();
 #endif
@@ -319,9 +332,9 @@ void haptic_cont_decrease(void) {
 
 void haptic_play(void) {
 #ifdef DRV2605L
-    uint8_t play_eff = 0;
-    play_eff         = haptic_config.mode;
-    DRV_pulse(play_eff);
+    if (haptic_queue_length < DRV_SEQUENCE_LENGTH) {
+        haptic_queue[haptic_queue_length++] = haptic_config.mode;
+    }
 #    if defined(SPLIT_KEYBOARD) && defined(SPLIT_HAPTIC_ENABLE)
     split_haptic_play = haptic_config.mode;
 #    endif
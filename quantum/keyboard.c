@@ -353,23 +353,149 @@ void quantum_init(void) {
 #ifdef BACKLIGHT_ENABLE
     backlight_init_ports();
 #endif
-#ifdef AUDIO_ENABLE
+#ifndef KEYBOARD_DEFERRED_INIT
+#    ifdef AUDIO_ENABLE
     audio_init();
-#endif
-#ifdef LED_MATRIX_ENABLE
+#    endif
+#    ifdef LED_MATRIX_ENABLE
     led_matrix_init();
-#endif
-#ifdef RGB_MATRIX_ENABLE
+#    endif
+#    ifdef RGB_MATRIX_ENABLE
     rgb_matrix_init();
+#    endif
 #endif
 #if defined(UNICODE_COMMON_ENABLE)
     unicode_input_mode_init();
 #endif
-#ifdef HAPTIC_ENABLE
+#if defined(HAPTIC_ENABLE) && !defined(KEYBOARD_DEFERRED_INIT)
     haptic_init();
 #endif
 }
 
+#ifdef KEYBOARD_DEFERRED_INIT
+#    ifdef OLED_ENABLE
+static void oled_deferred_init(void) {
+    oled_init(OLED_ROTATION_0);
+}
+#    endif
+#    ifdef ST7565_ENABLE
+static void st7565_deferred_init(void) {
+    st7565_init(DISPLAY_ROTATION_0);
+}
+#    endif
+
+typedef struct {
+    const char *name;
+    uint16_t    subsystem;
+    void (*init)(void);
+} deferred_init_task_t;
+
+/*
+    Subsystems that are not needed to send keystrokes. Rather than delaying the
+    first matrix scan, they are brought up one per main loop iteration once the
+    keyboard is already usable. Their tasks don't run until all of them are done.
+*/
+static const deferred_init_task_t deferred_init_tasks[] = {
+#    ifdef AUDIO_ENABLE
+    {"audio", DEFERRED_INIT_AUDIO, audio_init},
+#    endif
+#    ifdef LED_MATRIX_ENABLE
+    {"led_matrix", DEFERRED_INIT_LED_MATRIX, led_matrix_init},
+#    endif
+#    ifdef RGB_MATRIX_ENABLE
+    {"rgb_matrix", DEFERRED_INIT_RGB_MATRIX, rgb_matrix_init},
+#    endif
+#    ifdef HAPTIC_ENABLE
+    {"haptic", DEFERRED_INIT_HAPTIC, haptic_init},
+#    endif
+#    ifdef OLED_ENABLE
+    {"oled", DEFERRED_INIT_OLED, oled_deferred_init},
+#    endif
+#    ifdef ST7565_ENABLE
+    {"st7565", DEFERRED_INIT_ST7565, st7565_deferred_init},
+#    endif
+#    ifdef BACKLIGHT_ENABLE
+    {"backlight", DEFERRED_INIT_BACKLIGHT, backlight_init},
+#    endif
+#    ifdef RGBLIGHT_ENABLE
+    {"rgblight", DEFERRED_INIT_RGBLIGHT, rgblight_init},
+#    endif
+#    ifdef POINTING_DEVICE_ENABLE
+    {"pointing_device", DEFERRED_INIT_POINTING_DEVICE, pointing_device_init},
+#    endif
+};
+
+static uint16_t deferred_init_complete = 0;
+static bool     deferred_init_done     = false;
+
+static void deferred_init_run(const deferred_init_task_t *task) {
+    uint32_t start = timer_read32();
+    task->init();
+    deferred_init_complete |= task->subsystem;
+    dprintf("deferred init: %s took %lums\n", task->name, (unsigned long)timer_elapsed32(start));
+}
+
+/** \brief Runs the next pending deferred init task
+ *
+ * Once all tasks have run, keyboard_post_init_kb() is invoked, so that it still sees every subsystem initialised.
+ */
+static void deferred_init_task(void) {
+    for (uint8_t i = 0; i < ARRAY_SIZE(deferred_init_tasks); i++) {
+        if (!(deferred_init_complete & deferred_init_tasks[i].subsystem)) {
+            deferred_init_run(&deferred_init_tasks[i]);
+            return;
+        }
+    }
+
+    deferred_init_done = true;
+    dprintf("deferred init: complete at %lums\n", (unsigned long)timer_read32());
+    keyboard_post_init_kb(); /* Always keep this last */
+}
+
+#    define deferred_init_is_done() (deferred_init_done)
+#else
+#    define deferred_init_task()
+#    define deferred_init_is_done() (true)
+#endif
+
+/** \brief Initialises the given deferred subsystems straight away, if they are still pending
+ *
+ * Called before an event reaches a subsystem, so that only the subsystems an event actually uses have to be brought
+ * up ahead of their turn. The rest carry on one per main loop iteration.
+ */
+void keyboard_deferred_init_require(uint16_t subsystems) {
+#ifdef KEYBOARD_DEFERRED_INIT
+    for (uint8_t i = 0; i < ARRAY_SIZE(deferred_init_tasks) && (subsystems & ~deferred_init_complete); i++) {
+        if ((subsystems & ~deferred_init_complete) & deferred_init_tasks[i].subsystem) {
+            deferred_init_run(&deferred_init_tasks[i]);
+        }
+    }
+#endif
+}
+
+/** \brief Whether all of the given deferred subsystems have been initialised */
+bool keyboard_deferred_init_is_up(uint16_t subsystems) {
+#ifdef KEYBOARD_DEFERRED_INIT
+    uint16_t present = 0;
+    for (uint8_t i = 0; i < ARRAY_SIZE(deferred_init_tasks); i++) {
+        present |= deferred_init_tasks[i].subsystem;
+    }
+    return !(subsystems & present & ~deferred_init_complete);
+#else
+    return true;
+#endif
+}
+
+/** \brief Runs all pending deferred init tasks straight away
+ *
+ * For events that may touch any subsystem, such as VIA commands and suspend.
+ */
+void keyboard_deferred_init_finish(void) {
+    while (!deferred_init_is_done()) {
+        deferred_init_task();
+    }
+}
+
 /** \brief keyboard_init
  *
  * FIXME: needs doc
@@ -377,6 +503,9 @@ void quantum_init(void) {
 void keyboard_init(void) {
     timer_init();
     sync_timer_init();
+#ifdef DYNAMIC_KEYMAP_ENABLE
+    dynamic_keymap_init();
+#endif
 #ifdef VIA_ENABLE
     via_init();
 #endif
@@ -391,20 +520,24 @@ void keyboard_init(void) {
 #if defined(CRC_ENABLE)
     crc_init();
 #endif
-#ifdef OLED_ENABLE
+#ifndef KEYBOARD_DEFERRED_INIT
+#    ifdef OLED_ENABLE
     oled_init(OLED_ROTATION_0);
-#endif
-#ifdef ST7565_ENABLE
+#    endif
+#    ifdef ST7565_ENABLE
     st7565_init(DISPLAY_ROTATION_0);
+#    endif
 #endif
 #ifdef PS2_MOUSE_ENABLE
     ps2_mouse_init();
 #endif
-#ifdef BACKLIGHT_ENABLE
+#ifndef KEYBOARD_DEFERRED_INIT
+#    ifdef BACKLIGHT_ENABLE
     backlight_init();
-#endif
-#ifdef RGBLIGHT_ENABLE
+#    endif
+#    ifdef RGBLIGHT_ENABLE
     rgblight_init();
+#    endif
 #endif
 #ifdef STENO_ENABLE_ALL
     steno_init();
@@ -425,7 +558,7 @@ void keyboard_init(void) {
 #ifdef SPLIT_KEYBOARD
     split_post_init();
 #endif
-#ifdef POINTING_DEVICE_ENABLE
+#if defined(POINTING_DEVICE_ENABLE) && !defined(KEYBOARD_DEFERRED_INIT)
     // init after split init
     pointing_device_init();
 #endif
@@ -437,7 +570,9 @@ void keyboard_init(void) {
     debug_enable = true;
 #endif
 
+#ifndef KEYBOARD_DEFERRED_INIT
     keyboard_post_init_kb(); /* Always keep this last */
+#endif
 }
 
 /** \brief key_event_task
@@ -446,11 +581,16 @@ void keyboard_init(void) {
  * This is differnet than keycode events as no layer processing, or filtering occurs.
  */
 void switch_events(uint8_t row, uint8_t col, bool pressed) {
+    // Reactive effects just miss keys pressed before the matrix is up, rather than holding up the first key
 #if defined(LED_MATRIX_ENABLE)
-    process_led_matrix(row, col, pressed);
+    if (keyboard_deferred_init_is_up(DEFERRED_INIT_LED_MATRIX)) {
+        process_led_matrix(row, col, pressed);
+    }
 #endif
 #if defined(RGB_MATRIX_ENABLE)
-    process_rgb_matrix(row, col, pressed);
+    if (keyboard_deferred_init_is_up(DEFERRED_INIT_RGB_MATRIX)) {
+        process_rgb_matrix(row, col, pressed);
+    }
 #endif
 }
 
@@ -588,7 +728,9 @@ void quantum_task(void) {
 #endif
 
 #ifdef HAPTIC_ENABLE
-    haptic_task();
+    if (deferred_init_is_done()) {
+        haptic_task();
+    }
 #endif
 
 #ifdef DIP_SWITCH_ENABLE
@@ -606,6 +748,12 @@ void quantum_task(void) {
 #ifdef SECURE_ENABLE
     secure_task();
 #endif
+
+#ifdef DYNAMIC_KEYMAP_ENABLE
+    dynamic_keymap_task();
+#endif
+
+    eeconfig_task();
 }
 
 /** \brief Main task that is repeatedly called as fast as possible. */
@@ -622,22 +770,27 @@ void keyboard_task(void) {
     split_watchdog_task();
 #endif
 
+    if (!deferred_init_is_done()) {
+        // one subsystem per iteration, keeping the matrix responsive
+        deferred_init_task();
+    } else {
 #if defined(RGBLIGHT_ENABLE)
-    rgblight_task();
+        rgblight_task();
 #endif
 
 #ifdef LED_MATRIX_ENABLE
-    led_matrix_task();
+        led_matrix_task();
 #endif
 #ifdef RGB_MATRIX_ENABLE
-    rgb_matrix_task();
+        rgb_matrix_task();
 #endif
 
 #if defined(BACKLIGHT_ENABLE)
 #    if defined(BACKLIGHT_PIN) || defined(BACKLIGHT_PINS)
-    backlight_task();
+        backlight_task();
 #    endif
 #endif
+    }
 
 #ifdef ENCODER_ENABLE
     if (encoder_read()) {
@@ -647,7 +800,7 @@ void keyboard_task(void) {
 #endif
 
 #ifdef POINTING_DEVICE_ENABLE
-    if (pointing_device_task()) {
+    if (deferred_init_is_done() && pointing_device_task()) {
         last_pointing_device_activity_trigger();
         activity_has_occurred = true;
     }
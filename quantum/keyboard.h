@@ -96,6 +96,25 @@ void keyboard_setup(void);
 void keyboard_init(void);
 /* it runs repeatedly in main loop */
 void keyboard_task(void);
+/* subsystems whose init is deferred by KEYBOARD_DEFERRED_INIT */
+enum deferred_init_subsystem {
+    DEFERRED_INIT_AUDIO           = (1 << 0),
+    DEFERRED_INIT_LED_MATRIX      = (1 << 1),
+    DEFERRED_INIT_RGB_MATRIX      = (1 << 2),
+    DEFERRED_INIT_HAPTIC          = (1 << 3),
+    DEFERRED_INIT_OLED            = (1 << 4),
+    DEFERRED_INIT_ST7565          = (1 << 5),
+    DEFERRED_INIT_BACKLIGHT       = (1 << 6),
+    DEFERRED_INIT_RGBLIGHT        = (1 << 7),
+    DEFERRED_INIT_POINTING_DEVICE = (1 << 8),
+};
+#define DEFERRED_INIT_LIGHTING (DEFERRED_INIT_LED_MATRIX | DEFERRED_INIT_RGB_MATRIX | DEFERRED_INIT_BACKLIGHT | DEFERRED_INIT_RGBLIGHT)
+/* it initialises the given deferred subsystems now if still pending, before an event reaches them */
+void keyboard_deferred_init_require(uint16_t subsystems);
+/* it checks whether the given deferred subsystems have been initialised */
+bool keyboard_deferred_init_is_up(uint16_t subsystems);
+/* it finishes all subsystem init deferred by KEYBOARD_DEFERRED_INIT, before an event can reach any subsystem */
+void keyboard_deferred_init_finish(void);
 /* it runs whenever code has to behave differently on a slave */
 bool is_keyboard_master(void);
 /* it runs whenever code has to behave differently on left vs right split */
@@ -152,19 +152,58 @@ uint8_t led_matrix_map_row_column_to_led(uint8_t row, uint8_t column, uint8_t *l
     return led_count;
 }
 
+#ifdef LED_MATRIX_OUTPUT_STAGE
+// Brightness of each LED at 16-bit resolution, after the curve has been applied
+static uint16_t led_matrix_output[LED_MATRIX_LED_COUNT];
+// Fractional part left over from the previous flush, carried into the next one
+static uint8_t led_matrix_dither[LED_MATRIX_LED_COUNT];
+
+static void led_matrix_output_flush(void) {
+    for (uint8_t i = 0; i < LED_MATRIX_LED_COUNT; i++) {
+        uint32_t total       = (uint32_t)led_matrix_output[i] + led_matrix_dither[i];
+        led_matrix_dither[i] = total & 0xFF;
+        led_matrix_driver.set_value(i, MIN(total >> 8, 255));
+    }
+}
+#endif // LED_MATRIX_OUTPUT_STAGE
+
 void led_matrix_update_pwm_buffers(void) {
+#ifdef LED_MATRIX_OUTPUT_STAGE
+    led_matrix_output_flush();
+#endif
     led_matrix_driver.flush();
 }
 
 void led_matrix_set_value(int index, uint8_t value) {
-#ifdef USE_CIE1931_CURVE
+#ifdef LED_MATRIX_OUTPUT_STAGE
+#    ifdef USE_CIE1931_CURVE
+    led_matrix_set_value16(index, pgm_read_word(&CIE1931_CURVE_16[value]));
+#    else
+    // The flush reduces by dropping the low byte, so this keeps every 8-bit value a fixed point rather than dithered
+    led_matrix_set_value16(index, value << 8);
+#    endif
+#else
+#    ifdef USE_CIE1931_CURVE
     value = pgm_read_byte(&CIE1931_CURVE[value]);
-#endif
+#    endif
     led_matrix_driver.set_value(index, value);
+#endif
+}
+
+// Sets the PWM duty of an LED directly at 16-bit resolution, bypassing the curve. Without the output stage, the
+// value is rounded to the 8 bits the drivers take.
+void led_matrix_set_value16(int index, uint16_t value) {
+#ifdef LED_MATRIX_OUTPUT_STAGE
+    if (index >= 0 && index < LED_MATRIX_LED_COUNT) {
+        led_matrix_output[index] = value;
+    }
+#else
+    led_matrix_driver.set_value(index, MIN(((uint32_t)value + 128) >> 8, 255));
+#endif
 }
 
 void led_matrix_set_value_all(uint8_t value) {
-#if defined(LED_MATRIX_ENABLE) && defined(LED_MATRIX_SPLIT)
+#if (defined(LED_MATRIX_ENABLE) && defined(LED_MATRIX_SPLIT)) || defined(LED_MATRIX_OUTPUT_STAGE)
     for (uint8_t i = 0; i < LED_MATRIX_LED_COUNT; i++)
         led_matrix_set_value(i, value);
 #else
@@ -45,6 +45,11 @@
 #    define LED_MATRIX_LED_PROCESS_LIMIT (LED_MATRIX_LED_COUNT + 4) / 5
 #endif
 
+// Output stage between led_matrix_set_value() and the driver -- see "Output Stage" in the LED Matrix docs
+#ifdef LED_MATRIX_DITHERING
+#    define LED_MATRIX_OUTPUT_STAGE
+#endif
+
 #if defined(LED_MATRIX_LED_PROCESS_LIMIT) && LED_MATRIX_LED_PROCESS_LIMIT > 0 && LED_MATRIX_LED_PROCESS_LIMIT < LED_MATRIX_LED_COUNT
 #    if defined(LED_MATRIX_SPLIT)
 #        define LED_MATRIX_USE_LIMITS(min, max)                                                   \
@@ -112,6 +117,7 @@ uint8_t led_matrix_map_row_column_to_led(uint8_t row, uint8_t column, uint8_t *l
 
 void led_matrix_set_value(int index, uint8_t value);
 void led_matrix_set_value_all(uint8_t value);
+void led_matrix_set_value16(int index, uint16_t value);
 
 void process_led_matrix(uint8_t row, uint8_t col, bool pressed);
 
@@ -18,6 +18,14 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "progmem.h"
 #include <stdint.h>
 
+#if (defined(RGB_MATRIX_GAMMA_CORRECTION) || (defined(LED_MATRIX_DITHERING) && defined(USE_CIE1931_CURVE))) && !defined(USE_CIE1931_CURVE_16)
+#    define USE_CIE1931_CURVE_16
+#endif
+
 #ifdef USE_CIE1931_CURVE
 extern const uint8_t CIE1931_CURVE[] PROGMEM;
 #endif
+
+#ifdef USE_CIE1931_CURVE_16
+extern const uint16_t CIE1931_CURVE_16[] PROGMEM;
+#endif
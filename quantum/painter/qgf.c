@@ -60,7 +60,7 @@ bool qgf_parse_format(qp_image_format_t format, uint8_t *bpp, bool *has_palette)
     return true;
 }
 
-bool qgf_parse_frame_descriptor(qgf_frame_v1_t *frame_descriptor, uint8_t *bpp, bool *has_palette, bool *is_delta, painter_compression_t *compression_scheme, uint16_t *delay) {
+bool qgf_parse_frame_descriptor(qgf_frame_v1_t *frame_descriptor, uint8_t *bpp, bool *has_palette, bool *is_delta, bool *is_tiled, painter_compression_t *compression_scheme, uint16_t *delay) {
     // Decode the format
     qgf_parse_format(frame_descriptor->format, bpp, has_palette);
 
@@ -68,6 +68,9 @@ bool qgf_parse_frame_descriptor(qgf_frame_v1_t *frame_descriptor, uint8_t *bpp,
     if (is_delta) {
         *is_delta = (frame_descriptor->flags & QGF_FRAME_FLAG_DELTA) == QGF_FRAME_FLAG_DELTA;
     }
+    if (is_tiled) {
+        *is_tiled = (frame_descriptor->flags & QGF_FRAME_FLAG_TILED) == QGF_FRAME_FLAG_TILED;
+    }
     if (compression_scheme) {
         *compression_scheme = frame_descriptor->compression_scheme;
     }
@@ -173,7 +176,7 @@ void qgf_seek_to_frame_descriptor(qp_stream_t *stream, uint16_t frame_number) {
     qp_stream_setpos(stream, offset);
 }
 
-bool qgf_validate_frame_descriptor(qp_stream_t *stream, uint16_t frame_number, uint8_t *bpp, bool *has_palette, bool *is_delta) {
+bool qgf_validate_frame_descriptor(qp_stream_t *stream, uint16_t frame_number, uint8_t *bpp, bool *has_palette, bool *is_delta, bool *is_tiled) {
     // Seek to the correct location
     qgf_seek_to_frame_descriptor(stream, frame_number);
 
@@ -189,7 +192,7 @@ bool qgf_validate_frame_descriptor(qp_stream_t *stream, uint16_t frame_number, u
         return false;
     }
 
-    return qgf_parse_frame_descriptor(&frame_descriptor, bpp, has_palette, is_delta, NULL, NULL);
+    return qgf_parse_frame_descriptor(&frame_descriptor, bpp, has_palette, is_delta, is_tiled, NULL, NULL);
 }
 
 bool qgf_validate_palette_descriptor(qp_stream_t *stream, uint16_t frame_number, uint8_t bpp) {
@@ -227,6 +230,27 @@ bool qgf_validate_delta_descriptor(qp_stream_t *stream, uint16_t frame_number) {
     return true;
 }
 
+bool qgf_validate_tiles_descriptor(qp_stream_t *stream, uint16_t frame_number) {
+    // Read the tiles descriptor
+    qgf_tiles_v1_t tiles_descriptor;
+    if (qp_stream_read(&tiles_descriptor, sizeof(qgf_tiles_v1_t), 1, stream) != 1) {
+        qp_dprintf("Failed to read tiles_descriptor, expected length was not %d\n", (int)sizeof(qgf_tiles_v1_t));
+        return false;
+    }
+
+    // Make sure this block is valid
+    if (!qgf_validate_block_header(&tiles_descriptor.header, QGF_FRAME_TILES_DESCRIPTOR_TYPEID, (sizeof(qgf_tiles_v1_t) - sizeof(qgf_block_header_v1_t)))) {
+        return false;
+    }
+
+    if (tiles_descriptor.tile_size == 0) {
+        qp_dprintf("Failed to validate tiles_descriptor, tile size was zero\n");
+        return false;
+    }
+
+    return true;
+}
+
 bool qgf_validate_frame_data_descriptor(qp_stream_t *stream, uint16_t frame_number) {
     // Read and validate the data block
     qgf_data_v1_t data_descriptor;
@@ -254,7 +278,8 @@ bool qgf_validate_stream(qp_stream_t *stream) {
         uint8_t bpp;
         bool    has_palette;
         bool    has_delta;
-        if (!qgf_validate_frame_descriptor(stream, i, &bpp, &has_palette, &has_delta)) {
+        bool    has_tiles;
+        if (!qgf_validate_frame_descriptor(stream, i, &bpp, &has_palette, &has_delta, &has_tiles)) {
             return false;
         }
 
@@ -268,6 +293,11 @@ bool qgf_validate_stream(qp_stream_t *stream) {
             return false;
         }
 
+        // If we've got a tiles block, check it
+        if (has_tiles && !qgf_validate_tiles_descriptor(stream, i)) {
+            return false;
+        }
+
         // Check the data block
         if (!qgf_validate_frame_data_descriptor(stream, i)) {
             return false;
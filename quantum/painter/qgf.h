@@ -74,6 +74,7 @@ typedef struct QP_PACKED qgf_frame_v1_t {
 
 _Static_assert(sizeof(qgf_frame_v1_t) == (sizeof(qgf_block_header_v1_t) + 6), "qgf_frame_v1_t must be 11 bytes in v1 of QGF");
 
+#define QGF_FRAME_FLAG_TILED 0x04
 #define QGF_FRAME_FLAG_DELTA 0x02
 #define QGF_FRAME_FLAG_TRANSPARENT 0x01
 
@@ -112,6 +113,28 @@ typedef struct QP_PACKED qgf_delta_v1_t {
 
 _Static_assert(sizeof(qgf_delta_v1_t) == (sizeof(qgf_block_header_v1_t) + 8), "qgf_delta_v1_t must be 13 bytes in v1 of QGF");
 
+/////////////////////////////////////////
+// Frame tiles descriptor
+
+#define QGF_FRAME_TILES_DESCRIPTOR_TYPEID 0x06
+
+typedef struct QP_PACKED qgf_tiles_v1_t {
+    qgf_block_header_v1_t header;    // = { .type_id = 0x06, .neg_type_id = (~0x06), .length = 3 }
+    uint8_t               tile_size; // The width and height of each tile, in pixels
+    uint16_t              run_count; // The number of runs of changed tiles in the frame data
+} qgf_tiles_v1_t;
+
+_Static_assert(sizeof(qgf_tiles_v1_t) == (sizeof(qgf_block_header_v1_t) + 3), "qgf_tiles_v1_t must be 8 bytes in v1 of QGF");
+
+// Each run in the frame data of a tiled frame is prefixed by this header, and is followed by the pixel data of the run
+typedef struct QP_PACKED qgf_tile_run_v1_t {
+    uint8_t tile_x; // The column of the first tile in the run
+    uint8_t tile_y; // The row of the tiles in the run
+    uint8_t count;  // The number of horizontally-adjacent tiles in the run
+} qgf_tile_run_v1_t;
+
+_Static_assert(sizeof(qgf_tile_run_v1_t) == 3, "qgf_tile_run_v1_t must be 3 bytes in v1 of QGF");
+
 /////////////////////////////////////////
 // Frame data descriptor
 
@@ -133,4 +156,4 @@ bool     qgf_validate_block_header(qgf_block_header_v1_t *desc, uint8_t expected
 bool     qgf_read_graphics_descriptor(qp_stream_t *stream, uint16_t *image_width, uint16_t *image_height, uint16_t *frame_count, uint32_t *total_bytes);
 bool     qgf_parse_format(qp_image_format_t format, uint8_t *bpp, bool *has_palette);
 void     qgf_seek_to_frame_descriptor(qp_stream_t *stream, uint16_t frame_number);
-bool     qgf_parse_frame_descriptor(qgf_frame_v1_t *frame_descriptor, uint8_t *bpp, bool *has_palette, bool *is_delta, painter_compression_t *compression_scheme, uint16_t *delay);
+bool     qgf_parse_frame_descriptor(qgf_frame_v1_t *frame_descriptor, uint8_t *bpp, bool *has_palette, bool *is_delta, bool *is_tiled, painter_compression_t *compression_scheme, uint16_t *delay);
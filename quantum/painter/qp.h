@@ -56,6 +56,33 @@
 #    define QUANTUM_PAINTER_LOAD_FONTS_TO_RAM FALSE
 #endif
 
+#ifndef QUANTUM_PAINTER_FLASH_CACHE_SIZE
+/**
+ * @def This controls the size of the read-ahead cache used when loading images and fonts from external SPI flash.
+ *      Reads are performed a whole cache line at a time, rather than issuing a separate flash command for every byte.
+ *      Only used if the flash driver is enabled.
+ */
+#    define QUANTUM_PAINTER_FLASH_CACHE_SIZE 64
+#endif // QUANTUM_PAINTER_FLASH_CACHE_SIZE
+
+#ifndef QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES
+/**
+ * @def This controls the number of glyphs that Quantum Painter keeps in RAM, already converted to the display's native
+ *      pixel format. Glyphs found in the cache skip the font lookup and decode, and strings made up entirely of
+ *      cached glyphs are sent to the display in a single transfer. Least-recently-used glyphs are evicted first.
+ *      Each entry requires \ref QUANTUM_PAINTER_GLYPH_CACHE_ENTRY_SIZE bytes of RAM. Set to 0 to disable.
+ */
+#    define QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES 0
+#endif // QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES
+
+#ifndef QUANTUM_PAINTER_GLYPH_CACHE_ENTRY_SIZE
+/**
+ * @def This controls the number of bytes of native pixel data each glyph cache entry can hold. Glyphs larger than this
+ *      are never cached -- as an example, a 10x16 glyph on an RGB565 display requires 320 bytes.
+ */
+#    define QUANTUM_PAINTER_GLYPH_CACHE_ENTRY_SIZE 512
+#endif // QUANTUM_PAINTER_GLYPH_CACHE_ENTRY_SIZE
+
 #ifndef QUANTUM_PAINTER_CONCURRENT_ANIMATIONS
 /**
  * @def This controls the maximum number of animations that Quantum Painter can play simultaneously. Increasing this
@@ -64,6 +91,14 @@
 #    define QUANTUM_PAINTER_CONCURRENT_ANIMATIONS 4
 #endif // QUANTUM_PAINTER_CONCURRENT_ANIMATIONS
 
+#ifndef QUANTUM_PAINTER_POLYGON_MAX_POINTS
+/**
+ * @def This controls the maximum number of vertices a polygon drawn with \ref qp_polygon can have. Each vertex requires
+ *      around 12 bytes of stack while drawing.
+ */
+#    define QUANTUM_PAINTER_POLYGON_MAX_POINTS 16
+#endif // QUANTUM_PAINTER_POLYGON_MAX_POINTS
+
 #ifndef QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE
 /**
  * @def This controls the maximum size of the pixel data buffer used for single blocks of transmission. Larger buffers
@@ -72,6 +107,15 @@
 #    define QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE 1024
 #endif
 
+#ifndef QUANTUM_PAINTER_PIXDATA_DOUBLE_BUFFER
+/**
+ * @def This controls whether the pixel data buffer is doubled up, allowing the next block of pixel data to be decoded
+ *      while the previous one is still being transmitted. Doubles the RAM used by the pixel data buffer, and only has
+ *      an effect on SPI displays on ChibiOS, where transmission is performed using DMA.
+ */
+#    define QUANTUM_PAINTER_PIXDATA_DOUBLE_BUFFER FALSE
+#endif
+
 #ifndef QUANTUM_PAINTER_SUPPORTS_256_PALETTE
 /**
  * @def This controls whether 256-color palettes are supported. This has relatively hefty requirements on RAM -- at
@@ -80,6 +124,14 @@
 #    define QUANTUM_PAINTER_SUPPORTS_256_PALETTE FALSE
 #endif
 
+#ifndef QUANTUM_PAINTER_SUPPORTS_LZ
+/**
+ * @def This controls whether images compressed using the QMK LZ scheme can be drawn. LZ usually compresses better
+ *      than RLE, but requires an extra 256 bytes of RAM for the decompression window.
+ */
+#    define QUANTUM_PAINTER_SUPPORTS_LZ FALSE
+#endif
+
 #ifndef QUANTUM_PAINTER_SUPPORTS_NATIVE_COLORS
 /**
  * @def This controls whether the native color range is supported. This avoids the use of palettes but each image
@@ -103,6 +155,14 @@ typedef const void *painter_device_t;
  */
 typedef enum { QP_ROTATION_0, QP_ROTATION_90, QP_ROTATION_180, QP_ROTATION_270 } painter_rotation_t;
 
+/**
+ * @typedef A point on a device, used to describe the vertices of a polygon for \ref qp_polygon.
+ */
+typedef struct painter_point_t {
+    uint16_t x; ///< The x-position
+    uint16_t y; ///< The y-position
+} painter_point_t;
+
 /**
  * @typedef A descriptor for a Quantum Painter image.
  */
@@ -278,6 +338,41 @@ bool qp_circle(painter_device_t device, uint16_t x, uint16_t y, uint16_t radius,
  */
 bool qp_ellipse(painter_device_t device, uint16_t x, uint16_t y, uint16_t sizex, uint16_t sizey, uint8_t hue, uint8_t sat, uint8_t val, bool filled);
 
+/**
+ * Draws a rectangle with rounded corners using the specified color, optionally filled.
+ *
+ * @param device[in] the handle of the device to control
+ * @param left[in] the device's x-position to start
+ * @param top[in] the device's y-position to start
+ * @param right[in] the device's x-position to finish
+ * @param bottom[in] the device's y-position to finish
+ * @param radius[in] the radius of the corners, limited to half of the shortest side
+ * @param hue[in] the hue to use, with 0-360 mapped to 0-255
+ * @param sat[in] the saturation to use, with 0-100% mapped to 0-255
+ * @param val[in] the value to use, with 0-100% mapped to 0-255
+ * @param filled[in] whether the rectangle should be filled
+ * @return true if drawing the rectangle succeeded
+ * @return false if drawing the rectangle failed
+ */
+bool qp_rounded_rect(painter_device_t device, uint16_t left, uint16_t top, uint16_t right, uint16_t bottom, uint16_t radius, uint8_t hue, uint8_t sat, uint8_t val, bool filled);
+
+/**
+ * Draws a closed polygon using the specified color, optionally filled.
+ *
+ * @note Filled polygons use the even-odd rule, so self-intersecting polygons leave alternate regions unfilled.
+ *
+ * @param device[in] the handle of the device to control
+ * @param points[in] the vertices of the polygon, the last of which is joined back to the first
+ * @param num_points[in] the number of vertices, from 2 to \ref QUANTUM_PAINTER_POLYGON_MAX_POINTS
+ * @param hue[in] the hue to use, with 0-360 mapped to 0-255
+ * @param sat[in] the saturation to use, with 0-100% mapped to 0-255
+ * @param val[in] the value to use, with 0-100% mapped to 0-255
+ * @param filled[in] whether the polygon should be filled
+ * @return true if drawing the polygon succeeded
+ * @return false if drawing the polygon failed
+ */
+bool qp_polygon(painter_device_t device, const painter_point_t *points, uint8_t num_points, uint8_t hue, uint8_t sat, uint8_t val, bool filled);
+
 /**
  * Sets up the location on the display to stream raw pixel data to the display, using \ref qp_pixdata.
  *
@@ -318,6 +413,36 @@ bool qp_pixdata(painter_device_t device, const void *pixel_data, uint32_t native
  */
 painter_image_handle_t qp_load_image_mem(const void *buffer);
 
+#ifdef FLASH_ENABLE
+/**
+ * Loads an image stored in external SPI flash.
+ *
+ * @note Image data is streamed from flash as it's drawn, it is not copied into RAM. Images can be unloaded by calling
+ *       \ref qp_close_image.
+ *
+ * @param address[in] the address in external flash of the start of the image data
+ * @return an image handle usable with \ref qp_drawimage, \ref qp_drawimage_recolor, \ref qp_animate, and
+ *         \ref qp_animate_recolor.
+ * @return NULL if loading the image failed
+ */
+painter_image_handle_t qp_load_image_flash(uint32_t address);
+#endif // FLASH_ENABLE
+
+#ifdef QP_STREAM_HAS_FILE_IO
+/**
+ * Loads an image from a file, for host-side builds such as unit tests.
+ *
+ * @note Image data is streamed from the file as it's drawn. Images can be unloaded by calling \ref qp_close_image,
+ *       which also closes the file.
+ *
+ * @param filename[in] the path of the QGF file to load
+ * @return an image handle usable with \ref qp_drawimage, \ref qp_drawimage_recolor, \ref qp_animate, and
+ *         \ref qp_animate_recolor.
+ * @return NULL if loading the image failed
+ */
+painter_image_handle_t qp_load_image_file(const char *filename);
+#endif // QP_STREAM_HAS_FILE_IO
+
 /**
  * Closes an image handle when no longer in use.
  *
@@ -405,6 +530,49 @@ void qp_stop_animation(deferred_token anim_token);
  */
 painter_font_handle_t qp_load_font_mem(const void *buffer);
 
+#ifdef FLASH_ENABLE
+/**
+ * Loads a font stored in external SPI flash.
+ *
+ * @note Font data is streamed from flash as it's drawn, unless \ref QUANTUM_PAINTER_LOAD_FONTS_TO_RAM is set to TRUE.
+ *       Fonts can be unloaded by calling \ref qp_close_font.
+ *
+ * @param address[in] the address in external flash of the start of the font data
+ * @return an image handle usable with \ref qp_textwidth, \ref qp_drawtext, and \ref qp_drawtext_recolor.
+ * @return NULL if loading the font failed
+ */
+painter_font_handle_t qp_load_font_flash(uint32_t address);
+
+/**
+ * Finds the location of a named asset within a bundle stored in external SPI flash.
+ *
+ * @note Bundles can be created using `qmk painter-make-bundle`. Names are those of the input files without extension,
+ *       unless otherwise specified when the bundle was created.
+ *
+ * @param bundle_address[in] the address in external flash of the start of the bundle
+ * @param name[in] the name of the asset to find
+ * @param address[out] the address in external flash of the asset, usable with \ref qp_load_image_flash or
+ *                     \ref qp_load_font_flash
+ * @return true if the asset was found
+ * @return false if the bundle was invalid, or the asset was not found
+ */
+bool qp_flash_bundle_find(uint32_t bundle_address, const char *name, uint32_t *address);
+#endif // FLASH_ENABLE
+
+#ifdef QP_STREAM_HAS_FILE_IO
+/**
+ * Loads a font from a file, for host-side builds such as unit tests.
+ *
+ * @note Font data is streamed from the file as it's drawn, unless \ref QUANTUM_PAINTER_LOAD_FONTS_TO_RAM is set to
+ *       TRUE. Fonts can be unloaded by calling \ref qp_close_font, which also closes the file.
+ *
+ * @param filename[in] the path of the QFF file to load
+ * @return an image handle usable with \ref qp_textwidth, \ref qp_drawtext, and \ref qp_drawtext_recolor.
+ * @return NULL if loading the font failed
+ */
+painter_font_handle_t qp_load_font_file(const char *filename);
+#endif // QP_STREAM_HAS_FILE_IO
+
 /**
  * Closes a font handle when no longer in use.
  *
@@ -462,6 +630,24 @@ int16_t qp_drawtext_recolor(painter_device_t device, uint16_t x, uint16_t y, pai
 #    define RGB565_SURFACE_NUM_DEVICES 0
 #endif // QUANTUM_PAINTER_RGB565_SURFACE_ENABLE
 
+#ifdef QUANTUM_PAINTER_RGB888_SURFACE_ENABLE
+#    include "qp_rgb888_surface.h"
+#else // QUANTUM_PAINTER_RGB888_SURFACE_ENABLE
+#    define RGB888_SURFACE_NUM_DEVICES 0
+#endif // QUANTUM_PAINTER_RGB888_SURFACE_ENABLE
+
+#ifdef QUANTUM_PAINTER_MONO1BPP_SURFACE_ENABLE
+#    include "qp_mono1bpp_surface.h"
+#else // QUANTUM_PAINTER_MONO1BPP_SURFACE_ENABLE
+#    define MONO1BPP_SURFACE_NUM_DEVICES 0
+#endif // QUANTUM_PAINTER_MONO1BPP_SURFACE_ENABLE
+
+#ifdef QUANTUM_PAINTER_PALETTE_SURFACE_ENABLE
+#    include "qp_palette_surface.h"
+#else // QUANTUM_PAINTER_PALETTE_SURFACE_ENABLE
+#    define PALETTE_SURFACE_NUM_DEVICES 0
+#endif // QUANTUM_PAINTER_PALETTE_SURFACE_ENABLE
+
 #ifdef QUANTUM_PAINTER_ILI9163_ENABLE
 #    include "qp_ili9163.h"
 #else // QUANTUM_PAINTER_ILI9163_ENABLE
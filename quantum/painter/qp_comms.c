@@ -6,6 +6,9 @@
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Base comms APIs
 
+// The device whose comms session is currently open, so the bus can be lent out mid-operation
+static painter_device_t active_device = NULL;
+
 bool qp_comms_init(painter_device_t device) {
     painter_driver_t *driver = (painter_driver_t *)device;
     if (!driver->validate_ok) {
@@ -23,7 +26,12 @@ bool qp_comms_start(painter_device_t device) {
         return false;
     }
 
-    return driver->comms_vtable->comms_start(device);
+    if (!driver->comms_vtable->comms_start(device)) {
+        return false;
+    }
+
+    active_device = device;
+    return true;
 }
 
 void qp_comms_stop(painter_device_t device) {
@@ -34,6 +42,21 @@ void qp_comms_stop(painter_device_t device) {
     }
 
     driver->comms_vtable->comms_stop(device);
+    if (active_device == device) {
+        active_device = NULL;
+    }
+}
+
+painter_device_t qp_comms_suspend(void) {
+    painter_device_t device = active_device;
+    if (device) {
+        qp_comms_stop(device);
+    }
+    return device;
+}
+
+bool qp_comms_resume(painter_device_t device) {
+    return device ? qp_comms_start(device) : true;
 }
 
 uint32_t qp_comms_send(painter_device_t device, const void *data, uint32_t byte_count) {
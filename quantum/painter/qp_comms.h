@@ -16,6 +16,11 @@ bool     qp_comms_start(painter_device_t device);
 void     qp_comms_stop(painter_device_t device);
 uint32_t qp_comms_send(painter_device_t device, const void* data, uint32_t byte_count);
 
+// Temporarily closes the open comms session, if any, so another user of a shared bus (e.g. external SPI flash) can
+// access it. Returns the device to pass to qp_comms_resume() once done.
+painter_device_t qp_comms_suspend(void);
+bool             qp_comms_resume(painter_device_t device);
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Comms APIs that use a D/C pin
 
@@ -9,9 +9,24 @@
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Quantum Painter utility functions
 
+#if QUANTUM_PAINTER_PIXDATA_DOUBLE_BUFFER
+// Global variable used for native pixel data streaming, pointing at whichever of the two buffers is being filled.
+extern uint8_t *qp_internal_global_pixdata_buffer;
+
+// Returns true if the supplied data lives inside either of the pixdata buffers
+bool qp_internal_is_pixdata_buffer(const void *data);
+
+// Swaps the buffer being filled, after the current one has been handed off for transmission
+void qp_internal_swap_pixdata_buffer(void);
+#else
 // Global variable used for native pixel data streaming.
 extern uint8_t qp_internal_global_pixdata_buffer[QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE];
 
+#    define qp_internal_swap_pixdata_buffer() \
+        do {                                  \
+        } while (0)
+#endif
+
 // Check if the supplied bpp is capable of being rendered
 bool qp_internal_bpp_capable(uint8_t bits_per_pixel);
 
@@ -27,6 +42,44 @@ bool qp_internal_setpixel_impl(painter_device_t device, uint16_t x, uint16_t y);
 // qp_rect internal implementation, but uses the global pixdata buffer with pre-converted native pixels.
 bool qp_internal_fillrect_helper_impl(painter_device_t device, uint16_t l, uint16_t t, uint16_t r, uint16_t b);
 
+// Number of rectangles a span batch can hold open at any one time -- one per horizontal run expected on a single row.
+#define QP_SPAN_BATCH_SIZE 4
+
+// Collects horizontal spans of pixels, merging identical spans on consecutive rows into a single rectangle so that each
+// one only costs a single viewport write. Spans are clipped to the device, and are expected in increasing row order.
+typedef struct qp_span_batch_t {
+    painter_device_t device;
+    uint16_t         width;
+    uint16_t         height;
+    uint16_t         transfers; // number of viewport writes issued so far
+    uint8_t          count;
+    struct {
+        int16_t l, t, r, b;
+    } rects[QP_SPAN_BATCH_SIZE];
+} qp_span_batch_t;
+
+void qp_internal_span_batch_init(qp_span_batch_t* batch, painter_device_t device);
+bool qp_internal_span_batch_add(qp_span_batch_t* batch, int16_t left, int16_t right, int16_t y);
+bool qp_internal_span_batch_flush(qp_span_batch_t* batch);
+
+// Retrieves the inclusive horizontal extents of a shape on the supplied row. Returns false if the row is empty.
+typedef bool (*qp_internal_row_extents_callback)(int16_t y, int16_t* left, int16_t* right, void* cb_arg);
+
+// Scanline renderer for shapes with a single run of pixels per row, such as circles and rounded rectangles. Outlines are
+// derived from the extents of the neighbouring rows.
+bool qp_internal_draw_rows(qp_span_batch_t* batch, int16_t top, int16_t bottom, bool filled, qp_internal_row_extents_callback extents_callback, void* cb_arg);
+
+// Retrieves the inclusive horizontal run of pixels on row y belonging to the line from (x0,y0) to (x1,y1) -- as per
+// Bresenham's algorithm, one pixel per row for steep lines, one per column for shallow. Returns false if not on the row.
+bool qp_internal_line_row_run(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t y, int16_t* left, int16_t* right);
+
+// Half-width of the row at vertical distance dy from the centre of an ellipse with radii rx and ry.
+int16_t qp_internal_ellipse_halfwidth(uint16_t rx, uint16_t ry, uint16_t dy);
+
+// Shared implementation of qp_circle and qp_ellipse. Returns false on failure, and reports the number of transfers
+// issued through transfers.
+bool qp_internal_ellipse_impl(painter_device_t device, uint16_t x, uint16_t y, uint16_t sizex, uint16_t sizey, uint8_t hue, uint8_t sat, uint8_t val, bool filled, uint16_t* transfers);
+
 // Convert from input pixel data + palette to equivalent pixels
 typedef int16_t (*qp_internal_byte_input_callback)(void* cb_arg);
 typedef bool (*qp_internal_pixel_output_callback)(qp_pixel_t* palette, uint8_t index, void* cb_arg);
@@ -51,6 +104,9 @@ bool qp_internal_interpolate_palette(qp_pixel_t fg_hsv888, qp_pixel_t bg_hsv888,
 // Resets the global palette so that it can be regenerated. Only needed if the colors are identical, but a different display is used with a different internal pixel format.
 void qp_internal_invalidate_palette(void);
 
+// Invalidates the global palette if it was last converted for a different device. Call before qp_internal_interpolate_palette().
+void qp_internal_palette_device(painter_device_t device);
+
 // Helper shared between image and font rendering -- sets up the global palette to match the palette block specified in the asset. Expects the stream to be positioned at the start of the block header.
 bool qp_internal_load_qgf_palette(qp_stream_t* stream, uint8_t bpp);
 
@@ -73,6 +129,13 @@ typedef struct qp_internal_byte_input_state_t {
             enum qp_internal_rle_mode_t mode;
             uint8_t                     remain; // number of bytes remaining in the current mode
         } rle;
+        // LZ-specific -- shares the mode with RLE, where a repeating run is a copy from the window
+        struct {
+            enum qp_internal_rle_mode_t mode;
+            uint8_t                     remain;     // number of bytes remaining in the current mode
+            uint8_t                     distance;   // distance back into the window to copy from, minus one
+            uint8_t                     window_pos; // write position within the window
+        } lz;
     };
 } qp_internal_byte_input_state_t;
 
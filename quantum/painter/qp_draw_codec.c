@@ -56,6 +56,8 @@ bool qp_internal_decode_grayscale(painter_device_t device, uint32_t pixel_count,
 bool qp_internal_decode_recolor(painter_device_t device, uint32_t pixel_count, uint8_t bits_per_pixel, qp_internal_byte_input_callback input_callback, void* input_arg, qp_pixel_t fg_hsv888, qp_pixel_t bg_hsv888, qp_internal_pixel_output_callback output_callback, void* output_arg) {
     painter_driver_t* driver = (painter_driver_t*)device;
     int16_t           steps  = 1 << bits_per_pixel; // number of items we need to interpolate
+
+    qp_internal_palette_device(device);
     if (qp_internal_interpolate_palette(fg_hsv888, bg_hsv888, steps)) {
         if (!driver->driver_vtable->palette_convert(device, steps, qp_internal_global_pixel_lookup_table)) {
             return false;
@@ -125,6 +127,57 @@ static inline int16_t qp_drawimage_byte_rle_decoder(void* cb_arg) {
     return c;
 }
 
+#if QUANTUM_PAINTER_SUPPORTS_LZ
+// Previously-decoded bytes, available to be copied by later parts of the stream. Only one image is decoded at a time.
+static uint8_t qp_internal_lz_window[256];
+
+static inline int16_t qp_drawimage_byte_lz_decoder(void* cb_arg) {
+    qp_internal_byte_input_state_t* state = (qp_internal_byte_input_state_t*)cb_arg;
+
+    // Work out if we're parsing the initial marker byte
+    if (state->lz.mode == MARKER_BYTE) {
+        int16_t c = qp_stream_get(state->src_stream);
+        if (c < 0) {
+            return -1;
+        }
+        if (c >= 128) {
+            int16_t distance = qp_stream_get(state->src_stream);
+            if (distance < 0) {
+                return -1;
+            }
+            state->lz.mode     = REPEATING_RUN; // copy from the window
+            state->lz.remain   = (c & 0x7F) + 3;
+            state->lz.distance = distance;
+        } else {
+            state->lz.mode   = NON_REPEATING_RUN; // literal run
+            state->lz.remain = c + 1;
+        }
+    }
+
+    // Work out which byte we're returning
+    int16_t c;
+    if (state->lz.mode == REPEATING_RUN) {
+        c = qp_internal_lz_window[(uint8_t)(state->lz.window_pos - state->lz.distance - 1)];
+    } else {
+        c = qp_stream_get(state->src_stream);
+        if (c < 0) {
+            return -1;
+        }
+    }
+
+    // Remember it for later copies
+    qp_internal_lz_window[state->lz.window_pos++] = c;
+
+    // Swap back to querying the marker byte mode once this run is complete
+    if (--state->lz.remain == 0) {
+        state->lz.mode = MARKER_BYTE;
+    }
+
+    state->curr = c;
+    return c;
+}
+#endif // QUANTUM_PAINTER_SUPPORTS_LZ
+
 bool qp_internal_pixel_appender(qp_pixel_t* palette, uint8_t index, void* cb_arg) {
     qp_internal_pixel_output_state_t* state  = (qp_internal_pixel_output_state_t*)cb_arg;
     painter_driver_t*                 driver = (painter_driver_t*)state->device;
@@ -138,6 +191,8 @@ bool qp_internal_pixel_appender(qp_pixel_t* palette, uint8_t index, void* cb_arg
         if (!driver->driver_vtable->pixdata(state->device, qp_internal_global_pixdata_buffer, state->pixel_write_pos)) {
             return false;
         }
+        // Decode the next block into the other buffer while this one is in flight
+        qp_internal_swap_pixdata_buffer();
         state->pixel_write_pos = 0;
     }
 
@@ -158,6 +213,7 @@ bool qp_internal_byte_appender(uint8_t byteval, void* cb_arg) {
         if (!driver->driver_vtable->pixdata(state->device, qp_internal_global_pixdata_buffer, state->byte_write_pos * 8 / driver->native_bits_per_pixel)) {
             return false;
         }
+        qp_internal_swap_pixdata_buffer();
         state->byte_write_pos = 0;
     }
 
@@ -172,6 +228,13 @@ qp_internal_byte_input_callback qp_internal_prepare_input_state(qp_internal_byte
             input_state->rle.mode   = MARKER_BYTE;
             input_state->rle.remain = 0;
             return qp_drawimage_byte_rle_decoder;
+#if QUANTUM_PAINTER_SUPPORTS_LZ
+        case IMAGE_COMPRESSED_LZ:
+            input_state->lz.mode       = MARKER_BYTE;
+            input_state->lz.remain     = 0;
+            input_state->lz.window_pos = 0;
+            return qp_drawimage_byte_lz_decoder;
+#endif // QUANTUM_PAINTER_SUPPORTS_LZ
         default:
             return NULL;
     }
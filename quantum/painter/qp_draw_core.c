@@ -19,8 +19,14 @@ _Static_assert((QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE > 0) && (QUANTUM_PAINTER_PIX
 //       **** very likely get artifacts rendered to the screen as a result.                                       ****
 //
 
+#if QUANTUM_PAINTER_PIXDATA_DOUBLE_BUFFER
+// Buffers used for transmitting native pixel data to the downstream device -- one is filled while the other is sent.
+__attribute__((__aligned__(4))) static uint8_t qp_internal_pixdata_buffers[2][QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE];
+uint8_t *                                      qp_internal_global_pixdata_buffer = qp_internal_pixdata_buffers[0];
+#else
 // Buffer used for transmitting native pixel data to the downstream device.
 __attribute__((__aligned__(4))) uint8_t qp_internal_global_pixdata_buffer[QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE];
+#endif
 
 // Static buffer to contain a generated color palette
 static bool                                       generated_palette = false;
@@ -47,6 +53,17 @@ bool qp_internal_setpixel_impl(painter_device_t device, uint16_t x, uint16_t y)
     return driver->driver_vtable->viewport(device, x, y, x, y) && driver->driver_vtable->pixdata(device, qp_internal_global_pixdata_buffer, 1);
 }
 
+#if QUANTUM_PAINTER_PIXDATA_DOUBLE_BUFFER
+bool qp_internal_is_pixdata_buffer(const void *data) {
+    const uint8_t *p = (const uint8_t *)data;
+    return p >= &qp_internal_pixdata_buffers[0][0] && p < &qp_internal_pixdata_buffers[1][QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE];
+}
+
+void qp_internal_swap_pixdata_buffer(void) {
+    qp_internal_global_pixdata_buffer = (qp_internal_global_pixdata_buffer == qp_internal_pixdata_buffers[0]) ? qp_internal_pixdata_buffers[1] : qp_internal_pixdata_buffers[0];
+}
+#endif
+
 // Fills the global native pixel buffer with equivalent pixels matching the supplied HSV
 void qp_internal_fill_pixdata(painter_device_t device, uint32_t num_pixels, uint8_t hue, uint8_t sat, uint8_t val) {
     painter_driver_t *driver            = (painter_driver_t *)device;
@@ -70,6 +87,17 @@ void qp_internal_invalidate_palette(void) {
     generated_steps   = -1;
 }
 
+// The device the global palette was last converted for
+static painter_device_t palette_device = NULL;
+
+void qp_internal_palette_device(painter_device_t device) {
+    // The cached palette is in the previous device's native format, which may not match this one
+    if (device != palette_device) {
+        qp_internal_invalidate_palette();
+        palette_device = device;
+    }
+}
+
 // Interpolates between two colors to generate a palette
 bool qp_internal_interpolate_palette(qp_pixel_t fg_hsv888, qp_pixel_t bg_hsv888, int16_t steps) {
     // Check if we need to generate a new palette -- if the input parameters match then assume the palette can stay unchanged.
@@ -140,6 +168,158 @@ bool qp_internal_load_qgf_palette(qp_stream_t *stream, uint8_t bpp) {
     return true;
 }
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Scanline helpers
+
+void qp_internal_span_batch_init(qp_span_batch_t *batch, painter_device_t device) {
+    batch->device    = device;
+    batch->transfers = 0;
+    batch->count     = 0;
+    qp_get_geometry(device, &batch->width, &batch->height, NULL, NULL, NULL);
+}
+
+static bool qp_internal_span_batch_emit(qp_span_batch_t *batch, uint8_t index) {
+    bool ret = qp_internal_fillrect_helper_impl(batch->device, batch->rects[index].l, batch->rects[index].t, batch->rects[index].r, batch->rects[index].b);
+    batch->transfers++;
+
+    // Remove the rectangle, preserving the order of the remaining ones
+    batch->count--;
+    for (uint8_t i = index; i < batch->count; ++i) {
+        batch->rects[i] = batch->rects[i + 1];
+    }
+    return ret;
+}
+
+bool qp_internal_span_batch_add(qp_span_batch_t *batch, int16_t left, int16_t right, int16_t y) {
+    // Clip to the device
+    left  = QP_MAX(left, 0);
+    right = QP_MIN(right, ((int16_t)batch->width) - 1);
+    if (left > right || y < 0 || y >= batch->height) {
+        return true;
+    }
+
+    // Extend any open rectangle with the same extents finishing on the previous row
+    for (uint8_t i = 0; i < batch->count; ++i) {
+        if (batch->rects[i].l == left && batch->rects[i].r == right && batch->rects[i].b == y - 1) {
+            batch->rects[i].b = y;
+            return true;
+        }
+    }
+
+    // Send any rectangles that can no longer be extended, then the oldest if there's still no space
+    for (uint8_t i = 0; i < batch->count;) {
+        if (batch->rects[i].b < y - 1) {
+            if (!qp_internal_span_batch_emit(batch, i)) {
+                return false;
+            }
+        } else {
+            ++i;
+        }
+    }
+    if (batch->count == QP_SPAN_BATCH_SIZE && !qp_internal_span_batch_emit(batch, 0)) {
+        return false;
+    }
+
+    batch->rects[batch->count].l = left;
+    batch->rects[batch->count].r = right;
+    batch->rects[batch->count].t = y;
+    batch->rects[batch->count].b = y;
+    batch->count++;
+    return true;
+}
+
+bool qp_internal_span_batch_flush(qp_span_batch_t *batch) {
+    while (batch->count > 0) {
+        if (!qp_internal_span_batch_emit(batch, 0)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool qp_internal_draw_rows(qp_span_batch_t *batch, int16_t top, int16_t bottom, bool filled, qp_internal_row_extents_callback extents_callback, void *cb_arg) {
+    // Sliding window of the extents of the previous, current, and next rows
+    int16_t l[3], r[3];
+    bool    valid[3];
+    valid[0] = false;
+    valid[1] = extents_callback(top, &l[1], &r[1], cb_arg);
+
+    for (int16_t y = top; y <= bottom; ++y) {
+        valid[2] = (y < bottom) && extents_callback(y + 1, &l[2], &r[2], cb_arg);
+
+        if (valid[1]) {
+            // Interior pixels are those covered by both neighbouring rows, excluding the ends of this row
+            int16_t inner_l = QP_MAX(QP_MAX(l[0], l[2]), l[1] + 1);
+            int16_t inner_r = QP_MIN(QP_MIN(r[0], r[2]), r[1] - 1);
+            if (filled || !valid[0] || !valid[2] || inner_l > inner_r) {
+                if (!qp_internal_span_batch_add(batch, l[1], r[1], y)) {
+                    return false;
+                }
+            } else {
+                if (!qp_internal_span_batch_add(batch, l[1], inner_l - 1, y) || !qp_internal_span_batch_add(batch, inner_r + 1, r[1], y)) {
+                    return false;
+                }
+            }
+        }
+
+        // Shift the window
+        for (int i = 0; i < 2; ++i) {
+            l[i]     = l[i + 1];
+            r[i]     = r[i + 1];
+            valid[i] = valid[i + 1];
+        }
+    }
+
+    return qp_internal_span_batch_flush(batch);
+}
+
+// Integer division rounding towards positive infinity, for a positive divisor
+static inline int32_t qp_internal_div_ceil(int32_t num, int32_t den) {
+    return num >= 0 ? (num + den - 1) / den : num / den;
+}
+
+bool qp_internal_line_row_run(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t y, int16_t *left, int16_t *right) {
+    // Always walk the line downwards
+    if (y0 > y1) {
+        int16_t t;
+        t  = x0;
+        x0 = x1;
+        x1 = t;
+        t  = y0;
+        y0 = y1;
+        y1 = t;
+    }
+    if (y < y0 || y > y1) {
+        return false;
+    }
+
+    int32_t dx = abs(x1 - x0);
+    int32_t dy = y1 - y0;
+    int32_t k  = y - y0;
+    int32_t u_lo, u_hi;
+    if (dy == 0) {
+        // Horizontal, the whole line is on this row
+        u_lo = 0;
+        u_hi = dx;
+    } else if (dy >= dx) {
+        // Steep, a single pixel on each row at the rounded position of the line
+        u_lo = u_hi = (2 * k * dx + dy) / (2 * dy);
+    } else {
+        // Shallow, every column whose rounded row position is this row
+        u_lo = QP_MAX(qp_internal_div_ceil((2 * k - 1) * dx, 2 * dy), 0);
+        u_hi = QP_MIN(qp_internal_div_ceil((2 * k + 1) * dx, 2 * dy) - 1, dx);
+    }
+
+    if (x1 >= x0) {
+        *left  = x0 + u_lo;
+        *right = x0 + u_hi;
+    } else {
+        *left  = x0 - u_hi;
+        *right = x0 - u_lo;
+    }
+    return true;
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Quantum Painter External API: qp_setpixel
 
@@ -185,42 +365,26 @@ bool qp_line(painter_device_t device, uint16_t x0, uint16_t y0, uint16_t x1, uin
         return false;
     }
 
-    qp_internal_fill_pixdata(device, 1, hue, sat, val);
-
-    // draw angled line using Bresenham's algo
-    int16_t x      = ((int16_t)x0);
-    int16_t y      = ((int16_t)y0);
-    int16_t slopex = ((int16_t)x0) < ((int16_t)x1) ? 1 : -1;
-    int16_t slopey = ((int16_t)y0) < ((int16_t)y1) ? 1 : -1;
-    int16_t dx     = abs(((int16_t)x1) - ((int16_t)x0));
-    int16_t dy     = -abs(((int16_t)y1) - ((int16_t)y0));
+    // Each run is at most the length of the line
+    qp_internal_fill_pixdata(device, QP_MAX(abs(((int16_t)x1) - ((int16_t)x0)), abs(((int16_t)y1) - ((int16_t)y0))) + 1, hue, sat, val);
 
-    int16_t e  = dx + dy;
-    int16_t e2 = 2 * e;
+    // Walk the rows of the line, so that each horizontal run (or vertical run, once merged) is a single transfer
+    qp_span_batch_t batch;
+    qp_internal_span_batch_init(&batch, device);
 
     bool ret = true;
-    while (x != x1 || y != y1) {
-        if (!qp_internal_setpixel_impl(device, x, y)) {
-            ret = false;
-            break;
-        }
-        e2 = 2 * e;
-        if (e2 >= dy) {
-            e += dy;
-            x += slopex;
-        }
-        if (e2 <= dx) {
-            e += dx;
-            y += slopey;
+    for (int16_t y = QP_MIN((int16_t)y0, (int16_t)y1); ret && y <= QP_MAX((int16_t)y0, (int16_t)y1); ++y) {
+        int16_t l, r;
+        if (qp_internal_line_row_run(x0, y0, x1, y1, y, &l, &r)) {
+            ret = qp_internal_span_batch_add(&batch, l, r, y);
         }
     }
-    // draw the last pixel
-    if (!qp_internal_setpixel_impl(device, x, y)) {
+    if (!qp_internal_span_batch_flush(&batch)) {
         ret = false;
     }
 
     qp_comms_stop(device);
-    qp_dprintf("qp_line(%d, %d, %d, %d): %s\n", (int)x0, (int)y0, (int)x1, (int)y1, ret ? "ok" : "fail");
+    qp_dprintf("qp_line(%d, %d, %d, %d): %s (%d transfers)\n", (int)x0, (int)y0, (int)x1, (int)y1, ret ? "ok" : "fail", (int)batch.transfers);
     return ret;
 }
 
@@ -235,6 +399,16 @@ bool qp_internal_fillrect_helper_impl(painter_device_t device, uint16_t left, ui
     uint16_t r = QP_MAX(left, right);
     uint16_t t = QP_MIN(top, bottom);
     uint16_t b = QP_MAX(top, bottom);
+
+    // Clip to the device, anything entirely off-screen has nothing to draw
+    uint16_t width, height;
+    qp_get_geometry(device, &width, &height, NULL, NULL, NULL);
+    if (l >= width || t >= height) {
+        return true;
+    }
+    r = QP_MIN(r, width - 1);
+    b = QP_MIN(b, height - 1);
+
     uint16_t w = r - l + 1;
     uint16_t h = b - t + 1;
 
@@ -292,3 +466,63 @@ bool qp_rect(painter_device_t device, uint16_t left, uint16_t top, uint16_t righ
     qp_dprintf("qp_rect(%d, %d, %d, %d): %s\n", (int)l, (int)t, (int)r, (int)b, ret ? "ok" : "fail");
     return ret;
 }
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Quantum Painter External API: qp_rounded_rect
+
+typedef struct qp_rounded_rect_extents_t {
+    int16_t  l, t, r, b;
+    uint16_t radius;
+} qp_rounded_rect_extents_t;
+
+static bool qp_rounded_rect_extents(int16_t y, int16_t *left, int16_t *right, void *cb_arg) {
+    qp_rounded_rect_extents_t *rr = (qp_rounded_rect_extents_t *)cb_arg;
+    if (y < rr->t || y > rr->b) {
+        return false;
+    }
+
+    // Rows within the corners are inset by the corresponding quarter-circle
+    int16_t dy    = QP_MAX((rr->t + rr->radius) - y, y - (rr->b - rr->radius));
+    int16_t inset = (dy > 0) ? rr->radius - qp_internal_ellipse_halfwidth(rr->radius, rr->radius, dy) : 0;
+    *left         = rr->l + inset;
+    *right        = rr->r - inset;
+    return true;
+}
+
+bool qp_rounded_rect(painter_device_t device, uint16_t left, uint16_t top, uint16_t right, uint16_t bottom, uint16_t radius, uint8_t hue, uint8_t sat, uint8_t val, bool filled) {
+    qp_dprintf("qp_rounded_rect(%d, %d, %d, %d, %d): entry\n", (int)left, (int)top, (int)right, (int)bottom, (int)radius);
+    painter_driver_t *driver = (painter_driver_t *)device;
+    if (!driver->validate_ok) {
+        qp_dprintf("qp_rounded_rect: fail (validation_ok == false)\n");
+        return false;
+    }
+
+    // Cater for cases where people have submitted the coordinates backwards
+    qp_rounded_rect_extents_t rr = {
+        .l = QP_MIN(left, right),
+        .r = QP_MAX(left, right),
+        .t = QP_MIN(top, bottom),
+        .b = QP_MAX(top, bottom),
+    };
+
+    // The corners can't be any larger than half the shortest side
+    rr.radius = QP_MIN(radius, QP_MIN(rr.r - rr.l, rr.b - rr.t) / 2);
+
+    if (!qp_comms_start(device)) {
+        qp_dprintf("Failed to start comms in qp_rounded_rect\n");
+        return false;
+    }
+
+    // Identical rows are merged into a single transfer, so allow for the whole area even when only drawing an outline
+    uint32_t w = rr.r - rr.l + 1;
+    uint32_t h = rr.b - rr.t + 1;
+    qp_internal_fill_pixdata(device, w * h, hue, sat, val);
+
+    qp_span_batch_t batch;
+    qp_internal_span_batch_init(&batch, device);
+    bool ret = qp_internal_draw_rows(&batch, rr.t, rr.b, filled, qp_rounded_rect_extents, &rr);
+
+    qp_comms_stop(device);
+    qp_dprintf("qp_rounded_rect: %s (%d transfers)\n", ret ? "ok" : "fail", (int)batch.transfers);
+    return ret;
+}
@@ -6,54 +6,84 @@
 #include "qp_comms.h"
 #include "qp_draw.h"
 
-// Utilize 4-way symmetry to draw an ellipse
-static bool qp_ellipse_helper_impl(painter_device_t device, uint16_t centerx, uint16_t centery, uint16_t offsetx, uint16_t offsety, bool filled) {
+// Integer square root, rounded down
+static uint32_t qp_isqrt(uint64_t value) {
+    uint64_t result = 0;
+    uint64_t bit    = 1ull << 62;
+    while (bit > value) {
+        bit >>= 2;
+    }
+    while (bit != 0) {
+        if (value >= result + bit) {
+            value -= result + bit;
+            result = (result >> 1) + bit;
+        } else {
+            result >>= 1;
+        }
+        bit >>= 2;
+    }
+    return (uint32_t)result;
+}
+
+int16_t qp_internal_ellipse_halfwidth(uint16_t rx, uint16_t ry, uint16_t dy) {
     /*
-    Ellipses have the property of 4-way symmetry, so four pixels can be drawn
-    for each computed [offsetx,offsety] given the center coordinates
-    represented by [centerx,centery].
+    A pixel on the row at distance dy from the centre is inside the ellipse if
+    (x/rx)^2 + (dy/ry)^2 <= 1 + 1/ry, the extra 1/ry allowing for the row's
+    height so that the top and bottom rows aren't reduced to a single pixel.
+    For circles this is the same x^2 + y^2 <= r^2 + r criterion used by the
+    midpoint algorithm.
+    */
+    if (ry == 0) {
+        return rx;
+    }
+    if (dy > ry) {
+        return -1;
+    }
+    if (rx == ry) {
+        // Circles can stay within 32 bits
+        uint32_t r = rx;
+        return qp_isqrt(r * r - ((uint32_t)dy) * dy + r);
+    }
+    uint64_t rx2 = ((uint64_t)rx) * rx;
+    uint64_t ry2 = ((uint64_t)ry) * ry;
+    return qp_isqrt(rx2 * (ry2 - ((uint64_t)dy) * dy + ry) / ry2);
+}
 
-    For filled ellipses, we can draw horizontal lines between each pair of
-    pixels with the same final value of y.
+typedef struct qp_ellipse_extents_t {
+    int16_t  x, y;
+    uint16_t sizex, sizey;
+} qp_ellipse_extents_t;
 
-    When offsetx == 0 only two pixels can be drawn for filled or unfilled ellipses
-    */
+static bool qp_ellipse_extents(int16_t y, int16_t *left, int16_t *right, void *cb_arg) {
+    qp_ellipse_extents_t *e  = (qp_ellipse_extents_t *)cb_arg;
+    int16_t               dy = abs(y - e->y);
+    if (dy > e->sizey) {
+        return false;
+    }
+    int16_t halfwidth = qp_internal_ellipse_halfwidth(e->sizex, e->sizey, dy);
+    *left             = e->x - halfwidth;
+    *right            = e->x + halfwidth;
+    return true;
+}
 
-    int16_t xpx = ((int16_t)centerx) + ((int16_t)offsetx);
-    int16_t xmx = ((int16_t)centerx) - ((int16_t)offsetx);
-    int16_t ypy = ((int16_t)centery) + ((int16_t)offsety);
-    int16_t ymy = ((int16_t)centery) - ((int16_t)offsety);
+// Shared between qp_circle and qp_ellipse -- draws each row of the ellipse, merging identical rows into a single transfer
+bool qp_internal_ellipse_impl(painter_device_t device, uint16_t x, uint16_t y, uint16_t sizex, uint16_t sizey, uint8_t hue, uint8_t sat, uint8_t val, bool filled, uint16_t *transfers) {
+    qp_ellipse_extents_t e = {.x = x, .y = y, .sizex = sizex, .sizey = sizey};
 
-    if (offsetx == 0) {
-        if (!qp_internal_setpixel_impl(device, xpx, ypy)) {
-            return false;
-        }
-        if (!qp_internal_setpixel_impl(device, xpx, ymy)) {
-            return false;
-        }
-    } else if (filled) {
-        if (!qp_internal_fillrect_helper_impl(device, xpx, ypy, xmx, ypy)) {
-            return false;
-        }
-        if (offsety > 0 && !qp_internal_fillrect_helper_impl(device, xpx, ymy, xmx, ymy)) {
-            return false;
-        }
-    } else {
-        if (!qp_internal_setpixel_impl(device, xpx, ypy)) {
-            return false;
-        }
-        if (!qp_internal_setpixel_impl(device, xpx, ymy)) {
-            return false;
-        }
-        if (!qp_internal_setpixel_impl(device, xmx, ypy)) {
-            return false;
-        }
-        if (!qp_internal_setpixel_impl(device, xmx, ymy)) {
-            return false;
-        }
+    // Identical rows are merged into a single transfer, so allow for the whole area even when only drawing an outline
+    qp_internal_fill_pixdata(device, ((uint32_t)sizex * 2 + 1) * ((uint32_t)sizey * 2 + 1), hue, sat, val);
+
+    if (!qp_comms_start(device)) {
+        return false;
     }
 
-    return true;
+    qp_span_batch_t batch;
+    qp_internal_span_batch_init(&batch, device);
+    bool ret = qp_internal_draw_rows(&batch, e.y - (int16_t)sizey, e.y + (int16_t)sizey, filled, qp_ellipse_extents, &e);
+
+    qp_comms_stop(device);
+    *transfers = batch.transfers;
+    return ret;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -67,50 +97,8 @@ bool qp_ellipse(painter_device_t device, uint16_t x, uint16_t y, uint16_t sizex,
         return false;
     }
 
-    int16_t aa = ((int16_t)sizex) * ((int16_t)sizex);
-    int16_t bb = ((int16_t)sizey) * ((int16_t)sizey);
-    int16_t fa = 4 * ((int16_t)aa);
-    int16_t fb = 4 * ((int16_t)bb);
-
-    int16_t dx = 0;
-    int16_t dy = ((int16_t)sizey);
-
-    qp_internal_fill_pixdata(device, QP_MAX(sizex, sizey), hue, sat, val);
-
-    if (!qp_comms_start(device)) {
-        qp_dprintf("qp_ellipse: fail (could not start comms)\n");
-        return false;
-    }
-
-    bool ret = true;
-    for (int16_t delta = (2 * bb) + (aa * (1 - (2 * sizey))); bb * dx <= aa * dy; dx++) {
-        if (!qp_ellipse_helper_impl(device, x, y, dx, dy, filled)) {
-            ret = false;
-            break;
-        }
-        if (delta >= 0) {
-            delta += fa * (1 - dy);
-            dy--;
-        }
-        delta += bb * (4 * dx + 6);
-    }
-
-    dx = sizex;
-    dy = 0;
-
-    for (int16_t delta = (2 * aa) + (bb * (1 - (2 * sizex))); aa * dy <= bb * dx; dy++) {
-        if (!qp_ellipse_helper_impl(device, x, y, dx, dy, filled)) {
-            ret = false;
-            break;
-        }
-        if (delta >= 0) {
-            delta += fb * (1 - dx);
-            dx--;
-        }
-        delta += aa * (4 * dy + 6);
-    }
-
-    qp_dprintf("qp_ellipse: %s\n", ret ? "ok" : "fail");
-    qp_comms_stop(device);
+    uint16_t transfers = 0;
+    bool     ret       = qp_internal_ellipse_impl(device, x, y, sizex, sizey, hue, sat, val, filled, &transfers);
+    qp_dprintf("qp_ellipse: %s (%d transfers)\n", ret ? "ok" : "fail", (int)transfers);
     return ret;
 }
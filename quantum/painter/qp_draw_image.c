@@ -16,6 +16,9 @@ typedef struct qgf_image_handle_t {
     union {
         qp_stream_t        stream;
         qp_memory_stream_t mem_stream;
+#ifdef FLASH_ENABLE
+        qp_flash_stream_t flash_stream;
+#endif // FLASH_ENABLE
 #ifdef QP_STREAM_HAS_FILE_IO
         qp_file_stream_t file_stream;
 #endif // QP_STREAM_HAS_FILE_IO
@@ -53,6 +56,7 @@ static painter_image_handle_t qp_load_image_internal(bool (*stream_factory)(qgf_
     // Now that we know the length, validate the input data
     if (!qgf_validate_stream(&image->stream)) {
         qp_dprintf("qp_load_image: fail (failed validation)\n");
+        qp_stream_close(&image->stream);
         return NULL;
     }
 
@@ -85,6 +89,48 @@ painter_image_handle_t qp_load_image_mem(const void *buffer) {
     return qp_load_image_internal(image_mem_stream_factory, (void *)buffer);
 }
 
+#ifdef FLASH_ENABLE
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Quantum Painter External API: qp_load_image_flash
+
+static inline bool image_flash_stream_factory(qgf_image_handle_t *image, void *arg) {
+    uint32_t address = *(uint32_t *)arg;
+
+    // Assume we can read the graphics descriptor
+    image->flash_stream = qp_make_flash_stream(address, sizeof(qgf_graphics_descriptor_v1_t));
+
+    // Update the length of the stream to match, and rewind to the start
+    image->flash_stream.length   = qgf_get_total_size(&image->stream);
+    image->flash_stream.position = 0;
+
+    return true;
+}
+
+painter_image_handle_t qp_load_image_flash(uint32_t address) {
+    return qp_load_image_internal(image_flash_stream_factory, &address);
+}
+#endif // FLASH_ENABLE
+
+#ifdef QP_STREAM_HAS_FILE_IO
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Quantum Painter External API: qp_load_image_file
+
+static inline bool image_file_stream_factory(qgf_image_handle_t *image, void *arg) {
+    FILE *f = fopen((const char *)arg, "rb");
+    if (!f) {
+        return false;
+    }
+
+    // File streams know their own length, the file is closed along with the image
+    image->file_stream = qp_make_file_stream(f);
+    return true;
+}
+
+painter_image_handle_t qp_load_image_file(const char *filename) {
+    return qp_load_image_internal(image_file_stream_factory, (void *)filename);
+}
+#endif // QP_STREAM_HAS_FILE_IO
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Quantum Painter External API: qp_close_image
 
@@ -116,6 +162,9 @@ typedef struct qgf_frame_info_t {
     uint8_t               bpp;
     bool                  has_palette;
     bool                  is_delta;
+    bool                  is_tiled;
+    uint8_t               tile_size;
+    uint16_t              run_count;
     uint16_t              left;
     uint16_t              top;
     uint16_t              right;
@@ -143,7 +192,7 @@ static bool qp_drawimage_prepare_frame_for_stream_read(painter_device_t device,
     }
 
     // Parse out the frame info
-    if (!qgf_parse_frame_descriptor(&frame_descriptor, &info->bpp, &info->has_palette, &info->is_delta, &info->compression_scheme, &info->delay)) {
+    if (!qgf_parse_frame_descriptor(&frame_descriptor, &info->bpp, &info->has_palette, &info->is_delta, &info->is_tiled, &info->compression_scheme, &info->delay)) {
         return false;
     }
 
@@ -151,7 +200,7 @@ static bool qp_drawimage_prepare_frame_for_stream_read(painter_device_t device,
     qp_internal_invalidate_palette();
 
     if (!qp_internal_bpp_capable(info->bpp)) {
-        qp_dprintf("qp_drawimage_recolor: fail (image bpp too high (%d), check QUANTUM_PAINTER_SUPPORTS_256_PALETTE or QUANTUM_PAINTER_SUPPORTS_NATIVE_COLORS)\n", (int)info->bpp);
+        qp_dprintf("qp_drawimage_prepare_frame_for_stream_read: fail (image bpp too high (%d), check QUANTUM_PAINTER_SUPPORTS_256_PALETTE or QUANTUM_PAINTER_SUPPORTS_NATIVE_COLORS)\n", (int)info->bpp);
         qp_comms_stop(device);
         return false;
     }
@@ -176,7 +225,7 @@ static bool qp_drawimage_prepare_frame_for_stream_read(painter_device_t device,
     if (needs_pixconvert) {
         // Convert the palette to native format
         if (!driver->driver_vtable->palette_convert(device, palette_entries, qp_internal_global_pixel_lookup_table)) {
-            qp_dprintf("qp_drawimage_recolor: fail (could not convert pixels to native)\n");
+            qp_dprintf("qp_drawimage_prepare_frame_for_stream_read: fail (could not convert pixels to native)\n");
             qp_comms_stop(device);
             return false;
         }
@@ -196,6 +245,18 @@ static bool qp_drawimage_prepare_frame_for_stream_read(painter_device_t device,
         info->bottom = delta_descriptor.bottom;
     }
 
+    // Handle tiles if needed
+    if (info->is_tiled) {
+        qgf_tiles_v1_t tiles_descriptor;
+        if (qp_stream_read(&tiles_descriptor, sizeof(qgf_tiles_v1_t), 1, &qgf_image->stream) != 1) {
+            qp_dprintf("Failed to read tiles_descriptor, expected length was not %d\n", (int)sizeof(qgf_tiles_v1_t));
+            return false;
+        }
+
+        info->tile_size = tiles_descriptor.tile_size;
+        info->run_count = tiles_descriptor.run_count;
+    }
+
     // Read the data block
     qgf_data_v1_t data_descriptor;
     if (qp_stream_read(&data_descriptor, sizeof(qgf_data_v1_t), 1, &qgf_image->stream) != 1) {
@@ -207,6 +268,77 @@ static bool qp_drawimage_prepare_frame_for_stream_read(painter_device_t device,
     return true;
 }
 
+// Decodes the supplied number of pixels from the stream and sends them to the display's current viewport
+static bool qp_drawimage_stream_pixels(painter_device_t device, qgf_frame_info_t *frame_info, uint32_t pixel_count, qp_internal_byte_input_callback input_callback, qp_internal_byte_input_state_t *input_state) {
+    painter_driver_t *driver = (painter_driver_t *)device;
+    bool              ret    = false;
+    if (frame_info->bpp <= 8) {
+        // Set up the output state
+        qp_internal_pixel_output_state_t output_state = {.device = device, .pixel_write_pos = 0, .max_pixels = qp_internal_num_pixels_in_buffer(device)};
+
+        // Decode the pixel data and stream to the display
+        ret = qp_internal_decode_palette(device, pixel_count, frame_info->bpp, input_callback, input_state, qp_internal_global_pixel_lookup_table, qp_internal_pixel_appender, &output_state);
+        // Any leftovers need transmission as well.
+        if (ret && output_state.pixel_write_pos > 0) {
+            ret &= driver->driver_vtable->pixdata(device, qp_internal_global_pixdata_buffer, output_state.pixel_write_pos);
+        }
+    } else if (frame_info->bpp != driver->native_bits_per_pixel) {
+        // Prevent stuff like drawing 24bpp images on 16bpp displays
+        qp_dprintf("qp_drawimage_stream_pixels: fail (image bpp does not match the native_bits_per_pixel of the target)\n");
+        return false;
+    } else {
+        // Set up the output state
+        qp_internal_byte_output_state_t output_state = {.device = device, .byte_write_pos = 0, .max_bytes = qp_internal_num_pixels_in_buffer(device) * driver->native_bits_per_pixel / 8};
+
+        // Stream the raw pixel data to the display
+        uint32_t byte_count = pixel_count * frame_info->bpp / 8;
+        ret                 = qp_internal_send_bytes(device, byte_count, input_callback, input_state, qp_internal_byte_appender, &output_state);
+        // Any leftovers need transmission as well.
+        if (ret && output_state.byte_write_pos > 0) {
+            ret &= driver->driver_vtable->pixdata(device, qp_internal_global_pixdata_buffer, output_state.byte_write_pos * 8 / driver->native_bits_per_pixel);
+        }
+    }
+    return ret;
+}
+
+// Draws each run of changed tiles in a tiled frame, each within its own viewport
+static bool qp_drawimage_stream_tiles(painter_device_t device, uint16_t x, uint16_t y, painter_image_handle_t image, qgf_frame_info_t *frame_info, qp_internal_byte_input_callback input_callback, qp_internal_byte_input_state_t *input_state) {
+    painter_driver_t *driver = (painter_driver_t *)device;
+    for (uint16_t i = 0; i < frame_info->run_count; ++i) {
+        // The run header is part of the (possibly compressed) frame data
+        qgf_tile_run_v1_t run;
+        uint8_t *         run_bytes = (uint8_t *)&run;
+        for (uint8_t j = 0; j < sizeof(qgf_tile_run_v1_t); ++j) {
+            int16_t byteval = input_callback(input_state);
+            if (byteval < 0) {
+                qp_dprintf("qp_drawimage_stream_tiles: fail (could not read tile run %d)\n", (int)i);
+                return false;
+            }
+            run_bytes[j] = byteval;
+        }
+
+        // Work out the area covered by the run, clipped to the image
+        uint16_t l = run.tile_x * frame_info->tile_size;
+        uint16_t t = run.tile_y * frame_info->tile_size;
+        uint16_t r = QP_MIN(l + run.count * frame_info->tile_size, image->width) - 1;
+        uint16_t b = QP_MIN(t + frame_info->tile_size, image->height) - 1;
+        if (run.count == 0 || l >= image->width || t >= image->height) {
+            qp_dprintf("qp_drawimage_stream_tiles: fail (tile run %d out of bounds)\n", (int)i);
+            return false;
+        }
+
+        if (!driver->driver_vtable->viewport(device, x + l, y + t, x + r, y + b)) {
+            qp_dprintf("qp_drawimage_stream_tiles: fail (could not set viewport)\n");
+            return false;
+        }
+
+        if (!qp_drawimage_stream_pixels(device, frame_info, ((uint32_t)(r - l + 1)) * (b - t + 1), input_callback, input_state)) {
+            return false;
+        }
+    }
+    return true;
+}
+
 static bool qp_drawimage_recolor_impl(painter_device_t device, uint16_t x, uint16_t y, painter_image_handle_t image, int frame_number, qgf_frame_info_t *frame_info, qp_pixel_t fg_hsv888, qp_pixel_t bg_hsv888) {
     qp_dprintf("qp_drawimage_recolor: entry\n");
     painter_driver_t *driver = (painter_driver_t *)device;
@@ -221,6 +353,11 @@ static bool qp_drawimage_recolor_impl(painter_device_t device, uint16_t x, uint1
         return false;
     }
 
+#ifdef FLASH_ENABLE
+    // Flash may have been rewritten since the last draw
+    qp_flash_stream_invalidate();
+#endif // FLASH_ENABLE
+
     // Read the frame info
     if (!qp_drawimage_prepare_frame_for_stream_read(device, qgf_image, frame_number, fg_hsv888, bg_hsv888, frame_info)) {
         qp_dprintf("qp_drawimage_recolor: fail (could not read frame %d)\n", frame_number);
@@ -232,27 +369,6 @@ static bool qp_drawimage_recolor_impl(painter_device_t device, uint16_t x, uint1
         return false;
     }
 
-    uint16_t l, t, r, b;
-    if (frame_info->is_delta) {
-        l = x + frame_info->left;
-        t = y + frame_info->top;
-        r = x + frame_info->right - 1;
-        b = y + frame_info->bottom - 1;
-    } else {
-        l = x;
-        t = y;
-        r = x + image->width - 1;
-        b = y + image->height - 1;
-    }
-    uint32_t pixel_count = ((uint32_t)(r - l + 1)) * (b - t + 1);
-
-    // Configure where we're going to be rendering to
-    if (!driver->driver_vtable->viewport(device, l, t, r, b)) {
-        qp_dprintf("qp_drawimage_recolor: fail (could not set viewport)\n");
-        qp_comms_stop(device);
-        return false;
-    }
-
     // Set up the input state
     qp_internal_byte_input_state_t  input_state    = {.device = device, .src_stream = &qgf_image->stream};
     qp_internal_byte_input_callback input_callback = qp_internal_prepare_input_state(&input_state, frame_info->compression_scheme);
@@ -263,31 +379,32 @@ static bool qp_drawimage_recolor_impl(painter_device_t device, uint16_t x, uint1
     }
 
     bool ret = false;
-    if (frame_info->bpp <= 8) {
-        // Set up the output state
-        qp_internal_pixel_output_state_t output_state = {.device = device, .pixel_write_pos = 0, .max_pixels = qp_internal_num_pixels_in_buffer(device)};
-
-        // Decode the pixel data and stream to the display
-        ret = qp_internal_decode_palette(device, pixel_count, frame_info->bpp, input_callback, &input_state, qp_internal_global_pixel_lookup_table, qp_internal_pixel_appender, &output_state);
-        // Any leftovers need transmission as well.
-        if (ret && output_state.pixel_write_pos > 0) {
-            ret &= driver->driver_vtable->pixdata(device, qp_internal_global_pixdata_buffer, output_state.pixel_write_pos);
-        }
-    } else if (frame_info->bpp != driver->native_bits_per_pixel) {
-        // Prevent stuff like drawing 24bpp images on 16bpp displays
-        qp_dprintf("Image's bpp doesn't match the target display's native_bits_per_pixel\n");
-        return false;
+    if (frame_info->is_tiled) {
+        // Only the changed tiles are present in the frame data
+        ret = qp_drawimage_stream_tiles(device, x, y, image, frame_info, input_callback, &input_state);
     } else {
-        // Set up the output state
-        qp_internal_byte_output_state_t output_state = {.device = device, .byte_write_pos = 0, .max_bytes = qp_internal_num_pixels_in_buffer(device) * driver->native_bits_per_pixel / 8};
+        uint16_t l, t, r, b;
+        if (frame_info->is_delta) {
+            l = x + frame_info->left;
+            t = y + frame_info->top;
+            r = x + frame_info->right;
+            b = y + frame_info->bottom;
+        } else {
+            l = x;
+            t = y;
+            r = x + image->width - 1;
+            b = y + image->height - 1;
+        }
+        uint32_t pixel_count = ((uint32_t)(r - l + 1)) * (b - t + 1);
 
-        // Stream the raw pixel data to the display
-        uint32_t byte_count = pixel_count * frame_info->bpp / 8;
-        ret                 = qp_internal_send_bytes(device, byte_count, input_callback, &input_state, qp_internal_byte_appender, &output_state);
-        // Any leftovers need transmission as well.
-        if (ret && output_state.byte_write_pos > 0) {
-            ret &= driver->driver_vtable->pixdata(device, qp_internal_global_pixdata_buffer, output_state.byte_write_pos * 8 / driver->native_bits_per_pixel);
+        // Configure where we're going to be rendering to
+        if (!driver->driver_vtable->viewport(device, l, t, r, b)) {
+            qp_dprintf("qp_drawimage_recolor: fail (could not set viewport)\n");
+            qp_comms_stop(device);
+            return false;
         }
+
+        ret = qp_drawimage_stream_pixels(device, frame_info, pixel_count, input_callback, &input_state);
     }
 
     qp_dprintf("qp_drawimage_recolor: %s\n", ret ? "ok" : "fail");
@@ -0,0 +1,146 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "qp_internal.h"
+#include "qp_comms.h"
+#include "qp_draw.h"
+
+// Fractional bits used for edge crossings when filling
+#define QP_POLYGON_FRAC_BITS 8
+
+// Sorts spans by their left edge -- polygons are small enough that insertion sort is fine
+static void qp_polygon_sort_spans(int16_t (*spans)[2], uint16_t count) {
+    for (uint16_t i = 1; i < count; ++i) {
+        int16_t l = spans[i][0];
+        int16_t r = spans[i][1];
+        int16_t j = i - 1;
+        for (; j >= 0 && spans[j][0] > l; --j) {
+            spans[j + 1][0] = spans[j][0];
+            spans[j + 1][1] = spans[j][1];
+        }
+        spans[j + 1][0] = l;
+        spans[j + 1][1] = r;
+    }
+}
+
+// Works out the runs of pixels on a single row of the polygon and adds them to the batch
+static bool qp_polygon_row(qp_span_batch_t *batch, const painter_point_t *points, uint8_t num_points, int16_t y, bool filled) {
+    int16_t  spans[QUANTUM_PAINTER_POLYGON_MAX_POINTS * 2][2];
+    uint16_t num_spans = 0;
+
+    // The pixels making up each of the edges
+    for (uint8_t i = 0; i < num_points; ++i) {
+        const painter_point_t *a = &points[i];
+        const painter_point_t *b = &points[(i + 1) % num_points];
+        if (qp_internal_line_row_run(a->x, a->y, b->x, b->y, y, &spans[num_spans][0], &spans[num_spans][1])) {
+            num_spans++;
+        }
+    }
+
+    if (filled) {
+        // Find where the centre of the row crosses each edge, each edge including its top but not its bottom so that
+        // shared vertices are only counted once
+        int32_t crossings[QUANTUM_PAINTER_POLYGON_MAX_POINTS];
+        uint8_t num_crossings = 0;
+        for (uint8_t i = 0; i < num_points; ++i) {
+            const painter_point_t *a = &points[i];
+            const painter_point_t *b = &points[(i + 1) % num_points];
+            if (a->y == b->y) {
+                continue;
+            }
+            if (a->y > b->y) {
+                const painter_point_t *t = a;
+                a                        = b;
+                b                        = t;
+            }
+            if (y < (int16_t)a->y || y >= (int16_t)b->y) {
+                continue;
+            }
+
+            int32_t x = (((int32_t)a->x) << QP_POLYGON_FRAC_BITS) + (((int32_t)b->x - (int32_t)a->x) * (y - (int32_t)a->y) * (1 << QP_POLYGON_FRAC_BITS)) / ((int32_t)b->y - (int32_t)a->y);
+
+            // Insert in order
+            int16_t j = num_crossings - 1;
+            for (; j >= 0 && crossings[j] > x; --j) {
+                crossings[j + 1] = crossings[j];
+            }
+            crossings[j + 1] = x;
+            num_crossings++;
+        }
+
+        // Even-odd rule, the pixel centres between each pair of crossings are inside the polygon
+        for (uint8_t i = 0; i + 1 < num_crossings; i += 2) {
+            int16_t l = (crossings[i] + (1 << QP_POLYGON_FRAC_BITS) - 1) >> QP_POLYGON_FRAC_BITS;
+            int16_t r = crossings[i + 1] >> QP_POLYGON_FRAC_BITS;
+            if (l <= r) {
+                spans[num_spans][0] = l;
+                spans[num_spans][1] = r;
+                num_spans++;
+            }
+        }
+    }
+
+    // Merge any overlapping or touching spans, so that each run is only sent once
+    qp_polygon_sort_spans(spans, num_spans);
+    for (uint16_t i = 0; i < num_spans;) {
+        int16_t l = spans[i][0];
+        int16_t r = spans[i][1];
+        for (++i; i < num_spans && spans[i][0] <= r + 1; ++i) {
+            r = QP_MAX(r, spans[i][1]);
+        }
+        if (!qp_internal_span_batch_add(batch, l, r, y)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Quantum Painter External API: qp_polygon
+
+bool qp_polygon(painter_device_t device, const painter_point_t *points, uint8_t num_points, uint8_t hue, uint8_t sat, uint8_t val, bool filled) {
+    qp_dprintf("qp_polygon(%d points): entry\n", (int)num_points);
+    painter_driver_t *driver = (painter_driver_t *)device;
+    if (!driver->validate_ok) {
+        qp_dprintf("qp_polygon: fail (validation_ok == false)\n");
+        return false;
+    }
+
+    if (num_points < 2 || num_points > QUANTUM_PAINTER_POLYGON_MAX_POINTS) {
+        qp_dprintf("qp_polygon: fail (invalid number of points, maximum %d)\n", (int)QUANTUM_PAINTER_POLYGON_MAX_POINTS);
+        return false;
+    }
+
+    // Work out the bounding box
+    uint16_t l = points[0].x, t = points[0].y, r = points[0].x, b = points[0].y;
+    for (uint8_t i = 1; i < num_points; ++i) {
+        l = QP_MIN(l, points[i].x);
+        t = QP_MIN(t, points[i].y);
+        r = QP_MAX(r, points[i].x);
+        b = QP_MAX(b, points[i].y);
+    }
+
+    if (!qp_comms_start(device)) {
+        qp_dprintf("Failed to start comms in qp_polygon\n");
+        return false;
+    }
+
+    // Identical rows are merged into a single transfer, so allow for the whole area even when only drawing an outline
+    qp_internal_fill_pixdata(device, ((uint32_t)(r - l + 1)) * (b - t + 1), hue, sat, val);
+
+    qp_span_batch_t batch;
+    qp_internal_span_batch_init(&batch, device);
+
+    bool ret = true;
+    for (int16_t y = t; ret && y <= (int16_t)b; ++y) {
+        ret = qp_polygon_row(&batch, points, num_points, y, filled);
+    }
+    if (!qp_internal_span_batch_flush(&batch)) {
+        ret = false;
+    }
+
+    qp_comms_stop(device);
+    qp_dprintf("qp_polygon: %s (%d transfers)\n", ret ? "ok" : "fail", (int)batch.transfers);
+    return ret;
+}
@@ -23,6 +23,9 @@ typedef struct qff_font_handle_t {
     union {
         qp_stream_t        stream;
         qp_memory_stream_t mem_stream;
+#ifdef FLASH_ENABLE
+        qp_flash_stream_t flash_stream;
+#endif // FLASH_ENABLE
 #ifdef QP_STREAM_HAS_FILE_IO
         qp_file_stream_t file_stream;
 #endif // QP_STREAM_HAS_FILE_IO
@@ -35,6 +38,127 @@ typedef struct qff_font_handle_t {
 
 static qff_font_handle_t font_descriptors[QUANTUM_PAINTER_NUM_FONTS] = {0};
 
+#if QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES > 0
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Glyph cache
+
+// Decoded glyph, in the native pixel format of the device it was rendered for
+typedef struct qp_glyph_cache_entry_t {
+    // First, so that it's aligned for drivers writing multi-byte native pixels (e.g. RGB565) -- unaligned accesses fault on Cortex-M0
+    uint8_t            data[QUANTUM_PAINTER_GLYPH_CACHE_ENTRY_SIZE];
+    qff_font_handle_t *font; // NULL if unused
+    painter_device_t   device;
+    uint32_t           code_point;
+    qp_pixel_t         fg_hsv888;
+    qp_pixel_t         bg_hsv888;
+    uint32_t           last_used;
+    uint8_t            width;
+} qp_glyph_cache_entry_t;
+
+static qp_glyph_cache_entry_t glyph_cache[QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES] = {0};
+static uint32_t               glyph_cache_clock                                = 0;
+
+// Output state used when decoding a glyph into a cache entry
+typedef struct qp_glyph_cache_output_state_t {
+    painter_device_t device;
+    uint8_t *        target;
+    uint32_t         pixel_write_pos;
+} qp_glyph_cache_output_state_t;
+
+static bool qp_glyph_cache_appender(qp_pixel_t *palette, uint8_t index, void *cb_arg) {
+    qp_glyph_cache_output_state_t *state  = (qp_glyph_cache_output_state_t *)cb_arg;
+    painter_driver_t *             driver = (painter_driver_t *)state->device;
+    return driver->driver_vtable->append_pixels(state->device, state->target, palette, state->pixel_write_pos++, 1, &index);
+}
+
+// Finds the width of a glyph already in the cache, regardless of the device or colors it was rendered with
+static bool qp_glyph_cache_width(qff_font_handle_t *qff_font, uint32_t code_point, uint8_t *width) {
+    for (int i = 0; i < QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES; ++i) {
+        qp_glyph_cache_entry_t *entry = &glyph_cache[i];
+        if (entry->font == qff_font && entry->code_point == code_point) {
+            *width = entry->width;
+            return true;
+        }
+    }
+    return false;
+}
+
+// Finds a glyph rendered for the supplied device and colors, marking it as used by the current draw
+static qp_glyph_cache_entry_t *qp_glyph_cache_find(qff_font_handle_t *qff_font, uint32_t code_point, painter_device_t device, qp_pixel_t fg_hsv888, qp_pixel_t bg_hsv888, uint32_t stamp) {
+    for (int i = 0; i < QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES; ++i) {
+        qp_glyph_cache_entry_t *entry = &glyph_cache[i];
+        if (entry->font == qff_font && entry->code_point == code_point && entry->device == device && memcmp(&entry->fg_hsv888.hsv888, &fg_hsv888.hsv888, sizeof(fg_hsv888.hsv888)) == 0 && memcmp(&entry->bg_hsv888.hsv888, &bg_hsv888.hsv888, sizeof(bg_hsv888.hsv888)) == 0) {
+            entry->last_used = stamp;
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+// Picks an entry to be replaced -- an unused one if available, otherwise the least-recently-used entry not needed by the current draw
+static qp_glyph_cache_entry_t *qp_glyph_cache_victim(uint32_t stamp) {
+    qp_glyph_cache_entry_t *victim = NULL;
+    for (int i = 0; i < QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES; ++i) {
+        qp_glyph_cache_entry_t *entry = &glyph_cache[i];
+        if (entry->font == NULL) {
+            return entry;
+        }
+        if (entry->last_used == stamp) {
+            continue;
+        }
+        if (victim == NULL || (uint32_t)(stamp - entry->last_used) > (uint32_t)(stamp - victim->last_used)) {
+            victim = entry;
+        }
+    }
+    return victim;
+}
+
+// Decodes a glyph into the cache. Expects the font's palette to already be set up, and the stream to be positioned at the glyph data.
+static qp_glyph_cache_entry_t *qp_glyph_cache_insert(qff_font_handle_t *qff_font, uint32_t code_point, uint8_t width, painter_device_t device, qp_pixel_t fg_hsv888, qp_pixel_t bg_hsv888, uint32_t stamp) {
+    painter_driver_t *driver      = (painter_driver_t *)device;
+    uint32_t          pixel_count = ((uint32_t)width) * qff_font->base.line_height;
+    if ((pixel_count * driver->native_bits_per_pixel + 7) / 8 > QUANTUM_PAINTER_GLYPH_CACHE_ENTRY_SIZE) {
+        return NULL;
+    }
+
+    qp_glyph_cache_entry_t *entry = qp_glyph_cache_victim(stamp);
+    if (entry == NULL) {
+        return NULL;
+    }
+
+    qp_internal_byte_input_state_t  input_state    = {.device = device, .src_stream = &qff_font->stream};
+    qp_internal_byte_input_callback input_callback = qp_internal_prepare_input_state(&input_state, qff_font->compression_scheme);
+    qp_glyph_cache_output_state_t   output_state   = {.device = device, .target = entry->data, .pixel_write_pos = 0};
+
+    // Mark as unused until the decode completes, so a failure doesn't leave a partial glyph behind. The stream is
+    // rewound on failure so that the caller can fall back to decoding directly to the display.
+    int32_t data_offset = qp_stream_getpos(&qff_font->stream);
+    entry->font         = NULL;
+    if (input_callback == NULL || !qp_internal_decode_palette(device, pixel_count, qff_font->bpp, input_callback, &input_state, qp_internal_global_pixel_lookup_table, qp_glyph_cache_appender, &output_state)) {
+        qp_stream_setpos(&qff_font->stream, data_offset);
+        return NULL;
+    }
+
+    entry->font       = qff_font;
+    entry->device     = device;
+    entry->code_point = code_point;
+    entry->fg_hsv888  = fg_hsv888;
+    entry->bg_hsv888  = bg_hsv888;
+    entry->last_used  = stamp;
+    entry->width      = width;
+    return entry;
+}
+
+// Drops all the cached glyphs belonging to a font
+static void qp_glyph_cache_evict_font(qff_font_handle_t *qff_font) {
+    for (int i = 0; i < QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES; ++i) {
+        if (glyph_cache[i].font == qff_font) {
+            glyph_cache[i].font = NULL;
+        }
+    }
+}
+#endif // QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES > 0
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Helper: load font from stream
 
@@ -64,6 +188,7 @@ static painter_font_handle_t qp_load_font_internal(bool (*stream_factory)(qff_fo
     // Now that we know the length, validate the input data
     if (!qff_validate_stream(&font->stream)) {
         qp_dprintf("qp_load_font: fail (failed validation)\n");
+        qp_stream_close(&font->stream);
         return NULL;
     }
 
@@ -72,13 +197,16 @@ static painter_font_handle_t qp_load_font_internal(bool (*stream_factory)(qff_fo
     font->owns_buffer = false;
     font->buffer      = NULL;
 
-    void *ram_buffer = malloc(font->mem_stream.length);
+    // Works for any stream type, so fonts stored in external flash can also be moved into RAM
+    uint32_t font_length = qff_get_total_size(&font->stream);
+    void *   ram_buffer  = malloc(font_length);
     if (ram_buffer == NULL) {
         qp_dprintf("qp_load_font: could not allocate enough RAM for font, falling back to original\n");
     } else {
         do {
-            // Copy the data into RAM
-            if (qp_stream_read(ram_buffer, 1, font->mem_stream.length, &font->mem_stream) != font->mem_stream.length) {
+            // Copy the data into RAM, from the start of the font
+            qp_stream_setpos(&font->stream, 0);
+            if (qp_stream_read(ram_buffer, 1, font_length, &font->stream) != font_length) {
                 qp_dprintf("qp_load_font: could not copy from flash to RAM, falling back to original\n");
                 break;
             }
@@ -86,7 +214,7 @@ static painter_font_handle_t qp_load_font_internal(bool (*stream_factory)(qff_fo
             // Create the new stream with the new buffer
             font->buffer      = ram_buffer;
             font->owns_buffer = true;
-            font->mem_stream  = qp_make_memory_stream(font->buffer, font->mem_stream.length);
+            font->mem_stream  = qp_make_memory_stream(font->buffer, font_length);
         } while (0);
     }
 
@@ -131,6 +259,48 @@ painter_font_handle_t qp_load_font_mem(const void *buffer) {
     return qp_load_font_internal(font_mem_stream_factory, (void *)buffer);
 }
 
+#ifdef FLASH_ENABLE
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Quantum Painter External API: qp_load_font_flash
+
+static inline bool font_flash_stream_factory(qff_font_handle_t *font, void *arg) {
+    uint32_t address = *(uint32_t *)arg;
+
+    // Assume we can read the font descriptor
+    font->flash_stream = qp_make_flash_stream(address, sizeof(qff_font_descriptor_v1_t));
+
+    // Update the length of the stream to match, and rewind to the start
+    font->flash_stream.length   = qff_get_total_size(&font->stream);
+    font->flash_stream.position = 0;
+
+    return true;
+}
+
+painter_font_handle_t qp_load_font_flash(uint32_t address) {
+    return qp_load_font_internal(font_flash_stream_factory, &address);
+}
+#endif // FLASH_ENABLE
+
+#ifdef QP_STREAM_HAS_FILE_IO
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Quantum Painter External API: qp_load_font_file
+
+static inline bool font_file_stream_factory(qff_font_handle_t *font, void *arg) {
+    FILE *f = fopen((const char *)arg, "rb");
+    if (!f) {
+        return false;
+    }
+
+    // File streams know their own length, the file is closed along with the font
+    font->file_stream = qp_make_file_stream(f);
+    return true;
+}
+
+painter_font_handle_t qp_load_font_file(const char *filename) {
+    return qp_load_font_internal(font_file_stream_factory, (void *)filename);
+}
+#endif // QP_STREAM_HAS_FILE_IO
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Quantum Painter External API: qp_close_font
 
@@ -150,6 +320,11 @@ bool qp_close_font(painter_font_handle_t font) {
     }
 #endif // QUANTUM_PAINTER_LOAD_FONTS_TO_RAM
 
+#if QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES > 0
+    // The font slot may be reused, so drop any glyphs rendered from this one
+    qp_glyph_cache_evict_font(qff_font);
+#endif // QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES > 0
+
     // Free up this font for use elsewhere.
     qp_stream_close(&qff_font->stream);
     qff_font->validate_ok = false;
@@ -160,7 +335,7 @@ bool qp_close_font(painter_font_handle_t font) {
 // Helpers
 
 // Callback to be invoked for each codepoint detected in the UTF8 input string
-typedef bool (*code_point_handler)(qff_font_handle_t *qff_font, uint32_t code_point, uint8_t width, uint8_t height, void *cb_arg);
+typedef bool (*code_point_handler)(qff_font_handle_t *qff_font, uint32_t code_point, void *cb_arg);
 
 // Helper that sets up the palette (if required) and returns the offset in the stream that the data starts
 static inline bool qp_drawtext_prepare_font_for_render(painter_device_t device, qff_font_handle_t *qff_font, qp_pixel_t fg_hsv888, qp_pixel_t bg_hsv888, uint32_t *data_offset) {
@@ -197,7 +372,8 @@ static inline bool qp_drawtext_prepare_font_for_render(painter_device_t device,
     } else {
         // Interpolate from fg/bg
         int16_t palette_entries = 1 << qff_font->bpp;
-        needs_pixconvert        = qp_internal_interpolate_palette(fg_hsv888, bg_hsv888, palette_entries);
+        qp_internal_palette_device(device);
+        needs_pixconvert = qp_internal_interpolate_palette(fg_hsv888, bg_hsv888, palette_entries);
     }
 
     if (needs_pixconvert) {
@@ -301,13 +477,7 @@ static inline bool qp_iterate_code_points(qff_font_handle_t *qff_font, const cha
             return false;
         }
 
-        uint8_t width;
-        if (!qp_drawtext_prepare_glyph_for_render(qff_font, code_point, &width)) {
-            qp_dprintf("Failed to prepare glyph for rendering.\n");
-            return false;
-        }
-
-        if (!handler(qff_font, code_point, width, qff_font->base.line_height, cb_arg)) {
+        if (!handler(qff_font, code_point, cb_arg)) {
             qp_dprintf("Failed to execute glyph handler.\n");
             return false;
         }
@@ -324,9 +494,20 @@ typedef struct code_point_iter_calcwidth_state_t {
 } code_point_iter_calcwidth_state_t;
 
 // Codepoint handler callback: width calc
-static inline bool qp_font_code_point_handler_calcwidth(qff_font_handle_t *qff_font, uint32_t code_point, uint8_t width, uint8_t height, void *cb_arg) {
+static inline bool qp_font_code_point_handler_calcwidth(qff_font_handle_t *qff_font, uint32_t code_point, void *cb_arg) {
     code_point_iter_calcwidth_state_t *state = (code_point_iter_calcwidth_state_t *)cb_arg;
 
+    uint8_t width;
+#if QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES > 0
+    if (!qp_glyph_cache_width(qff_font, code_point, &width))
+#endif // QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES > 0
+    {
+        if (!qp_drawtext_prepare_glyph_for_render(qff_font, code_point, &width)) {
+            qp_dprintf("Failed to prepare glyph for rendering.\n");
+            return false;
+        }
+    }
+
     // Increment the overall width by this glyph's width
     state->width += width;
 
@@ -344,14 +525,46 @@ typedef struct code_point_iter_drawglyph_state_t {
     qp_internal_byte_input_callback   input_callback;
     qp_internal_byte_input_state_t *  input_state;
     qp_internal_pixel_output_state_t *output_state;
+#if QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES > 0
+    // Cache
+    qp_pixel_t fg_hsv888;
+    qp_pixel_t bg_hsv888;
+    uint32_t   cache_stamp;
+    int16_t    line_width;
+#endif // QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES > 0
 } code_point_iter_drawglyph_state_t;
 
 // Codepoint handler callback: drawing
-static inline bool qp_font_code_point_handler_drawglyph(qff_font_handle_t *qff_font, uint32_t code_point, uint8_t width, uint8_t height, void *cb_arg) {
+static inline bool qp_font_code_point_handler_drawglyph(qff_font_handle_t *qff_font, uint32_t code_point, void *cb_arg) {
     code_point_iter_drawglyph_state_t *state  = (code_point_iter_drawglyph_state_t *)cb_arg;
     painter_driver_t *                 driver = (painter_driver_t *)state->device;
+    uint8_t                            height = qff_font->base.line_height;
+    uint8_t                            width;
 
-    // Reset the input state's RLE mode -- the stream should already be correctly positioned by qp_iterate_code_points()
+#if QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES > 0
+    // Send the pre-rendered pixels if we have them, otherwise try to decode the glyph into the cache
+    qp_glyph_cache_entry_t *entry = qp_glyph_cache_find(qff_font, code_point, state->device, state->fg_hsv888, state->bg_hsv888, state->cache_stamp);
+    if (entry == NULL) {
+        if (!qp_drawtext_prepare_glyph_for_render(qff_font, code_point, &width)) {
+            qp_dprintf("Failed to prepare glyph for rendering.\n");
+            return false;
+        }
+        entry = qp_glyph_cache_insert(qff_font, code_point, width, state->device, state->fg_hsv888, state->bg_hsv888, state->cache_stamp);
+    }
+    if (entry != NULL) {
+        width = entry->width;
+        driver->driver_vtable->viewport(state->device, state->xpos, state->ypos, state->xpos + width - 1, state->ypos + height - 1);
+        state->xpos += width;
+        return driver->driver_vtable->pixdata(state->device, entry->data, ((uint32_t)width) * height);
+    }
+#else
+    if (!qp_drawtext_prepare_glyph_for_render(qff_font, code_point, &width)) {
+        qp_dprintf("Failed to prepare glyph for rendering.\n");
+        return false;
+    }
+#endif // QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES > 0
+
+    // Reset the input state's RLE mode -- the stream should already be correctly positioned by qp_drawtext_prepare_glyph_for_render()
     state->input_state->rle.mode = MARKER_BYTE; // ignored if not using RLE
 
     // Reset the output state
@@ -375,6 +588,85 @@ static inline bool qp_font_code_point_handler_drawglyph(qff_font_handle_t *qff_f
     return ret;
 }
 
+#if QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES > 0
+// Codepoint handler callback: ensures each glyph is in the cache, accumulating the width of the line
+static inline bool qp_font_code_point_handler_cacheglyph(qff_font_handle_t *qff_font, uint32_t code_point, void *cb_arg) {
+    code_point_iter_drawglyph_state_t *state = (code_point_iter_drawglyph_state_t *)cb_arg;
+
+    qp_glyph_cache_entry_t *entry = qp_glyph_cache_find(qff_font, code_point, state->device, state->fg_hsv888, state->bg_hsv888, state->cache_stamp);
+    if (entry == NULL) {
+        uint8_t width;
+        if (!qp_drawtext_prepare_glyph_for_render(qff_font, code_point, &width)) {
+            return false;
+        }
+        entry = qp_glyph_cache_insert(qff_font, code_point, width, state->device, state->fg_hsv888, state->bg_hsv888, state->cache_stamp);
+        if (entry == NULL) {
+            return false;
+        }
+    }
+
+    state->line_width += entry->width;
+    return true;
+}
+
+// Sends a string made up entirely of cached glyphs using a single viewport, interleaving the glyphs one pixel row at a
+// time. Requires whole bytes per native pixel, so that rows can be copied directly.
+static bool qp_drawtext_cached_line(code_point_iter_drawglyph_state_t *state, qff_font_handle_t *qff_font, const char *str) {
+    painter_driver_t *driver          = (painter_driver_t *)state->device;
+    uint8_t           height          = qff_font->base.line_height;
+    uint8_t           bytes_per_pixel = driver->native_bits_per_pixel / 8;
+    uint32_t          max_pixels      = state->output_state->max_pixels;
+    uint32_t          write_pos       = 0;
+
+    if (state->line_width == 0) {
+        return true;
+    }
+
+    driver->driver_vtable->viewport(state->device, state->xpos, state->ypos, state->xpos + state->line_width - 1, state->ypos + height - 1);
+
+    for (uint8_t row = 0; row < height; ++row) {
+        const char *curr = str;
+        while (*curr) {
+            int32_t code_point = 0;
+            curr               = decode_utf8(curr, &code_point);
+
+            // Every glyph was marked as in use by this draw while filling the cache, so none will have been evicted
+            qp_glyph_cache_entry_t *entry = qp_glyph_cache_find(qff_font, code_point, state->device, state->fg_hsv888, state->bg_hsv888, state->cache_stamp);
+            if (entry == NULL) {
+                return false;
+            }
+
+            const uint8_t *src       = entry->data + ((uint32_t)row) * entry->width * bytes_per_pixel;
+            uint32_t       remaining = entry->width;
+            while (remaining > 0) {
+                uint32_t count = QP_MIN(remaining, max_pixels - write_pos);
+                memcpy(qp_internal_global_pixdata_buffer + write_pos * bytes_per_pixel, src, count * bytes_per_pixel);
+                src += count * bytes_per_pixel;
+                write_pos += count;
+                remaining -= count;
+
+                // If we've hit the transmit limit, send out the entire buffer and reset the write position
+                if (write_pos == max_pixels) {
+                    if (!driver->driver_vtable->pixdata(state->device, qp_internal_global_pixdata_buffer, write_pos)) {
+                        return false;
+                    }
+                    qp_internal_swap_pixdata_buffer();
+                    write_pos = 0;
+                }
+            }
+        }
+    }
+
+    // Any leftovers need transmission as well.
+    if (write_pos > 0 && !driver->driver_vtable->pixdata(state->device, qp_internal_global_pixdata_buffer, write_pos)) {
+        return false;
+    }
+
+    state->xpos += state->line_width;
+    return true;
+}
+#endif // QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES > 0
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Quantum Painter External API: qp_textwidth
 
@@ -385,6 +677,11 @@ int16_t qp_textwidth(painter_font_handle_t font, const char *str) {
         return false;
     }
 
+#ifdef FLASH_ENABLE
+    // Flash may have been rewritten since the last draw
+    qp_flash_stream_invalidate();
+#endif // FLASH_ENABLE
+
     // Create the codepoint iterator state
     code_point_iter_calcwidth_state_t state = {.width = 0};
     // Iterate each codepoint, return the calculated width if successful.
@@ -417,6 +714,11 @@ int16_t qp_drawtext_recolor(painter_device_t device, uint16_t x, uint16_t y, pai
         return false;
     }
 
+#ifdef FLASH_ENABLE
+    // Flash may have been rewritten since the last draw
+    qp_flash_stream_invalidate();
+#endif // FLASH_ENABLE
+
     if (!qp_comms_start(device)) {
         qp_dprintf("qp_drawtext_recolor: fail (could not start comms)\n");
         return 0;
@@ -454,8 +756,24 @@ int16_t qp_drawtext_recolor(painter_device_t device, uint16_t x, uint16_t y, pai
         return false;
     }
 
-    // Iterate the codepoints with the drawglyph callback
-    bool ret = qp_iterate_code_points(qff_font, str, qp_font_code_point_handler_drawglyph, &state);
+    bool ret;
+#if QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES > 0
+    // Fonts with their own palette ignore the requested colors, so they shouldn't be part of the cache key
+    qp_pixel_t no_color = {.hsv888 = {.h = 0, .s = 0, .v = 0}};
+    state.fg_hsv888     = qff_font->has_palette ? no_color : fg_hsv888;
+    state.bg_hsv888     = qff_font->has_palette ? no_color : bg_hsv888;
+    state.cache_stamp   = ++glyph_cache_clock;
+    state.line_width    = 0;
+
+    // If the whole string fits in the cache, send it in one transfer instead of a viewport per glyph
+    if ((driver->native_bits_per_pixel % 8) == 0 && qp_iterate_code_points(qff_font, str, qp_font_code_point_handler_cacheglyph, &state)) {
+        ret = qp_drawtext_cached_line(&state, qff_font, str);
+    } else
+#endif // QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES > 0
+    {
+        // Iterate the codepoints with the drawglyph callback
+        ret = qp_iterate_code_points(qff_font, str, qp_font_code_point_handler_drawglyph, &state);
+    }
 
     qp_dprintf("qp_drawtext_recolor: %s\n", ret ? "ok" : "fail");
     qp_comms_stop(device);
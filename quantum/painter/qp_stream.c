@@ -3,6 +3,11 @@
 
 #include "qp_stream.h"
 
+#ifdef FLASH_ENABLE
+#    include "flash_spi.h"
+#    include "qp_comms.h"
+#endif // FLASH_ENABLE
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Stream API
 
@@ -119,6 +124,115 @@ qp_memory_stream_t qp_make_memory_stream(void *buffer, int32_t length) {
     return stream;
 }
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// External flash streams
+
+#ifdef FLASH_ENABLE
+
+// Read-ahead cache, shared between all flash streams and keyed on the absolute flash address
+static uint8_t  flash_cache[QUANTUM_PAINTER_FLASH_CACHE_SIZE];
+static uint32_t flash_cache_address = 0;
+static uint32_t flash_cache_length  = 0;
+
+static inline int16_t flash_get(qp_stream_t *stream) {
+    qp_flash_stream_t *s = (qp_flash_stream_t *)stream;
+    if (s->position >= s->length) {
+        s->is_eof = true;
+        return STREAM_EOF;
+    }
+
+    uint32_t address = s->address + s->position;
+    if (address < flash_cache_address || address >= flash_cache_address + flash_cache_length) {
+        // Refill the cache starting at the requested byte, without reading past the end of the stream
+        uint32_t length = s->length - s->position;
+        if (length > sizeof(flash_cache)) {
+            length = sizeof(flash_cache);
+        }
+        // The display may be holding a shared SPI bus mid-draw, so it's released for the duration of the read
+        painter_device_t device = qp_comms_suspend();
+        flash_status_t   status = flash_read_block(address, flash_cache, length);
+        if (!qp_comms_resume(device) || status != FLASH_STATUS_SUCCESS) {
+            flash_cache_length = 0;
+            s->is_eof          = true;
+            return STREAM_EOF;
+        }
+        flash_cache_address = address;
+        flash_cache_length  = length;
+    }
+
+    s->position++;
+    return flash_cache[address - flash_cache_address];
+}
+
+void qp_flash_stream_invalidate(void) {
+    flash_cache_length = 0;
+}
+
+static inline bool flash_put(qp_stream_t *stream, uint8_t c) {
+    // Flash streams are read-only, assets are written using the flash driver directly.
+    return false;
+}
+
+static inline int flash_seek(qp_stream_t *stream, int32_t offset, int origin) {
+    qp_flash_stream_t *s = (qp_flash_stream_t *)stream;
+
+    // Handle as per fseek
+    int32_t position = s->position;
+    switch (origin) {
+        case SEEK_SET:
+            position = offset;
+            break;
+        case SEEK_CUR:
+            position += offset;
+            break;
+        case SEEK_END:
+            position = s->length + offset;
+            break;
+        default:
+            return -1;
+    }
+
+    // Same bounds behaviour as memory streams
+    if (position < 0 || position > s->length) {
+        return -1;
+    }
+
+    // Update the offset, the cache is retained as it's keyed on the absolute address
+    s->position = position;
+    s->is_eof   = false;
+
+    return 0;
+}
+
+static inline int32_t flash_tell(qp_stream_t *stream) {
+    qp_flash_stream_t *s = (qp_flash_stream_t *)stream;
+    return s->position;
+}
+
+static inline bool flash_is_eof(qp_stream_t *stream) {
+    qp_flash_stream_t *s = (qp_flash_stream_t *)stream;
+    return s->is_eof;
+}
+
+static inline void flash_close(qp_stream_t *stream) {
+    // No-op.
+}
+
+qp_flash_stream_t qp_make_flash_stream(uint32_t address, int32_t length) {
+    // The asset may have just been written, don't trust anything cached from before
+    qp_flash_stream_invalidate();
+
+    qp_flash_stream_t stream = {
+        .base     = {.get = flash_get, .put = flash_put, .seek = flash_seek, .tell = flash_tell, .is_eof = flash_is_eof, .close = flash_close},
+        .address  = address,
+        .length   = length,
+        .position = 0,
+    };
+    return stream;
+}
+
+#endif // FLASH_ENABLE
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // FILE streams
 
@@ -0,0 +1,134 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// Quantum Painter Bundle "QPB" File Format.
+// See https://docs.qmk.fm/#/quantum_painter_qpb for more information.
+
+#include "qpb.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// QPB API
+
+uint32_t qpb_hash_name(const char *name) {
+    // 32-bit FNV-1a
+    uint32_t hash = 0x811C9DC5;
+    while (*name) {
+        hash ^= (uint8_t)*name++;
+        hash *= 0x01000193;
+    }
+    return hash;
+}
+
+bool qpb_read_bundle_descriptor(qp_stream_t *stream, uint16_t *asset_count, uint32_t *total_bytes) {
+    // Seek to the start
+    qp_stream_setpos(stream, 0);
+
+    // Read and validate the bundle descriptor
+    qpb_bundle_descriptor_v1_t bundle_descriptor;
+    if (qp_stream_read(&bundle_descriptor, sizeof(qpb_bundle_descriptor_v1_t), 1, stream) != 1) {
+        qp_dprintf("Failed to read bundle_descriptor, expected length was not %d\n", (int)sizeof(qpb_bundle_descriptor_v1_t));
+        return false;
+    }
+
+    // Make sure this block is valid
+    if (!qgf_validate_block_header(&bundle_descriptor.header, QPB_BUNDLE_DESCRIPTOR_TYPEID, (sizeof(qpb_bundle_descriptor_v1_t) - sizeof(qgf_block_header_v1_t)))) {
+        return false;
+    }
+
+    // Make sure the magic and version are correct
+    if (bundle_descriptor.magic != QPB_MAGIC || bundle_descriptor.qpb_version != 0x01) {
+        qp_dprintf("Failed to validate bundle_descriptor, expected magic 0x%06X was 0x%06X, expected version = 0x%02X was 0x%02X\n", (int)QPB_MAGIC, (int)bundle_descriptor.magic, (int)0x01, (int)bundle_descriptor.qpb_version);
+        return false;
+    }
+
+    // Make sure the file length is valid
+    if (bundle_descriptor.neg_total_file_size != ~bundle_descriptor.total_file_size) {
+        qp_dprintf("Failed to validate bundle_descriptor, expected negated length 0x%08X was 0x%08X\n", (int)(~bundle_descriptor.total_file_size), (int)bundle_descriptor.neg_total_file_size);
+        return false;
+    }
+
+    // Copy out the required info
+    if (asset_count) {
+        *asset_count = bundle_descriptor.asset_count;
+    }
+    if (total_bytes) {
+        *total_bytes = bundle_descriptor.total_file_size;
+    }
+
+    return true;
+}
+
+bool qpb_find_asset(qp_stream_t *stream, const char *name, uint32_t *offset, uint32_t *length) {
+    uint16_t asset_count;
+    uint32_t total_bytes;
+    if (!qpb_read_bundle_descriptor(stream, &asset_count, &total_bytes)) {
+        return false;
+    }
+
+    // Read and validate the asset table header, which immediately follows the bundle descriptor
+    qpb_asset_table_v1_t asset_table;
+    if (qp_stream_read(&asset_table, sizeof(qpb_asset_table_v1_t), 1, stream) != 1) {
+        qp_dprintf("Failed to read asset_table, expected length was not %d\n", (int)sizeof(qpb_asset_table_v1_t));
+        return false;
+    }
+    if (!qgf_validate_block_header(&asset_table.header, QPB_ASSET_TABLE_DESCRIPTOR_TYPEID, asset_count * sizeof(qpb_asset_v1_t))) {
+        return false;
+    }
+
+    // Linear search of the asset table, bundles only hold a modest number of assets
+    uint32_t name_hash = qpb_hash_name(name);
+    for (uint16_t i = 0; i < asset_count; ++i) {
+        qpb_asset_v1_t asset;
+        if (qp_stream_read(&asset, sizeof(qpb_asset_v1_t), 1, stream) != 1) {
+            qp_dprintf("Failed to read asset %d from asset_table\n", (int)i);
+            return false;
+        }
+
+        if (asset.name_hash != name_hash) {
+            continue;
+        }
+
+        if (asset.offset > total_bytes || asset.length > total_bytes - asset.offset) {
+            qp_dprintf("Failed to validate asset %d, data extends past the end of the bundle\n", (int)i);
+            return false;
+        }
+
+        if (offset) {
+            *offset = asset.offset;
+        }
+        if (length) {
+            *length = asset.length;
+        }
+        return true;
+    }
+
+    qp_dprintf("Failed to find asset \"%s\" in bundle\n", name);
+    return false;
+}
+
+#ifdef FLASH_ENABLE
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Quantum Painter External API: qp_flash_bundle_find
+
+bool qp_flash_bundle_find(uint32_t bundle_address, const char *name, uint32_t *address) {
+    // Start off with just the bundle descriptor, then extend to the size of the full bundle
+    qp_flash_stream_t stream = qp_make_flash_stream(bundle_address, sizeof(qpb_bundle_descriptor_v1_t));
+    uint32_t          total_bytes;
+    if (!qpb_read_bundle_descriptor(&stream.base, NULL, &total_bytes)) {
+        qp_dprintf("qp_flash_bundle_find: fail (invalid bundle)\n");
+        return false;
+    }
+    stream.length = total_bytes;
+
+    uint32_t offset;
+    if (!qpb_find_asset(&stream.base, name, &offset, NULL)) {
+        qp_dprintf("qp_flash_bundle_find: fail (asset not found)\n");
+        return false;
+    }
+
+    if (address) {
+        *address = bundle_address + offset;
+    }
+    return true;
+}
+#endif // FLASH_ENABLE
@@ -0,0 +1,62 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+// Quantum Painter Bundle "QPB" File Format.
+// See https://docs.qmk.fm/#/quantum_painter_qpb for more information.
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "qp_stream.h"
+#include "qp_internal.h"
+#include "qgf.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// QPB structures
+
+/////////////////////////////////////////
+// Bundle descriptor
+
+#define QPB_BUNDLE_DESCRIPTOR_TYPEID 0x00
+
+typedef struct QP_PACKED qpb_bundle_descriptor_v1_t {
+    qgf_block_header_v1_t header;              // = { .type_id = 0x00, .neg_type_id = (~0x00), .length = 14 }
+    uint32_t              magic : 24;          // constant, equal to 0x425051 ("QPB")
+    uint8_t               qpb_version;         // constant, equal to 0x01
+    uint32_t              total_file_size;     // total size of the entire bundle, starting at offset zero
+    uint32_t              neg_total_file_size; // negated value of total_file_size, used for detecting parsing errors
+    uint16_t              asset_count;         // the number of assets in the asset table
+} qpb_bundle_descriptor_v1_t;
+
+_Static_assert(sizeof(qpb_bundle_descriptor_v1_t) == (sizeof(qgf_block_header_v1_t) + 14), "qpb_bundle_descriptor_v1_t must be 19 bytes in v1 of QPB");
+
+#define QPB_MAGIC 0x425051
+
+/////////////////////////////////////////
+// Asset table descriptor
+
+#define QPB_ASSET_TABLE_DESCRIPTOR_TYPEID 0x01
+
+typedef struct QP_PACKED qpb_asset_v1_t {
+    uint32_t name_hash; // 32-bit FNV-1a hash of the asset name
+    uint32_t offset;    // offset of the asset data, relative to the start of the bundle
+    uint32_t length;    // length of the asset data
+} qpb_asset_v1_t;
+
+_Static_assert(sizeof(qpb_asset_v1_t) == 12, "qpb_asset_v1_t must be 12 bytes in v1 of QPB");
+
+typedef struct QP_PACKED qpb_asset_table_v1_t {
+    qgf_block_header_v1_t header;   // = { .type_id = 0x01, .neg_type_id = (~0x01), .length = (N * 12) }
+    qpb_asset_v1_t        asset[0]; // Zero-length because there's a variable number of assets
+} qpb_asset_table_v1_t;
+
+_Static_assert(sizeof(qpb_asset_table_v1_t) == sizeof(qgf_block_header_v1_t), "qpb_asset_table_v1_t must only contain qgf_block_header_v1_t in v1 of QPB");
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// QPB API
+
+uint32_t qpb_hash_name(const char *name);
+bool     qpb_read_bundle_descriptor(qp_stream_t *stream, uint16_t *asset_count, uint32_t *total_bytes);
+bool     qpb_find_asset(qp_stream_t *stream, const char *name, uint32_t *offset, uint32_t *length);
@@ -7,6 +7,9 @@ QUANTUM_PAINTER_LVGL_INTEGRATION ?= no
 # The list of permissible drivers that can be listed in QUANTUM_PAINTER_DRIVERS
 VALID_QUANTUM_PAINTER_DRIVERS := \
 	rgb565_surface \
+	rgb888_surface \
+	mono1bpp_surface \
+	palette_surface \
 	ili9163_spi \
 	ili9341_spi \
 	ili9488_spi \
@@ -25,13 +28,16 @@ SRC += \
     $(QUANTUM_DIR)/color.c \
     $(QUANTUM_DIR)/painter/qp.c \
     $(QUANTUM_DIR)/painter/qp_internal.c \
+    $(QUANTUM_DIR)/painter/qp_comms.c \
     $(QUANTUM_DIR)/painter/qp_stream.c \
     $(QUANTUM_DIR)/painter/qgf.c \
     $(QUANTUM_DIR)/painter/qff.c \
+    $(QUANTUM_DIR)/painter/qpb.c \
     $(QUANTUM_DIR)/painter/qp_draw_core.c \
     $(QUANTUM_DIR)/painter/qp_draw_codec.c \
     $(QUANTUM_DIR)/painter/qp_draw_circle.c \
     $(QUANTUM_DIR)/painter/qp_draw_ellipse.c \
+    $(QUANTUM_DIR)/painter/qp_draw_polygon.c \
     $(QUANTUM_DIR)/painter/qp_draw_image.c \
     $(QUANTUM_DIR)/painter/qp_draw_text.c
 
@@ -44,6 +50,9 @@ endif
 # Comms flags
 QUANTUM_PAINTER_NEEDS_COMMS_SPI ?= no
 
+# Surface flags
+QUANTUM_PAINTER_NEEDS_SURFACE ?= no
+
 # Handler for each driver
 define handle_quantum_painter_driver
     CURRENT_PAINTER_DRIVER := $1
@@ -52,12 +61,29 @@ define handle_quantum_painter_driver
         $$(error "$$(CURRENT_PAINTER_DRIVER)" is not a valid Quantum Painter driver)
 
     else ifeq ($$(strip $$(CURRENT_PAINTER_DRIVER)),rgb565_surface)
+        QUANTUM_PAINTER_NEEDS_SURFACE := yes
         OPT_DEFS += -DQUANTUM_PAINTER_RGB565_SURFACE_ENABLE
-        COMMON_VPATH += \
-            $(DRIVER_PATH)/painter/generic
         SRC += \
             $(DRIVER_PATH)/painter/generic/qp_rgb565_surface.c \
 
+    else ifeq ($$(strip $$(CURRENT_PAINTER_DRIVER)),rgb888_surface)
+        QUANTUM_PAINTER_NEEDS_SURFACE := yes
+        OPT_DEFS += -DQUANTUM_PAINTER_RGB888_SURFACE_ENABLE
+        SRC += \
+            $(DRIVER_PATH)/painter/generic/qp_rgb888_surface.c \
+
+    else ifeq ($$(strip $$(CURRENT_PAINTER_DRIVER)),mono1bpp_surface)
+        QUANTUM_PAINTER_NEEDS_SURFACE := yes
+        OPT_DEFS += -DQUANTUM_PAINTER_MONO1BPP_SURFACE_ENABLE
+        SRC += \
+            $(DRIVER_PATH)/painter/generic/qp_mono1bpp_surface.c \
+
+    else ifeq ($$(strip $$(CURRENT_PAINTER_DRIVER)),palette_surface)
+        QUANTUM_PAINTER_NEEDS_SURFACE := yes
+        OPT_DEFS += -DQUANTUM_PAINTER_PALETTE_SURFACE_ENABLE
+        SRC += \
+            $(DRIVER_PATH)/painter/generic/qp_palette_surface.c \
+
     else ifeq ($$(strip $$(CURRENT_PAINTER_DRIVER)),ili9163_spi)
         QUANTUM_PAINTER_NEEDS_COMMS_SPI := yes
         QUANTUM_PAINTER_NEEDS_COMMS_SPI_DC_RESET := yes
@@ -141,13 +167,20 @@ endef
 # Iterate through the listed drivers for the build, including what's necessary
 $(foreach qp_driver,$(QUANTUM_PAINTER_DRIVERS),$(eval $(call handle_quantum_painter_driver,$(qp_driver))))
 
+# If any surfaces are in use, set up the common files
+ifeq ($(strip $(QUANTUM_PAINTER_NEEDS_SURFACE)), yes)
+    OPT_DEFS += -DQUANTUM_PAINTER_SURFACE_ENABLE
+    COMMON_VPATH += $(DRIVER_PATH)/painter/generic
+    SRC += \
+        $(DRIVER_PATH)/painter/generic/qp_surface_common.c
+endif
+
 # If SPI comms is needed, set up the required files
 ifeq ($(strip $(QUANTUM_PAINTER_NEEDS_COMMS_SPI)), yes)
     OPT_DEFS += -DQUANTUM_PAINTER_SPI_ENABLE
     QUANTUM_LIB_SRC += spi_master.c
     VPATH += $(DRIVER_PATH)/painter/comms
     SRC += \
-        $(QUANTUM_DIR)/painter/qp_comms.c \
         $(DRIVER_PATH)/painter/comms/qp_comms_spi.c
 
     ifeq ($(strip $(QUANTUM_PAINTER_NEEDS_COMMS_SPI_DC_RESET)), yes)
@@ -0,0 +1,25 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+// The host's stdio.h needs to be seen before QMK's logging redefines dprintf
+#include <stdio.h>
+
+#define MATRIX_ROWS 1
+#define MATRIX_COLS 1
+
+// TRUE/FALSE are ChibiOS-isms, not available on the test platform
+#define QUANTUM_PAINTER_SUPPORTS_256_PALETTE 1
+#define QUANTUM_PAINTER_SUPPORTS_NATIVE_COLORS 1
+#define QUANTUM_PAINTER_SUPPORTS_LZ 1
+
+// No matrix scanning, so no activity tracking for the display timeout
+#define QUANTUM_PAINTER_DISPLAY_TIMEOUT 0
+
+// A handful of cache entries, sized so that the 6x11 test font fits when rendered as RGB565 (132 bytes per glyph) but
+// not as RGB888 (198 bytes per glyph)
+#define QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES 8
+#define QUANTUM_PAINTER_GLYPH_CACHE_ENTRY_SIZE 160
+
+// Two RGB888 surfaces, so that copies between surfaces of the same format can be tested
+#define RGB888_SURFACE_NUM_DEVICES 2
@@ -0,0 +1,81 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include "painter_test_common.h"
+
+#include <chrono>
+
+// Not a pass/fail test -- reports the decode throughput on the host and the amount of traffic each operation would
+// generate on a real display, so the effect of changes to the codecs and draw routines can be compared without
+// hardware. Only the traffic figures are deterministic; throughput depends on the machine running the tests. Disabled
+// in the regular run, use --gtest_also_run_disabled_tests --gtest_filter='PainterBenchmark.*' to run it.
+
+#ifndef PAINTER_BENCHMARK_ITERATIONS
+#    define PAINTER_BENCHMARK_ITERATIONS 200
+#endif
+
+class PainterBenchmark : public PainterTest {
+   protected:
+    template <typename F>
+    void run(const char *name, uint32_t pixels_per_op, F &&op) {
+        stats   = {};
+        auto t0 = std::chrono::steady_clock::now();
+        for (int i = 0; i < PAINTER_BENCHMARK_ITERATIONS; ++i) {
+            ASSERT_TRUE(op()) << name;
+        }
+        double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+        printf("%-28s %12.0f px/s %10.1f bytes/op %8.1f viewports/op %8.1f pixdata/op\n", name, (double)pixels_per_op * PAINTER_BENCHMARK_ITERATIONS / secs, (double)stats.pixdata_bytes / PAINTER_BENCHMARK_ITERATIONS, (double)stats.viewport_calls / PAINTER_BENCHMARK_ITERATIONS, (double)stats.pixdata_calls / PAINTER_BENCHMARK_ITERATIONS);
+    }
+
+    void run_image(const char *filename) {
+        painter_image_handle_t image = qp_load_image_file(filename);
+        ASSERT_NE(image, nullptr) << filename;
+        const char *name = strrchr(filename, '/') + 1;
+        run(name, (uint32_t)image->width * image->height, [&] { return qp_drawimage(device, 0, 0, image); });
+        qp_close_image(image);
+    }
+};
+
+TEST_F(PainterBenchmark, DISABLED_Images) {
+    // clang-format off
+    static const char *images[] = {
+        PAINTER_TEST_ASSET("test-image-mono2.qgf"),
+        PAINTER_TEST_ASSET("test-image-mono4.qgf"),
+        PAINTER_TEST_ASSET("test-image-mono4-rle.qgf"),
+        PAINTER_TEST_ASSET("test-image-mono16.qgf"),
+        PAINTER_TEST_ASSET("test-image-mono16-rle.qgf"),
+        PAINTER_TEST_ASSET("test-image-pal16.qgf"),
+        PAINTER_TEST_ASSET("test-image-pal16-rle.qgf"),
+        PAINTER_TEST_ASSET("test-image-pal256.qgf"),
+        PAINTER_TEST_ASSET("test-image-pal256-rle.qgf"),
+        PAINTER_TEST_ASSET("test-image-rgb565.qgf"),
+        PAINTER_TEST_ASSET("test-image-rgb565-rle.qgf"),
+        PAINTER_TEST_ASSET("test-image-rgb565-lz.qgf"),
+    };
+    // clang-format on
+    for (const char *filename : images) {
+        run_image(filename);
+    }
+}
+
+TEST_F(PainterBenchmark, DISABLED_Fonts) {
+    static const char *fonts[] = {PAINTER_TEST_ASSET("test-font-mono2.qff"), PAINTER_TEST_ASSET("test-font-mono4-rle.qff")};
+    static const char *text    = "Hello, QMK!";
+    for (const char *filename : fonts) {
+        painter_font_handle_t font = qp_load_font_file(filename);
+        ASSERT_NE(font, nullptr) << filename;
+        run(strrchr(filename, '/') + 1, (uint32_t)qp_textwidth(font, text) * font->line_height, [&] { return qp_drawtext(device, 0, 0, font, text) > 0; });
+        qp_close_font(font);
+    }
+}
+
+TEST_F(PainterBenchmark, DISABLED_Primitives) {
+    static const painter_point_t star[] = {{24, 0}, {30, 18}, {47, 18}, {33, 29}, {38, 47}, {24, 36}, {9, 47}, {14, 29}, {0, 18}, {17, 18}};
+    run("rect (filled)", 48 * 32, [&] { return qp_rect(device, 8, 8, 55, 39, HSV_RED, true); });
+    run("rounded rect (filled)", 48 * 32, [&] { return qp_rounded_rect(device, 8, 8, 55, 39, 6, HSV_RED, true); });
+    run("circle (filled)", 47 * 47, [&] { return qp_circle(device, 32, 24, 23, HSV_GREEN, true); });
+    run("circle", 47 * 47, [&] { return qp_circle(device, 32, 24, 23, HSV_GREEN, false); });
+    run("ellipse (filled)", 61 * 41, [&] { return qp_ellipse(device, 32, 24, 30, 20, HSV_BLUE, true); });
+    run("polygon (filled)", 48 * 48, [&] { return qp_polygon(device, star, sizeof(star) / sizeof(star[0]), HSV_YELLOW, true); });
+    run("line (diagonal)", 64, [&] { return qp_line(device, 0, 0, 63, 47, HSV_WHITE); });
+}
@@ -0,0 +1,84 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include "painter_test_common.h"
+
+#include <cstdlib>
+
+painter_comms_stats_t PainterTest::stats;
+
+static uint16_t                      framebuffer[PainterTest::width * PainterTest::height];
+static painter_device_t              surface;
+static const painter_driver_vtable_t *surface_vtable;
+static painter_driver_vtable_t        counting_vtable;
+
+static bool counting_viewport(painter_device_t device, uint16_t left, uint16_t top, uint16_t right, uint16_t bottom) {
+    ++PainterTest::stats.viewport_calls;
+    return surface_vtable->viewport(device, left, top, right, bottom);
+}
+
+static bool counting_pixdata(painter_device_t device, const void *pixel_data, uint32_t native_pixel_count) {
+    painter_driver_t *driver = (painter_driver_t *)device;
+    ++PainterTest::stats.pixdata_calls;
+    PainterTest::stats.pixdata_bytes += (uint64_t)native_pixel_count * driver->native_bits_per_pixel / 8;
+    return surface_vtable->pixdata(device, pixel_data, native_pixel_count);
+}
+
+void PainterTest::SetUp() {
+    // Surfaces come from a static pool, so the one surface is shared by all tests
+    if (!surface) {
+        surface                  = qp_rgb565_make_surface(width, height, framebuffer);
+        painter_driver_t *driver = (painter_driver_t *)surface;
+        surface_vtable           = driver->driver_vtable;
+        counting_vtable          = *surface_vtable;
+        counting_vtable.viewport = counting_viewport;
+        counting_vtable.pixdata  = counting_pixdata;
+        driver->driver_vtable    = &counting_vtable;
+    }
+    device = surface;
+    ASSERT_TRUE(qp_init(device, QP_ROTATION_0));
+    ASSERT_TRUE(qp_clear(device));
+    stats = {};
+    set_time(0);
+}
+
+png_image_t PainterTest::capture() const {
+    surface_painter_device_t *s = (surface_painter_device_t *)device;
+    png_image_t               image;
+    image.width  = width;
+    image.height = height;
+    for (uint32_t i = 0; i < (uint32_t)width * height; ++i) {
+        RGB rgb = s->format->to_rgb(s, s->format->read_pixel(s->buffer, i));
+        image.rgb.push_back(rgb.r);
+        image.rgb.push_back(rgb.g);
+        image.rgb.push_back(rgb.b);
+    }
+    return image;
+}
+
+void PainterTest::expect_golden(const std::string &name) {
+    png_image_t actual = capture();
+    std::string golden = PAINTER_TEST_GOLDEN_PATH + name + ".png";
+
+    const char *update = getenv("QP_UPDATE_GOLDENS");
+    if (update && atoi(update)) {
+        ASSERT_TRUE(png_write(golden, actual)) << "could not write " << golden;
+        return;
+    }
+
+    png_image_t expected;
+    ASSERT_TRUE(png_read(golden, expected)) << "could not read " << golden << ", run with QP_UPDATE_GOLDENS=1 to create it";
+    ASSERT_EQ(expected.width, actual.width);
+    ASSERT_EQ(expected.height, actual.height);
+
+    uint32_t mismatches = 0, first = 0;
+    for (uint32_t i = 0; i < actual.width * actual.height; ++i) {
+        if (memcmp(&expected.rgb[i * 3], &actual.rgb[i * 3], 3) != 0 && mismatches++ == 0) {
+            first = i;
+        }
+    }
+    if (mismatches) {
+        std::string output = std::string(PAINTER_TEST_OUTPUT_PATH) + "painter_" + name + ".png";
+        png_write(output, actual);
+        ADD_FAILURE() << name << ": " << mismatches << " pixel(s) differ from " << golden << ", first at (" << first % actual.width << ", " << first / actual.width << "); render written to " << output;
+    }
+}
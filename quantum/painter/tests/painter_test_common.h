@@ -0,0 +1,53 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+#include <string>
+#include "gtest/gtest.h"
+#include "png.h"
+
+extern "C" {
+#include "qp.h"
+#include "qp_internal.h"
+#include "qp_surface_internal.h"
+#include "qp_rgb565_surface.h"
+
+void set_time(uint32_t t);
+void advance_time(uint32_t ms);
+void qp_internal_animation_tick(void);
+}
+
+// Tests are executed from the root of the repository
+#define PAINTER_TEST_ASSET(name) ("quantum/painter/tests/assets/" name)
+#define PAINTER_TEST_GOLDEN_PATH "quantum/painter/tests/golden/"
+// Mismatching renders are written to the build directory, see rules.mk
+#ifndef PAINTER_TEST_OUTPUT_PATH
+#    define PAINTER_TEST_OUTPUT_PATH ::testing::TempDir()
+#endif
+
+// Traffic to the device, as a display driver would have sent it
+struct painter_comms_stats_t {
+    uint32_t viewport_calls;
+    uint32_t pixdata_calls;
+    uint64_t pixdata_bytes;
+};
+
+// Renders into an RGB565 surface, with the driver vtable wrapped so that the traffic can be counted.
+class PainterTest : public ::testing::Test {
+   public:
+    static constexpr uint16_t    width  = 64;
+    static constexpr uint16_t    height = 48;
+    static painter_comms_stats_t stats;
+
+   protected:
+
+    void SetUp() override;
+
+    // Converts the surface contents to 8-bit RGB
+    png_image_t capture() const;
+
+    // Compares the surface with `golden/<name>.png`. Set `QP_UPDATE_GOLDENS=1` to (re)write the goldens instead.
+    void expect_golden(const std::string &name);
+
+    painter_device_t device;
+};
@@ -0,0 +1,504 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include "painter_test_common.h"
+
+// The assets are built from test-image.png, test-anim.gif and test-font.png using `qmk painter-convert-graphics` and
+// `qmk painter-convert-font-image`, with and without `--no-rle`. Goldens are named after the rendering, so encodings of
+// the same pixel format share a golden.
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Primitives
+
+TEST_F(PainterTest, SetPixel) {
+    for (uint16_t y = 0; y < height; y += 3) {
+        for (uint16_t x = y % 2; x < width; x += 2) {
+            EXPECT_TRUE(qp_setpixel(device, x, y, x * 4, 255, 255));
+        }
+    }
+    expect_golden("setpixel");
+}
+
+TEST_F(PainterTest, Line) {
+    EXPECT_TRUE(qp_line(device, 0, 0, 63, 47, HSV_RED));
+    EXPECT_TRUE(qp_line(device, 63, 0, 0, 47, HSV_GREEN));
+    EXPECT_TRUE(qp_line(device, 2, 24, 61, 24, HSV_BLUE));
+    EXPECT_TRUE(qp_line(device, 32, 2, 32, 45, HSV_YELLOW));
+    EXPECT_TRUE(qp_line(device, 5, 40, 60, 30, HSV_WHITE));
+    expect_golden("line");
+}
+
+TEST_F(PainterTest, Rect) {
+    EXPECT_TRUE(qp_rect(device, 2, 2, 29, 21, HSV_RED, false));
+    EXPECT_TRUE(qp_rect(device, 34, 2, 61, 21, HSV_GREEN, true));
+    EXPECT_TRUE(qp_rect(device, 10, 26, 53, 45, HSV_BLUE, true));
+    EXPECT_TRUE(qp_rect(device, 20, 30, 43, 41, HSV_WHITE, false));
+    expect_golden("rect");
+}
+
+TEST_F(PainterTest, RoundedRect) {
+    EXPECT_TRUE(qp_rounded_rect(device, 2, 2, 29, 21, 5, HSV_RED, false));
+    EXPECT_TRUE(qp_rounded_rect(device, 34, 2, 61, 21, 8, HSV_GREEN, true));
+    EXPECT_TRUE(qp_rounded_rect(device, 10, 26, 53, 45, 3, HSV_BLUE, true));
+    expect_golden("rounded_rect");
+}
+
+TEST_F(PainterTest, Circle) {
+    EXPECT_TRUE(qp_circle(device, 16, 16, 14, HSV_RED, false));
+    EXPECT_TRUE(qp_circle(device, 46, 16, 11, HSV_GREEN, true));
+    EXPECT_TRUE(qp_circle(device, 32, 34, 12, HSV_BLUE, true));
+    EXPECT_TRUE(qp_circle(device, 32, 34, 6, HSV_WHITE, false));
+    expect_golden("circle");
+}
+
+TEST_F(PainterTest, Ellipse) {
+    EXPECT_TRUE(qp_ellipse(device, 20, 12, 18, 9, HSV_RED, false));
+    EXPECT_TRUE(qp_ellipse(device, 46, 30, 14, 16, HSV_GREEN, true));
+    EXPECT_TRUE(qp_ellipse(device, 16, 36, 12, 5, HSV_BLUE, true));
+    expect_golden("ellipse");
+}
+
+TEST_F(PainterTest, Polygon) {
+    static const painter_point_t triangle[] = {{4, 44}, {30, 4}, {56, 44}};
+    static const painter_point_t star[]     = {{48, 2}, {52, 14}, {62, 14}, {54, 22}, {58, 34}, {48, 26}, {38, 34}, {42, 22}, {34, 14}, {44, 14}};
+    EXPECT_TRUE(qp_polygon(device, triangle, sizeof(triangle) / sizeof(triangle[0]), HSV_BLUE, true));
+    EXPECT_TRUE(qp_polygon(device, star, sizeof(star) / sizeof(star[0]), HSV_YELLOW, true));
+    EXPECT_TRUE(qp_polygon(device, star, sizeof(star) / sizeof(star[0]), HSV_RED, false));
+    expect_golden("polygon");
+}
+
+TEST_F(PainterTest, Clipping) {
+    // Partially off-screen primitives are clipped, fully off-screen ones draw nothing
+    EXPECT_TRUE(qp_circle(device, 60, 44, 10, HSV_GREEN, true));
+    EXPECT_TRUE(qp_rect(device, 50, 2, 80, 12, HSV_RED, false));
+    EXPECT_TRUE(qp_rect(device, 2, 40, 20, 60, HSV_BLUE, true));
+    EXPECT_TRUE(qp_rect(device, 70, 50, 80, 60, HSV_RED, true));
+    expect_golden("clipping");
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Images
+
+struct painter_image_case_t {
+    const char *filename;
+    const char *golden;
+};
+
+class PainterImageTest : public PainterTest, public ::testing::WithParamInterface<painter_image_case_t> {};
+
+TEST_P(PainterImageTest, Draw) {
+    painter_image_handle_t image = qp_load_image_file(GetParam().filename);
+    ASSERT_NE(image, nullptr);
+    EXPECT_EQ(image->width, 32);
+    EXPECT_EQ(image->height, 24);
+    EXPECT_EQ(image->frame_count, 1);
+
+    // Monochrome images are recolored, the rest are drawn as-is
+    EXPECT_TRUE(qp_drawimage_recolor(device, 4, 4, image, HSV_ORANGE, 0, 0, 48));
+    EXPECT_TRUE(qp_drawimage(device, 28, 20, image));
+    EXPECT_TRUE(qp_close_image(image));
+    expect_golden(GetParam().golden);
+}
+
+// clang-format off
+INSTANTIATE_TEST_CASE_P(
+    Codecs,
+    PainterImageTest,
+    ::testing::Values(
+        painter_image_case_t{PAINTER_TEST_ASSET("test-image-mono2.qgf"), "image_mono2"},
+        painter_image_case_t{PAINTER_TEST_ASSET("test-image-mono4.qgf"), "image_mono4"},
+        painter_image_case_t{PAINTER_TEST_ASSET("test-image-mono4-rle.qgf"), "image_mono4"},
+        painter_image_case_t{PAINTER_TEST_ASSET("test-image-mono16.qgf"), "image_mono16"},
+        painter_image_case_t{PAINTER_TEST_ASSET("test-image-mono16-rle.qgf"), "image_mono16"},
+        painter_image_case_t{PAINTER_TEST_ASSET("test-image-pal16.qgf"), "image_pal16"},
+        painter_image_case_t{PAINTER_TEST_ASSET("test-image-pal16-rle.qgf"), "image_pal16"},
+        painter_image_case_t{PAINTER_TEST_ASSET("test-image-pal256.qgf"), "image_pal256"},
+        painter_image_case_t{PAINTER_TEST_ASSET("test-image-pal256-rle.qgf"), "image_pal256"},
+        painter_image_case_t{PAINTER_TEST_ASSET("test-image-rgb565.qgf"), "image_rgb565"},
+        painter_image_case_t{PAINTER_TEST_ASSET("test-image-rgb565-rle.qgf"), "image_rgb565"},
+        painter_image_case_t{PAINTER_TEST_ASSET("test-image-rgb565-lz.qgf"), "image_rgb565"}
+    ));
+// clang-format on
+
+TEST_F(PainterTest, Animation) {
+    painter_image_handle_t image = qp_load_image_file(PAINTER_TEST_ASSET("test-anim-pal16.qgf"));
+    ASSERT_NE(image, nullptr);
+    ASSERT_EQ(image->frame_count, 4);
+
+    // Later frames are delta frames, so each golden depends on the previous frame having been drawn
+    deferred_token token = qp_animate(device, 16, 12, image);
+    ASSERT_NE(token, INVALID_DEFERRED_TOKEN);
+    for (int frame = 0; frame < image->frame_count; ++frame) {
+        if (frame > 0) {
+            advance_time(100);
+            qp_internal_animation_tick();
+        }
+        expect_golden("anim_" + std::to_string(frame));
+    }
+    qp_stop_animation(token);
+    EXPECT_TRUE(qp_close_image(image));
+}
+
+TEST_F(PainterTest, NativeFormatMismatch) {
+    // Native pixel data is streamed as-is, so it can only be drawn on devices with the same format
+    painter_image_handle_t image = qp_load_image_file(PAINTER_TEST_ASSET("test-image-rgb888.qgf"));
+    ASSERT_NE(image, nullptr);
+    EXPECT_FALSE(qp_drawimage(device, 0, 0, image));
+    EXPECT_EQ(stats.pixdata_bytes, 0);
+    EXPECT_TRUE(qp_close_image(image));
+}
+
+TEST_F(PainterTest, LoadImageFailures) {
+    EXPECT_EQ(qp_load_image_file(PAINTER_TEST_ASSET("does-not-exist.qgf")), nullptr);
+    EXPECT_EQ(qp_load_image_file(PAINTER_TEST_ASSET("test-font-mono2.qff")), nullptr);
+    EXPECT_EQ(qp_load_font_file(PAINTER_TEST_ASSET("test-image-rgb565.qgf")), nullptr);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Fonts
+
+class PainterFontTest : public PainterTest, public ::testing::WithParamInterface<const char *> {};
+
+TEST_P(PainterFontTest, Draw) {
+    painter_font_handle_t font = qp_load_font_file(GetParam());
+    ASSERT_NE(font, nullptr);
+    EXPECT_EQ(font->line_height, 11);
+
+    static const char *lines[] = {"Hi, QMK!", "0123456789", "{[(<>)]}~", "The quick"};
+    for (int i = 0; i < 4; ++i) {
+        int16_t text_width = qp_drawtext_recolor(device, 2, 1 + i * 12, font, lines[i], i * 64, 255, 255, 0, 0, 0);
+        EXPECT_GT(text_width, 0);
+        EXPECT_LE(2 + text_width, (int)width); // glyphs aren't clipped, keep them on-screen
+        EXPECT_EQ(text_width, qp_textwidth(font, lines[i]));
+    }
+    EXPECT_TRUE(qp_close_font(font));
+    expect_golden("font");
+}
+
+// clang-format off
+INSTANTIATE_TEST_CASE_P(
+    Codecs,
+    PainterFontTest,
+    ::testing::Values(
+        PAINTER_TEST_ASSET("test-font-mono2.qff"),
+        PAINTER_TEST_ASSET("test-font-mono4-rle.qff")
+    ));
+// clang-format on
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Surfaces
+
+// Surfaces come from static pools, so each one is only made once and shared between tests
+static painter_device_t test_surface(int which) {
+    static uint8_t   framebuffer888[2][PainterTest::width * PainterTest::height * 3];
+    static uint8_t   framebuffer_mono[PainterTest::width * PainterTest::height / 8];
+    static uint8_t   framebuffer_palette[PainterTest::width * PainterTest::height / 2];
+    static const HSV palette[4] = {{0, 0, 0}, {0, 255, 255}, {85, 255, 255}, {170, 255, 255}};
+
+    static painter_device_t surfaces[4] = {
+        qp_rgb888_make_surface(PainterTest::width, PainterTest::height, framebuffer888[0]),
+        qp_rgb888_make_surface(PainterTest::width, PainterTest::height, framebuffer888[1]),
+        qp_mono1bpp_make_surface(PainterTest::width, PainterTest::height, framebuffer_mono),
+        qp_palette_make_surface(PainterTest::width, PainterTest::height, 4, palette, 4, framebuffer_palette),
+    };
+    return surfaces[which];
+}
+
+#define TEST_SURFACE_RGB888 0
+#define TEST_SURFACE_RGB888_2 1
+#define TEST_SURFACE_MONO1BPP 2
+#define TEST_SURFACE_PALETTE4 3
+
+class PainterSurfaceTest : public PainterTest {
+   protected:
+    void SetUp() override {
+        PainterTest::SetUp();
+        for (int i = 0; i < 4; ++i) {
+            painter_device_t surface = test_surface(i);
+            ASSERT_NE(surface, nullptr);
+            ASSERT_TRUE(qp_init(surface, QP_ROTATION_0));
+            ASSERT_TRUE(qp_clear(surface));
+            ASSERT_TRUE(qp_flush(surface));
+        }
+        device_comms = ((painter_driver_t *)device)->comms_vtable;
+    }
+
+    void TearDown() override {
+        ((painter_driver_t *)device)->comms_vtable = device_comms;
+    }
+
+    // Copies into the test device otherwise take the surface to surface path. With a comms vtable of its own, it is
+    // treated like a panel instead, so copies go through its (counted) viewport and pixdata calls.
+    void as_display() {
+        static painter_comms_vtable_t display_comms;
+        display_comms                              = *device_comms;
+        display_comms.comms_start                  = counting_comms_start;
+        ((painter_driver_t *)device)->comms_vtable = &display_comms;
+        comms_starts                               = 0;
+    }
+
+    static bool counting_comms_start(painter_device_t device) {
+        ++comms_starts;
+        return true;
+    }
+
+    // Renders the expected result by drawing directly on the test device, then clears it again
+    template <typename F>
+    png_image_t reference(F draw) {
+        draw(device);
+        png_image_t image = capture();
+        qp_clear(device);
+        stats = {};
+        return image;
+    }
+
+    uint32_t native_pixel(painter_device_t surface, uint16_t x, uint16_t y) {
+        surface_painter_device_t *s = (surface_painter_device_t *)surface;
+        return s->format->read_pixel(s->buffer, (uint32_t)y * width + x);
+    }
+
+    const painter_comms_vtable_t *device_comms;
+    static uint32_t               comms_starts;
+};
+
+uint32_t PainterSurfaceTest::comms_starts;
+
+TEST_F(PainterSurfaceTest, DirtyRegions) {
+    painter_device_t surface  = test_surface(TEST_SURFACE_RGB888);
+    png_image_t      expected = reference([](painter_device_t d) {
+        qp_setpixel(d, 1, 1, 0, 255, 255);
+        qp_setpixel(d, 60, 40, 85, 255, 255);
+    });
+
+    // Changes far apart are transferred separately, rather than as the rectangle spanning both
+    as_display();
+    qp_setpixel(surface, 1, 1, 0, 255, 255);
+    qp_setpixel(surface, 60, 40, 85, 255, 255);
+    ASSERT_TRUE(qp_surface_draw(surface, device, 0, 0));
+    EXPECT_EQ(stats.viewport_calls, 2u);
+    EXPECT_EQ(stats.pixdata_bytes, 2u * 2);
+    EXPECT_EQ(comms_starts, 1u); // within a single comms session
+    EXPECT_EQ(capture().rgb, expected.rgb);
+
+    // Nothing left to transfer
+    stats = {};
+    ASSERT_TRUE(qp_surface_draw(surface, device, 0, 0));
+    EXPECT_EQ(stats.viewport_calls, 0u);
+}
+
+TEST_F(PainterSurfaceTest, DirtyRegionsMerge) {
+    static_assert(SURFACE_NUM_DIRTY_RECTS == 4 && SURFACE_DIRTY_MERGE_DISTANCE == 8, "test expects the default dirty region configuration");
+    painter_device_t surface = test_surface(TEST_SURFACE_RGB888);
+    as_display();
+
+    // Changes close to each other share a region
+    qp_setpixel(surface, 10, 10, 0, 255, 255);
+    qp_setpixel(surface, 12, 12, 0, 255, 255);
+    ASSERT_TRUE(qp_surface_draw(surface, device, 0, 0));
+    EXPECT_EQ(stats.viewport_calls, 1u);
+    EXPECT_EQ(stats.pixdata_bytes, 3u * 3 * 2);
+
+    // Once all regions are in use, further changes are merged into the closest one
+    stats = {};
+    qp_setpixel(surface, 0, 0, 0, 255, 255);
+    qp_setpixel(surface, 20, 0, 0, 255, 255);
+    qp_setpixel(surface, 40, 0, 0, 255, 255);
+    qp_setpixel(surface, 60, 0, 0, 255, 255);
+    qp_setpixel(surface, 0, 40, 0, 255, 255);
+    ASSERT_TRUE(qp_surface_draw(surface, device, 0, 0));
+    EXPECT_EQ(stats.viewport_calls, 4u);
+}
+
+TEST_F(PainterSurfaceTest, BlitClipping) {
+    painter_device_t surface  = test_surface(TEST_SURFACE_RGB888);
+    png_image_t      expected = reference([](painter_device_t d) {
+        qp_rect(d, 0, 44, 4, 47, 0, 255, 255, true);
+        qp_rect(d, 59, 0, 63, 4, 0, 255, 255, true);
+    });
+
+    // Copies hanging off the target's edges keep only the part that is on it
+    ASSERT_TRUE(qp_rect(surface, 0, 0, 9, 4, 0, 255, 255, true));
+    ASSERT_TRUE(qp_surface_blit(surface, device, 0, 0, 9, 4, -5, 44));
+    ASSERT_TRUE(qp_surface_blit(surface, device, 0, 0, 9, 4, 59, 0));
+    EXPECT_EQ(capture().rgb, expected.rgb);
+}
+
+TEST_F(PainterSurfaceTest, SameFormat) {
+    painter_device_t surface  = test_surface(TEST_SURFACE_RGB888);
+    painter_device_t copy     = test_surface(TEST_SURFACE_RGB888_2);
+    png_image_t      expected = reference([](painter_device_t d) { qp_circle(d, 20, 20, 10, 170, 255, 255, true); });
+
+    ASSERT_TRUE(qp_circle(surface, 20, 20, 10, 170, 255, 255, true));
+    ASSERT_TRUE(qp_surface_draw(surface, copy, 0, 0));
+    for (uint16_t y = 0; y < height; ++y) {
+        for (uint16_t x = 0; x < width; ++x) {
+            ASSERT_EQ(native_pixel(copy, x, y), native_pixel(surface, x, y)) << "at (" << x << ", " << y << ")";
+        }
+    }
+
+    as_display();
+    ASSERT_TRUE(qp_surface_draw(copy, device, 0, 0));
+    EXPECT_EQ(capture().rgb, expected.rgb);
+}
+
+TEST_F(PainterSurfaceTest, Mono1bpp) {
+    painter_device_t surface  = test_surface(TEST_SURFACE_MONO1BPP);
+    png_image_t      expected = reference([](painter_device_t d) {
+        qp_rect(d, 0, 0, 15, 7, 0, 0, 255, true);
+        qp_rect(d, 32, 0, 47, 7, 0, 0, 255, true);
+    });
+
+    // Colors are reduced to black or white by their brightness
+    ASSERT_TRUE(qp_rect(surface, 0, 0, 15, 7, 0, 0, 255, true));
+    ASSERT_TRUE(qp_rect(surface, 16, 0, 31, 7, 0, 0, 64, true));
+    ASSERT_TRUE(qp_rect(surface, 32, 0, 47, 7, 85, 255, 255, true));
+    EXPECT_EQ(native_pixel(surface, 0, 0), 1u);
+    EXPECT_EQ(native_pixel(surface, 16, 0), 0u);
+    EXPECT_EQ(native_pixel(surface, 32, 0), 1u);
+
+    as_display();
+    ASSERT_TRUE(qp_surface_draw(surface, device, 0, 0));
+    EXPECT_EQ(capture().rgb, expected.rgb);
+
+    // ...including when copied into from another surface
+    ASSERT_TRUE(qp_clear(surface));
+    ASSERT_TRUE(qp_surface_blit(test_surface(TEST_SURFACE_RGB888), surface, 0, 0, width - 1, height - 1, 0, 0));
+    EXPECT_EQ(native_pixel(surface, 0, 0), 0u);
+}
+
+TEST_F(PainterSurfaceTest, Palette) {
+    painter_device_t surface  = test_surface(TEST_SURFACE_PALETTE4);
+    png_image_t      expected = reference([](painter_device_t d) {
+        qp_rect(d, 0, 0, 9, 9, 85, 255, 255, true);
+        qp_rect(d, 10, 0, 19, 9, 170, 255, 255, true);
+    });
+
+    // Colors are stored as the index of the closest palette entry
+    ASSERT_TRUE(qp_rect(surface, 0, 0, 9, 9, 85, 255, 255, true));
+    ASSERT_TRUE(qp_rect(surface, 10, 0, 19, 9, 170, 255, 255, true));
+    EXPECT_EQ(native_pixel(surface, 0, 0), 2u);
+    EXPECT_EQ(native_pixel(surface, 10, 0), 3u);
+    EXPECT_EQ(native_pixel(surface, 20, 0), 0u);
+
+    // Copies to a surface convert each pixel...
+    ASSERT_TRUE(qp_surface_blit(surface, device, 0, 0, width - 1, height - 1, 0, 0));
+    EXPECT_EQ(capture().rgb, expected.rgb);
+
+    // ...whereas copies to a panel look up the converted palette
+    ASSERT_TRUE(qp_clear(device));
+    as_display();
+    ASSERT_TRUE(qp_surface_draw(surface, device, 0, 0));
+    EXPECT_EQ(capture().rgb, expected.rgb);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Glyph cache
+
+// Glyphs are only decoded from the font on a cache miss. These tests blank out the font's glyph data after drawing,
+// so that anything served from the cache still renders, whereas anything decoded afresh comes out empty.
+class PainterGlyphCacheTest : public PainterTest {
+   protected:
+    void SetUp() override {
+        PainterTest::SetUp();
+        FILE *f = fopen(PAINTER_TEST_ASSET("test-font-mono2.qff"), "rb");
+        ASSERT_NE(f, nullptr);
+        uint8_t buf[256];
+        size_t  n;
+        while ((n = fread(buf, 1, sizeof(buf), f)) > 0) {
+            font_data.insert(font_data.end(), buf, buf + n);
+        }
+        fclose(f);
+        font = qp_load_font_mem(font_data.data());
+        ASSERT_NE(font, nullptr);
+    }
+
+    void TearDown() override {
+        EXPECT_TRUE(qp_close_font(font));
+    }
+
+    // Zeroes the glyph data, which is held in the last block of the font. Block headers are the type, the negated type
+    // and a 24-bit little-endian length.
+    void blank_glyphs() {
+        size_t offset = 0;
+        size_t data   = 0;
+        while (offset + 5 <= font_data.size()) {
+            uint32_t length = font_data[offset + 2] | (font_data[offset + 3] << 8) | (font_data[offset + 4] << 16);
+            data            = offset + 5;
+            offset          = data + length;
+        }
+        std::fill(font_data.begin() + data, font_data.end(), 0);
+    }
+
+    // Draws a string in the test colors, returning the rendered surface with the drawing cleared away again
+    png_image_t draw(const char *str, uint8_t hue = 0) {
+        stats = {};
+        EXPECT_EQ(qp_drawtext_recolor(device, 2, 2, font, str, hue, 255, 255, 0, 0, 0), qp_textwidth(font, str));
+        png_image_t image = capture();
+        qp_clear(device);
+        return image;
+    }
+
+    std::vector<uint8_t>  font_data;
+    painter_font_handle_t font;
+};
+
+TEST_F(PainterGlyphCacheTest, Hit) {
+    png_image_t expected = draw("Hi, QMK!");
+    EXPECT_EQ(stats.viewport_calls, 1u); // all glyphs cached, so the string is sent in one go
+    blank_glyphs();
+    EXPECT_EQ(draw("Hi, QMK!").rgb, expected.rgb);
+    EXPECT_EQ(stats.viewport_calls, 1u);
+}
+
+TEST_F(PainterGlyphCacheTest, Miss) {
+    png_image_t blank = capture();
+    draw("QMK");
+    blank_glyphs();
+    // Different glyphs, and the same glyphs in a different color, both need decoding from the font
+    EXPECT_EQ(draw("qmk").rgb, blank.rgb);
+    EXPECT_EQ(draw("QMK", 128).rgb, blank.rgb);
+}
+
+TEST_F(PainterGlyphCacheTest, Eviction) {
+    static_assert(QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES == 8, "test expects an 8-entry cache");
+    png_image_t blank    = capture();
+    png_image_t expected = draw("CDEFGH");
+    draw("ABCDEFGH");
+    draw("CDEFGH");
+    // The cache is full, so the two least-recently-used glyphs make way
+    draw("IJ");
+    blank_glyphs();
+    EXPECT_EQ(draw("CDEFGH").rgb, expected.rgb);
+    EXPECT_EQ(draw("A").rgb, blank.rgb);
+    EXPECT_EQ(draw("B").rgb, blank.rgb);
+}
+
+TEST_F(PainterGlyphCacheTest, TooManyGlyphs) {
+    // More distinct glyphs than cache entries can't be sent as a single transfer, so fall back to one per glyph
+    png_image_t expected = draw("0123456789");
+    EXPECT_EQ(stats.viewport_calls, 10u);
+    draw("0123");
+    draw("4567");
+    draw("89");
+    EXPECT_EQ(draw("0123456789").rgb, expected.rgb);
+}
+
+TEST_F(PainterGlyphCacheTest, Oversized) {
+    // The glyphs don't fit in a cache entry at 24bpp, so they're decoded every time they're drawn
+    painter_device_t surface888 = test_surface(TEST_SURFACE_RGB888);
+    ASSERT_NE(surface888, nullptr);
+    ASSERT_TRUE(qp_init(surface888, QP_ROTATION_0));
+    ASSERT_TRUE(qp_clear(surface888));
+
+    png_image_t expected = draw("QMK");
+    EXPECT_EQ(qp_drawtext_recolor(surface888, 2, 2, font, "QMK", 0, 255, 255, 0, 0, 0), qp_textwidth(font, "QMK"));
+    ASSERT_TRUE(qp_surface_draw(surface888, device, 0, 0));
+    EXPECT_EQ(capture().rgb, expected.rgb);
+
+    blank_glyphs();
+    ASSERT_TRUE(qp_clear(surface888));
+    ASSERT_TRUE(qp_clear(device));
+    png_image_t blank = capture();
+    qp_drawtext_recolor(surface888, 2, 2, font, "QMK", 0, 255, 255, 0, 0, 0);
+    ASSERT_TRUE(qp_surface_draw(surface888, device, 0, 0));
+    EXPECT_EQ(capture().rgb, blank.rgb);
+}
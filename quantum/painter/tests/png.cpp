@@ -0,0 +1,175 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include "png.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+namespace {
+
+const uint8_t png_signature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+
+uint32_t crc32(const uint8_t *data, size_t length, uint32_t crc = 0) {
+    crc = ~crc;
+    for (size_t i = 0; i < length; ++i) {
+        crc ^= data[i];
+        for (int k = 0; k < 8; ++k) {
+            crc = (crc >> 1) ^ (0xEDB88320 & (0 - (crc & 1)));
+        }
+    }
+    return ~crc;
+}
+
+uint32_t adler32(const std::vector<uint8_t> &data) {
+    uint32_t a = 1, b = 0;
+    for (uint8_t v : data) {
+        a = (a + v) % 65521;
+        b = (b + a) % 65521;
+    }
+    return (b << 16) | a;
+}
+
+void put_be32(std::vector<uint8_t> &out, uint32_t v) {
+    out.push_back(v >> 24);
+    out.push_back(v >> 16);
+    out.push_back(v >> 8);
+    out.push_back(v);
+}
+
+uint32_t get_be32(const uint8_t *p) {
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+}
+
+void put_chunk(std::vector<uint8_t> &out, const char *type, const std::vector<uint8_t> &data) {
+    put_be32(out, data.size());
+    size_t start = out.size();
+    out.insert(out.end(), type, type + 4);
+    out.insert(out.end(), data.begin(), data.end());
+    put_be32(out, crc32(&out[start], out.size() - start));
+}
+
+} // namespace
+
+bool png_write(const std::string &filename, const png_image_t &image) {
+    // Raw scanlines, each prefixed with filter type 0
+    std::vector<uint8_t> raw;
+    for (uint32_t y = 0; y < image.height; ++y) {
+        raw.push_back(0);
+        raw.insert(raw.end(), &image.rgb[y * image.width * 3], &image.rgb[(y + 1) * image.width * 3]);
+    }
+
+    // zlib stream made of stored deflate blocks
+    std::vector<uint8_t> idat = {0x78, 0x01};
+    for (size_t offset = 0;;) {
+        uint16_t len   = (uint16_t)std::min<size_t>(raw.size() - offset, 65535);
+        bool     final = offset + len == raw.size();
+        idat.push_back(final ? 1 : 0);
+        idat.push_back(len & 0xFF);
+        idat.push_back(len >> 8);
+        idat.push_back(~len & 0xFF);
+        idat.push_back((~len >> 8) & 0xFF);
+        idat.insert(idat.end(), raw.begin() + offset, raw.begin() + offset + len);
+        offset += len;
+        if (final) {
+            break;
+        }
+    }
+    put_be32(idat, adler32(raw));
+
+    std::vector<uint8_t> ihdr;
+    put_be32(ihdr, image.width);
+    put_be32(ihdr, image.height);
+    ihdr.insert(ihdr.end(), {8, 2, 0, 0, 0}); // 8-bit, RGB, deflate, no filtering, no interlace
+
+    std::vector<uint8_t> out(png_signature, png_signature + sizeof(png_signature));
+    put_chunk(out, "IHDR", ihdr);
+    put_chunk(out, "IDAT", idat);
+    put_chunk(out, "IEND", {});
+
+    FILE *f = fopen(filename.c_str(), "wb");
+    if (!f) {
+        return false;
+    }
+    bool ok = fwrite(out.data(), 1, out.size(), f) == out.size();
+    fclose(f);
+    return ok;
+}
+
+bool png_read(const std::string &filename, png_image_t &image) {
+    FILE *f = fopen(filename.c_str(), "rb");
+    if (!f) {
+        return false;
+    }
+    std::vector<uint8_t> in;
+    uint8_t              buf[4096];
+    size_t               n;
+    while ((n = fread(buf, 1, sizeof(buf), f)) > 0) {
+        in.insert(in.end(), buf, buf + n);
+    }
+    fclose(f);
+
+    if (in.size() < sizeof(png_signature) || memcmp(in.data(), png_signature, sizeof(png_signature)) != 0) {
+        return false;
+    }
+
+    // Gather the IHDR and the concatenated IDAT payloads
+    std::vector<uint8_t> zlib;
+    bool                 have_header = false;
+    for (size_t pos = sizeof(png_signature); pos + 12 <= in.size();) {
+        uint32_t       len  = get_be32(&in[pos]);
+        const uint8_t *type = &in[pos + 4];
+        const uint8_t *data = &in[pos + 8];
+        if (pos + 12 + len > in.size()) {
+            return false;
+        }
+        if (memcmp(type, "IHDR", 4) == 0) {
+            // Only 8-bit RGB, non-interlaced
+            if (len != 13 || data[8] != 8 || data[9] != 2 || data[12] != 0) {
+                return false;
+            }
+            image.width  = get_be32(&data[0]);
+            image.height = get_be32(&data[4]);
+            have_header  = true;
+        } else if (memcmp(type, "IDAT", 4) == 0) {
+            zlib.insert(zlib.end(), data, data + len);
+        } else if (memcmp(type, "IEND", 4) == 0) {
+            break;
+        }
+        pos += 12 + len;
+    }
+    if (!have_header || zlib.size() < 2) {
+        return false;
+    }
+
+    // Unpack the stored deflate blocks
+    std::vector<uint8_t> raw;
+    for (size_t pos = 2;;) {
+        if (pos + 5 > zlib.size()) {
+            return false;
+        }
+        uint8_t  hdr = zlib[pos];
+        uint16_t len = zlib[pos + 1] | (zlib[pos + 2] << 8);
+        if ((hdr & 0x06) != 0 || pos + 5 + len > zlib.size()) {
+            return false; // compressed blocks are unsupported
+        }
+        raw.insert(raw.end(), zlib.begin() + pos + 5, zlib.begin() + pos + 5 + len);
+        pos += 5 + len;
+        if (hdr & 0x01) {
+            break;
+        }
+    }
+
+    size_t stride = image.width * 3 + 1;
+    if (raw.size() != stride * image.height) {
+        return false;
+    }
+    image.rgb.clear();
+    for (uint32_t y = 0; y < image.height; ++y) {
+        if (raw[y * stride] != 0) {
+            return false; // filtered scanlines are unsupported
+        }
+        image.rgb.insert(image.rgb.end(), raw.begin() + y * stride + 1, raw.begin() + (y + 1) * stride);
+    }
+    return true;
+}
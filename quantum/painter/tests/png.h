@@ -0,0 +1,19 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Minimal PNG support for golden images: 8-bit RGB, no filtering, uncompressed ("stored") deflate blocks. Goldens are
+// written by the tests themselves so the reader only needs to understand what the writer produces, which keeps zlib out
+// of the test harness.
+struct png_image_t {
+    uint32_t             width  = 0;
+    uint32_t             height = 0;
+    std::vector<uint8_t> rgb; // width * height * 3 bytes, row-major
+};
+
+bool png_write(const std::string &filename, const png_image_t &image);
+bool png_read(const std::string &filename, png_image_t &image);
@@ -0,0 +1,45 @@
+painter_DEFS := \
+	-DQUANTUM_PAINTER_ENABLE \
+	-DQUANTUM_PAINTER_SURFACE_ENABLE \
+	-DQUANTUM_PAINTER_RGB565_SURFACE_ENABLE \
+	-DQUANTUM_PAINTER_RGB888_SURFACE_ENABLE \
+	-DQUANTUM_PAINTER_MONO1BPP_SURFACE_ENABLE \
+	-DQUANTUM_PAINTER_PALETTE_SURFACE_ENABLE \
+	-DQUANTUM_PAINTER_ANIMATIONS_ENABLE \
+	-DQP_STREAM_HAS_FILE_IO \
+	-DDEFERRED_EXEC_ENABLE \
+	-DPAINTER_TEST_OUTPUT_PATH=\"$(BUILD_DIR)/test/\"
+painter_INC := \
+	$(QUANTUM_PATH)/painter \
+	$(QUANTUM_PATH)/unicode \
+	$(DRIVER_PATH)/painter/generic
+painter_CONFIG := $(QUANTUM_PATH)/painter/tests/config_mock.h
+
+painter_SRC := \
+	platforms/test/timer.c \
+	$(QUANTUM_PATH)/color.c \
+	$(QUANTUM_PATH)/deferred_exec.c \
+	$(QUANTUM_PATH)/unicode/utf8.c \
+	$(QUANTUM_PATH)/painter/qp.c \
+	$(QUANTUM_PATH)/painter/qp_internal.c \
+	$(QUANTUM_PATH)/painter/qp_comms.c \
+	$(QUANTUM_PATH)/painter/qp_stream.c \
+	$(QUANTUM_PATH)/painter/qgf.c \
+	$(QUANTUM_PATH)/painter/qff.c \
+	$(QUANTUM_PATH)/painter/qpb.c \
+	$(QUANTUM_PATH)/painter/qp_draw_core.c \
+	$(QUANTUM_PATH)/painter/qp_draw_codec.c \
+	$(QUANTUM_PATH)/painter/qp_draw_circle.c \
+	$(QUANTUM_PATH)/painter/qp_draw_ellipse.c \
+	$(QUANTUM_PATH)/painter/qp_draw_polygon.c \
+	$(QUANTUM_PATH)/painter/qp_draw_image.c \
+	$(QUANTUM_PATH)/painter/qp_draw_text.c \
+	$(DRIVER_PATH)/painter/generic/qp_surface_common.c \
+	$(DRIVER_PATH)/painter/generic/qp_rgb565_surface.c \
+	$(DRIVER_PATH)/painter/generic/qp_rgb888_surface.c \
+	$(DRIVER_PATH)/painter/generic/qp_mono1bpp_surface.c \
+	$(DRIVER_PATH)/painter/generic/qp_palette_surface.c \
+	$(QUANTUM_PATH)/painter/tests/png.cpp \
+	$(QUANTUM_PATH)/painter/tests/painter_test_common.cpp \
+	$(QUANTUM_PATH)/painter/tests/painter_tests.cpp \
+	$(QUANTUM_PATH)/painter/tests/painter_benchmark.cpp
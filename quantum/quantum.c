@@ -162,6 +162,12 @@ void shutdown_quantum(void) {
 #ifdef HAPTIC_ENABLE
     haptic_shutdown();
 #endif
+#ifdef DYNAMIC_KEYMAP_ENABLE
+    // Nothing held back can be finished across a reset, so keep it rather than losing it along with everything else
+    dynamic_keymap_hold(false);
+    dynamic_keymap_flush();
+#endif
+    eeconfig_flush();
 }
 
 void reset_keyboard(void) {
@@ -264,6 +270,17 @@ bool process_record_quantum(keyrecord_t *record) {
     }
 #endif
 
+#ifdef KEYBOARD_DEFERRED_INIT
+    // Keycodes controlling a subsystem bring it up first, if it is still waiting for its turn
+    if (IS_QK_AUDIO(keycode)) {
+        keyboard_deferred_init_require(DEFERRED_INIT_AUDIO);
+    } else if (IS_QK_LIGHTING(keycode)) {
+        keyboard_deferred_init_require(DEFERRED_INIT_LIGHTING);
+    } else if (keycode >= QK_HAPTIC_ON && keycode <= QK_HAPTIC_DWELL_DOWN) {
+        keyboard_deferred_init_require(DEFERRED_INIT_HAPTIC);
+    }
+#endif
+
     if (!(
 #if defined(KEY_LOCK_ENABLE)
             // Must run first to be able to mask key_up events.
@@ -276,11 +293,12 @@ bool process_record_quantum(keyrecord_t *record) {
 #ifdef REPEAT_KEY_ENABLE
             process_last_key(keycode, record) && process_repeat_key(keycode, record) &&
 #endif
+            // Per-key feedback is skipped until its subsystem is up, rather than holding up the first keys
 #if defined(AUDIO_ENABLE) && defined(AUDIO_CLICKY)
-            process_clicky(keycode, record) &&
+            (!keyboard_deferred_init_is_up(DEFERRED_INIT_AUDIO) || process_clicky(keycode, record)) &&
 #endif
 #ifdef HAPTIC_ENABLE
-            process_haptic(keycode, record) &&
+            (!keyboard_deferred_init_is_up(DEFERRED_INIT_HAPTIC) || process_haptic(keycode, record)) &&
 #endif
 #if defined(VIA_ENABLE)
             process_record_via(keycode, record) &&
@@ -464,6 +482,7 @@ __attribute__((weak)) void startup_user(void) {}
 __attribute__((weak)) void shutdown_user(void) {}
 
 void suspend_power_down_quantum(void) {
+    keyboard_deferred_init_finish();
     suspend_power_down_kb();
 #ifndef NO_SUSPEND_POWER_DOWN
 // Turn off backlight
@@ -512,6 +531,7 @@ void suspend_power_down_quantum(void) {
 }
 
 __attribute__((weak)) void suspend_wakeup_init_quantum(void) {
+    keyboard_deferred_init_finish();
 // Turn on backlight
 #ifdef BACKLIGHT_ENABLE
     backlight_init();
@@ -0,0 +1,45 @@
+#pragma once
+
+#ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
+
+// For splash effects which only light the ring expanding from each hit, where `dist <= tick < dist + 255`. The effect
+// is only called for the hits whose ring covers the LED, and hits are skipped entirely once their ring has moved past
+// every LED, so older hits cost nothing.
+bool effect_runner_reactive_ring(uint8_t start, effect_params_t* params, reactive_splash_f effect_func) {
+    RGB_MATRIX_USE_LIMITS(led_min, led_max);
+
+    uint8_t  live = 0;
+    uint8_t  hit[LED_HITS_TO_REMEMBER];
+    uint16_t tick[LED_HITS_TO_REMEMBER];
+    for (uint8_t j = start; j < g_last_hit_tracker.count; j++) {
+        uint16_t t = scale16by8(g_last_hit_tracker.tick[j], qadd8(rgb_matrix_config.speed, 1));
+        // Distances are at most 255, so once the inner edge is further than that the hit is gone
+        if (t < 255 + 255) {
+            hit[live]  = j;
+            tick[live] = t;
+            live++;
+        }
+    }
+
+    for (uint8_t i = led_min; i < led_max; i++) {
+        RGB_MATRIX_TEST_LED_FLAGS();
+        HSV hsv = rgb_matrix_config.hsv;
+        hsv.v   = 0;
+        for (uint8_t k = 0; k < live; k++) {
+            int16_t dx = g_led_config.point[i].x - g_last_hit_tracker.x[hit[k]];
+            int16_t dy = g_led_config.point[i].y - g_last_hit_tracker.y[hit[k]];
+            // Beyond the outer edge on either axis, so skip the square root
+            int16_t r = tick[k];
+            if (dx > r || dx < -r || dy > r || dy < -r) continue;
+            uint8_t dist = sqrt16(dx * dx + dy * dy);
+            if (dist > tick[k] || tick[k] - dist >= 255) continue;
+            hsv = effect_func(hsv, dx, dy, dist, tick[k]);
+        }
+        hsv.v   = scale8(hsv.v, rgb_matrix_config.hsv.v);
+        RGB rgb = rgb_matrix_hsv_to_rgb(hsv);
+        rgb_matrix_set_color(i, rgb.r, rgb.g, rgb.b);
+    }
+    return rgb_matrix_check_finished_leds(led_max);
+}
+
+#endif // RGB_MATRIX_KEYREACTIVE_ENABLED
@@ -19,6 +19,7 @@
 #include "rgb_matrix.h"
 #include "progmem.h"
 #include "eeprom.h"
+#include "led_tables.h"
 #include <string.h>
 #include <math.h>
 
@@ -114,6 +115,9 @@ uint8_t g_rgb_frame_buffer[MATRIX_ROWS][MATRIX_COLS] = {{0}};
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
 last_hit_t g_last_hit_tracker;
 #endif // RGB_MATRIX_KEYREACTIVE_ENABLED
+#ifdef RGB_MATRIX_GEOMETRY_CACHE
+rgb_matrix_geometry_t g_rgb_matrix_geometry;
+#endif // RGB_MATRIX_GEOMETRY_CACHE
 
 // internals
 static bool            suspend_state     = false;
@@ -128,7 +132,14 @@ static uint32_t rgb_anykey_timer;
 // double buffers
 static uint32_t rgb_timer_buffer;
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
-static last_hit_t last_hit_buffer;
+// Ring buffer of hits, oldest first. Each hit keeps the time it was recorded, so hits age without being touched and
+// only the oldest needs checking for expiry; ticks are calculated when copied to g_last_hit_tracker.
+static struct {
+    uint8_t  head;
+    uint8_t  count;
+    uint8_t  index[LED_HITS_TO_REMEMBER];
+    uint32_t time[LED_HITS_TO_REMEMBER];
+} last_hit_buffer;
 #endif // RGB_MATRIX_KEYREACTIVE_ENABLED
 
 // split rgb matrix
@@ -187,16 +198,87 @@ uint8_t rgb_matrix_map_row_column_to_led(uint8_t row, uint8_t column, uint8_t *l
     return led_count;
 }
 
+#ifdef RGB_MATRIX_OUTPUT_STAGE
+// Colors as set by the effects, converted and sent to the driver once per flush
+static RGB rgb_matrix_output[RGB_MATRIX_LED_COUNT];
+#    ifdef RGB_MATRIX_DITHERING
+// Fractional part left over from the previous flush, carried into the next one
+static uint8_t rgb_matrix_dither[RGB_MATRIX_LED_COUNT][3];
+#    endif
+
+// The driver takes 8-bit values, so 16-bit values are reduced by dropping the low byte. Widening by the same shift
+// keeps every 8-bit input a fixed point, so it is sent unchanged rather than dithered.
+static inline uint16_t rgb_matrix_output_linearize(uint8_t value) {
+#    ifdef RGB_MATRIX_GAMMA_CORRECTION
+    return pgm_read_word(&CIE1931_CURVE_16[value]);
+#    else
+    return value << 8;
+#    endif
+}
+
+static inline uint8_t rgb_matrix_output_quantize(uint16_t value, uint8_t *residual) {
+#    ifdef RGB_MATRIX_DITHERING
+    uint32_t total = (uint32_t)value + *residual;
+    *residual      = total & 0xFF;
+    return MIN(total >> 8, 255);
+#    else
+    return MIN(((uint32_t)value + 128) >> 8, 255);
+#    endif
+}
+
+static void rgb_matrix_output_flush(void) {
+    uint32_t scale = 65536; // Q16
+
+#    ifdef RGB_MATRIX_CURRENT_LIMIT
+    // Total of all channels at 16-bit resolution, compared against the limit in the same units
+    static const uint32_t limit = (uint64_t)RGB_MATRIX_CURRENT_LIMIT * 65535 / RGB_MATRIX_LED_CHANNEL_CURRENT;
+    uint32_t              total = 0;
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        total += rgb_matrix_output_linearize(rgb_matrix_output[i].r) + rgb_matrix_output_linearize(rgb_matrix_output[i].g) + rgb_matrix_output_linearize(rgb_matrix_output[i].b);
+    }
+    if (total > limit) {
+        scale = ((uint64_t)limit << 16) / total;
+    }
+#    endif
+
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        uint16_t channels[3] = {
+            ((uint32_t)rgb_matrix_output_linearize(rgb_matrix_output[i].r) * scale) >> 16,
+            ((uint32_t)rgb_matrix_output_linearize(rgb_matrix_output[i].g) * scale) >> 16,
+            ((uint32_t)rgb_matrix_output_linearize(rgb_matrix_output[i].b) * scale) >> 16,
+        };
+        uint8_t out[3];
+        for (uint8_t c = 0; c < 3; c++) {
+#    ifdef RGB_MATRIX_DITHERING
+            out[c] = rgb_matrix_output_quantize(channels[c], &rgb_matrix_dither[i][c]);
+#    else
+            out[c] = rgb_matrix_output_quantize(channels[c], NULL);
+#    endif
+        }
+        rgb_matrix_driver.set_color(i, out[0], out[1], out[2]);
+    }
+}
+#endif // RGB_MATRIX_OUTPUT_STAGE
+
 void rgb_matrix_update_pwm_buffers(void) {
+#ifdef RGB_MATRIX_OUTPUT_STAGE
+    rgb_matrix_output_flush();
+#endif
     rgb_matrix_driver.flush();
 }
 
 void rgb_matrix_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
+#ifdef RGB_MATRIX_OUTPUT_STAGE
+    if (index >= 0 && index < RGB_MATRIX_LED_COUNT) {
+        rgb_matrix_output[index] = (RGB){.r = red, .g = green, .b = blue};
+    }
+#else
     rgb_matrix_driver.set_color(index, red, green, blue);
+#endif
 }
 
 void rgb_matrix_set_color_all(uint8_t red, uint8_t green, uint8_t blue) {
-#if defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT)
+#if (defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT)) || defined(RGB_MATRIX_OUTPUT_STAGE)
     for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++)
         rgb_matrix_set_color(i, red, green, blue);
 #else
@@ -225,21 +307,18 @@ void process_rgb_matrix(uint8_t row, uint8_t col, bool pressed) {
         led_count = rgb_matrix_map_row_column_to_led(row, col, led);
     }
 
-    if (last_hit_buffer.count + led_count > LED_HITS_TO_REMEMBER) {
-        memcpy(&last_hit_buffer.x[0], &last_hit_buffer.x[led_count], LED_HITS_TO_REMEMBER - led_count);
-        memcpy(&last_hit_buffer.y[0], &last_hit_buffer.y[led_count], LED_HITS_TO_REMEMBER - led_count);
-        memcpy(&last_hit_buffer.tick[0], &last_hit_buffer.tick[led_count], (LED_HITS_TO_REMEMBER - led_count) * 2); // 16 bit
-        memcpy(&last_hit_buffer.index[0], &last_hit_buffer.index[led_count], LED_HITS_TO_REMEMBER - led_count);
-        last_hit_buffer.count = LED_HITS_TO_REMEMBER - led_count;
-    }
-
     for (uint8_t i = 0; i < led_count; i++) {
-        uint8_t index                = last_hit_buffer.count;
-        last_hit_buffer.x[index]     = g_led_config.point[led[i]].x;
-        last_hit_buffer.y[index]     = g_led_config.point[led[i]].y;
-        last_hit_buffer.index[index] = led[i];
-        last_hit_buffer.tick[index]  = 0;
-        last_hit_buffer.count++;
+        uint8_t slot;
+        if (last_hit_buffer.count < LED_HITS_TO_REMEMBER) {
+            slot = last_hit_buffer.head + last_hit_buffer.count++;
+            if (slot >= LED_HITS_TO_REMEMBER) slot -= LED_HITS_TO_REMEMBER;
+        } else {
+            // Full, so replace the oldest hit
+            slot = last_hit_buffer.head;
+            if (++last_hit_buffer.head == LED_HITS_TO_REMEMBER) last_hit_buffer.head = 0;
+        }
+        last_hit_buffer.index[slot] = led[i];
+        last_hit_buffer.time[slot]  = rgb_timer_buffer;
     }
 #endif // RGB_MATRIX_KEYREACTIVE_ENABLED
 
@@ -291,9 +370,9 @@ static bool rgb_matrix_none(effect_params_t *params) {
 }
 
 static void rgb_task_timers(void) {
-#if defined(RGB_MATRIX_KEYREACTIVE_ENABLED) || RGB_MATRIX_TIMEOUT > 0
+#if RGB_MATRIX_TIMEOUT > 0
     uint32_t deltaTime = sync_timer_elapsed32(rgb_timer_buffer);
-#endif // defined(RGB_MATRIX_KEYREACTIVE_ENABLED) || RGB_MATRIX_TIMEOUT > 0
+#endif // RGB_MATRIX_TIMEOUT > 0
     rgb_timer_buffer = sync_timer_read32();
 
     // Update double buffer timers
@@ -303,15 +382,11 @@ static void rgb_task_timers(void) {
     }
 #endif // RGB_MATRIX_TIMEOUT > 0
 
-    // Update double buffer last hit timers
+    // Expire double buffer last hits, which can no longer be represented by a 16 bit tick
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
-    uint8_t count = last_hit_buffer.count;
-    for (uint8_t i = 0; i < count; ++i) {
-        if (UINT16_MAX - deltaTime < last_hit_buffer.tick[i]) {
-            last_hit_buffer.count--;
-            continue;
-        }
-        last_hit_buffer.tick[i] += deltaTime;
+    while (last_hit_buffer.count && rgb_timer_buffer - last_hit_buffer.time[last_hit_buffer.head] > UINT16_MAX) {
+        if (++last_hit_buffer.head == LED_HITS_TO_REMEMBER) last_hit_buffer.head = 0;
+        last_hit_buffer.count--;
     }
 #endif // RGB_MATRIX_KEYREACTIVE_ENABLED
 }
@@ -329,7 +404,16 @@ static void rgb_task_start(void) {
     // update double buffers
     g_rgb_timer = rgb_timer_buffer;
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
-    g_last_hit_tracker = last_hit_buffer;
+    uint8_t slot = last_hit_buffer.head;
+    for (uint8_t i = 0; i < last_hit_buffer.count; i++) {
+        uint8_t led                 = last_hit_buffer.index[slot];
+        g_last_hit_tracker.x[i]     = g_led_config.point[led].x;
+        g_last_hit_tracker.y[i]     = g_led_config.point[led].y;
+        g_last_hit_tracker.index[i] = led;
+        g_last_hit_tracker.tick[i]  = g_rgb_timer - last_hit_buffer.time[slot];
+        if (++slot == LED_HITS_TO_REMEMBER) slot = 0;
+    }
+    g_last_hit_tracker.count = last_hit_buffer.count;
 #endif // RGB_MATRIX_KEYREACTIVE_ENABLED
 
     // next task
@@ -471,19 +555,33 @@ __attribute__((weak)) bool rgb_matrix_indicators_advanced_user(uint8_t led_min,
     return true;
 }
 
+#ifdef RGB_MATRIX_GEOMETRY_CACHE
+void rgb_matrix_update_geometry(void) {
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        int16_t dx = g_led_config.point[i].x - k_rgb_matrix_center.x;
+        int16_t dy = g_led_config.point[i].y - k_rgb_matrix_center.y;
+
+        g_rgb_matrix_geometry.dist[i]  = sqrt16(dx * dx + dy * dy);
+        g_rgb_matrix_geometry.angle[i] = atan2_8(dy, dx);
+    }
+}
+#endif // RGB_MATRIX_GEOMETRY_CACHE
+
 void rgb_matrix_init(void) {
     rgb_matrix_driver.init();
 
+#ifdef RGB_MATRIX_GEOMETRY_CACHE
+    rgb_matrix_update_geometry();
+#endif // RGB_MATRIX_GEOMETRY_CACHE
+
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
     g_last_hit_tracker.count = 0;
     for (uint8_t i = 0; i < LED_HITS_TO_REMEMBER; ++i) {
         g_last_hit_tracker.tick[i] = UINT16_MAX;
     }
 
+    last_hit_buffer.head  = 0;
     last_hit_buffer.count = 0;
-    for (uint8_t i = 0; i < LED_HITS_TO_REMEMBER; ++i) {
-        last_hit_buffer.tick[i] = UINT16_MAX;
-    }
 #endif // RGB_MATRIX_KEYREACTIVE_ENABLED
 
     if (!eeconfig_is_enabled()) {
@@ -52,6 +52,20 @@
 #    define RGB_MATRIX_LED_PROCESS_LIMIT (RGB_MATRIX_LED_COUNT + 4) / 5
 #endif
 
+// Output stage between rgb_matrix_set_color() and the driver -- see "Output Stage" in the RGB Matrix docs
+#if defined(RGB_MATRIX_GAMMA_CORRECTION) || defined(RGB_MATRIX_DITHERING) || defined(RGB_MATRIX_CURRENT_LIMIT)
+#    define RGB_MATRIX_OUTPUT_STAGE
+#endif
+
+#if defined(RGB_MATRIX_CURRENT_LIMIT) && !defined(RGB_MATRIX_LED_CHANNEL_CURRENT)
+#    define RGB_MATRIX_LED_CHANNEL_CURRENT 20 // mA drawn by a single color channel at full brightness
+#endif
+
+// Per-LED distance and angle from the center, calculated once instead of on every frame by the radial effects
+#if defined(ENABLE_RGB_MATRIX_CYCLE_OUT_IN) || defined(ENABLE_RGB_MATRIX_CYCLE_SPIRAL) || defined(ENABLE_RGB_MATRIX_CYCLE_PINWHEEL) || defined(ENABLE_RGB_MATRIX_BAND_SPIRAL_SAT) || defined(ENABLE_RGB_MATRIX_BAND_SPIRAL_VAL) || defined(ENABLE_RGB_MATRIX_BAND_PINWHEEL_SAT) || defined(ENABLE_RGB_MATRIX_BAND_PINWHEEL_VAL)
+#    define RGB_MATRIX_GEOMETRY_CACHE
+#endif
+
 #if defined(RGB_MATRIX_LED_PROCESS_LIMIT) && RGB_MATRIX_LED_PROCESS_LIMIT > 0 && RGB_MATRIX_LED_PROCESS_LIMIT < RGB_MATRIX_LED_COUNT
 #    if defined(RGB_MATRIX_SPLIT)
 #        define RGB_MATRIX_USE_LIMITS_ITER(min, max, iter)                                        \
@@ -142,6 +156,10 @@ bool rgb_matrix_indicators_advanced_user(uint8_t led_min, uint8_t led_max);
 
 void rgb_matrix_init(void);
 
+#ifdef RGB_MATRIX_GEOMETRY_CACHE
+void rgb_matrix_update_geometry(void);
+#endif
+
 void rgb_matrix_reload_from_eeprom(void);
 
 void        rgb_matrix_set_suspend_state(bool state);
@@ -268,3 +286,6 @@ extern last_hit_t g_last_hit_tracker;
 #ifdef RGB_MATRIX_FRAMEBUFFER_EFFECTS
 extern uint8_t g_rgb_frame_buffer[MATRIX_ROWS][MATRIX_COLS];
 #endif
+#ifdef RGB_MATRIX_GEOMETRY_CACHE
+extern rgb_matrix_geometry_t g_rgb_matrix_geometry;
+#endif
@@ -38,6 +38,9 @@
 #ifndef LED_HITS_TO_REMEMBER
 #    define LED_HITS_TO_REMEMBER 8
 #endif // LED_HITS_TO_REMEMBER
+#if LED_HITS_TO_REMEMBER > 127
+#    error "LED_HITS_TO_REMEMBER must not be greater than 127"
+#endif
 
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
 typedef struct PACKED {
@@ -82,6 +85,11 @@ typedef struct PACKED {
     uint8_t     flags[RGB_MATRIX_LED_COUNT];
 } led_config_t;
 
+typedef struct PACKED {
+    uint8_t dist[RGB_MATRIX_LED_COUNT];  // distance from the center
+    uint8_t angle[RGB_MATRIX_LED_COUNT]; // atan2_8() angle around the center
+} rgb_matrix_geometry_t;
+
 typedef union {
     uint64_t raw;
     struct PACKED {
@@ -125,6 +125,46 @@ rgblight_segment_t const *const *rgblight_layers = NULL;
 static bool deferred_set_layer_state = false;
 #endif
 
+#ifdef RGBLIGHT_LED_FLUSH_LIMIT
+static bool     rgblight_frame_pending = false;
+static uint16_t rgblight_frame_timer;
+#    ifdef DEBUG_RGBLIGHT_FRAME_RATE
+// rgblight_task() mostly takes well under a millisecond, so it is timed in microseconds. On ChibiOS the system tick
+// (usually 10-100us) is used. Elsewhere only the millisecond timer is available; each call then reads as 0 or 1ms,
+// which only averages out to the real busy time once summed over the many calls of a reporting period.
+#        ifdef PROTOCOL_CHIBIOS
+#            include <ch.h>
+#            define RGBLIGHT_PERF_TIMESTAMP() ((uint32_t)chVTGetSystemTimeX())
+#            define RGBLIGHT_PERF_ELAPSED_US(start) ((uint32_t)TIME_I2US(chTimeDiffX((systime_t)(start), chVTGetSystemTimeX())))
+#        else
+#            define RGBLIGHT_PERF_TIMESTAMP() timer_read32()
+#            define RGBLIGHT_PERF_ELAPSED_US(start) (TIMER_DIFF_32(timer_read32(), (start)) * 1000)
+#        endif
+static uint32_t rgblight_perf_timer       = 0;
+static uint32_t rgblight_perf_frame_count = 0;
+static uint32_t rgblight_perf_busy_us     = 0;
+#    endif
+#endif
+
+// Effects and setters render into the LED buffer, then request it to be sent. With RGBLIGHT_LED_FLUSH_LIMIT, the
+// buffer is sent by rgblight_task() at most once per frame, no matter how many changes were made in between.
+static inline void rgblight_request_set(void) {
+#ifdef RGBLIGHT_LED_FLUSH_LIMIT
+    rgblight_frame_pending = true;
+#else
+    rgblight_set();
+#endif
+}
+
+#ifdef RGBLIGHT_LED_FLUSH_LIMIT
+static void rgblight_flush(void) {
+    if (rgblight_frame_pending) {
+        rgblight_frame_pending = false;
+        rgblight_set();
+    }
+}
+#endif
+
 rgblight_ranges_t rgblight_ranges = {0, RGBLED_NUM, 0, RGBLED_NUM, RGBLED_NUM};
 
 void rgblight_set_clipping_range(uint8_t start_pos, uint8_t num_leds) {
@@ -179,7 +219,7 @@ void rgblight_check_config(void) {
 
 uint64_t eeconfig_read_rgblight(void) {
 #ifdef EEPROM_ENABLE
-    return (uint64_t)((eeprom_read_dword(EECONFIG_RGBLIGHT)) | ((uint64_t)eeprom_read_byte(EECONFIG_RGBLIGHT_EXTENDED) << 32));
+    return (uint64_t)((eeconfig_read_dword(EECONFIG_RGBLIGHT)) | ((uint64_t)eeconfig_read_byte(EECONFIG_RGBLIGHT_EXTENDED) << 32));
 #else
     return 0;
 #endif
@@ -188,8 +228,8 @@ uint64_t eeconfig_read_rgblight(void) {
 void eeconfig_update_rgblight(uint64_t val) {
 #ifdef EEPROM_ENABLE
     rgblight_check_config();
-    eeprom_update_dword(EECONFIG_RGBLIGHT, val & 0xFFFFFFFF);
-    eeprom_update_byte(EECONFIG_RGBLIGHT_EXTENDED, (val >> 32) & 0xFF);
+    eeconfig_update_dword(EECONFIG_RGBLIGHT, val & 0xFFFFFFFF);
+    eeconfig_update_byte(EECONFIG_RGBLIGHT_EXTENDED, (val >> 32) & 0xFF);
 #endif
 }
 
@@ -275,7 +315,7 @@ void rgblight_update_qword(uint64_t qword) {
         rgblight_mode_noeeprom(rgblight_config.mode);
     else {
         rgblight_timer_disable();
-        rgblight_set();
+        rgblight_request_set();
     }
 }
 
@@ -406,7 +446,7 @@ void rgblight_disable(void) {
     dprintf("rgblight disable [EEPROM]: rgblight_config.enable = %u\n", rgblight_config.enable);
     rgblight_timer_disable();
     RGBLIGHT_SPLIT_SET_CHANGE_MODE;
-    rgblight_set();
+    rgblight_request_set();
 }
 
 void rgblight_disable_noeeprom(void) {
@@ -414,7 +454,7 @@ void rgblight_disable_noeeprom(void) {
     dprintf("rgblight disable [NOEEPROM]: rgblight_config.enable = %u\n", rgblight_config.enable);
     rgblight_timer_disable();
     RGBLIGHT_SPLIT_SET_CHANGE_MODE;
-    rgblight_set();
+    rgblight_request_set();
 }
 
 void rgblight_enabled_noeeprom(bool state) {
@@ -582,7 +622,7 @@ void rgblight_sethsv_eeprom_helper(uint8_t hue, uint8_t sat, uint8_t val, bool w
                 // needed for rgblight_layers_write() to get the new val, since it reads rgblight_config.val
                 rgblight_config.val = val;
 #    endif
-                rgblight_set();
+                rgblight_request_set();
             }
 #endif
         }
@@ -657,7 +697,7 @@ void rgblight_setrgb(uint8_t r, uint8_t g, uint8_t b) {
         led[i].w = 0;
 #endif
     }
-    rgblight_set();
+    rgblight_request_set();
 }
 
 void rgblight_setrgb_at(uint8_t r, uint8_t g, uint8_t b, uint8_t index) {
@@ -671,7 +711,7 @@ void rgblight_setrgb_at(uint8_t r, uint8_t g, uint8_t b, uint8_t index) {
 #ifdef RGBW
     led[index].w = 0;
 #endif
-    rgblight_set();
+    rgblight_request_set();
 }
 
 void rgblight_sethsv_at(uint8_t hue, uint8_t sat, uint8_t val, uint8_t index) {
@@ -709,7 +749,7 @@ void rgblight_setrgb_range(uint8_t r, uint8_t g, uint8_t b, uint8_t start, uint8
         led[i].w = 0;
 #endif
     }
-    rgblight_set();
+    rgblight_request_set();
 }
 
 void rgblight_sethsv_range(uint8_t hue, uint8_t sat, uint8_t val, uint8_t start, uint8_t end) {
@@ -763,8 +803,8 @@ bool rgblight_get_layer_state(uint8_t layer) {
     return (rgblight_status.enabled_layer_mask & mask) != 0;
 }
 
-// Write any enabled LED layers into the buffer
-static void rgblight_layers_write(void) {
+// Render any enabled LED layers into the given buffer, marking the LEDs they cover
+static void rgblight_layers_render(LED_TYPE *buffer, uint8_t *covered) {
 #    ifdef RGBLIGHT_LAYERS_RETAIN_VAL
     uint8_t current_val = rgblight_get_val();
 #    endif
@@ -786,19 +826,62 @@ static void rgblight_layers_write(void) {
                 break; // No more segments
             }
             // Write segment.count LEDs
-            LED_TYPE *const limit = &led[MIN(segment.index + segment.count, RGBLED_NUM)];
-            for (LED_TYPE *led_ptr = &led[segment.index]; led_ptr < limit; led_ptr++) {
+            uint8_t limit = MIN(segment.index + segment.count, RGBLED_NUM);
+            for (uint8_t j = segment.index; j < limit; j++) {
 #    ifdef RGBLIGHT_LAYERS_RETAIN_VAL
-                sethsv(segment.hue, segment.sat, current_val, led_ptr);
+                sethsv(segment.hue, segment.sat, current_val, &buffer[j]);
 #    else
-                sethsv(segment.hue, segment.sat, segment.val, led_ptr);
+                sethsv(segment.hue, segment.sat, segment.val, &buffer[j]);
 #    endif
+                if (covered) {
+                    covered[j / 8] |= 1 << (j % 8);
+                }
             }
             segment_ptr++;
         }
     }
 }
 
+#    ifdef RGBLIGHT_LED_FLUSH_LIMIT
+// The composited layers, only rendered again when the enabled layers (or their val) change
+static LED_TYPE                         layers_cache[RGBLED_NUM];
+static uint8_t                          layers_cache_covered[(RGBLED_NUM + 7) / 8];
+static bool                             layers_cache_valid = false;
+static rgblight_layer_mask_t            layers_cache_state;
+static rgblight_segment_t const *const *layers_cache_layers;
+#        ifdef RGBLIGHT_LAYERS_RETAIN_VAL
+static uint8_t layers_cache_val;
+#        endif
+#    endif
+
+// Write any enabled LED layers into the buffer
+static void rgblight_layers_write(void) {
+#    ifdef RGBLIGHT_LED_FLUSH_LIMIT
+    bool valid = layers_cache_valid && layers_cache_state == rgblight_status.enabled_layer_mask && layers_cache_layers == rgblight_layers;
+#        ifdef RGBLIGHT_LAYERS_RETAIN_VAL
+    valid = valid && layers_cache_val == rgblight_get_val();
+#        endif
+    if (!valid) {
+        memset(layers_cache_covered, 0, sizeof(layers_cache_covered));
+        rgblight_layers_render(layers_cache, layers_cache_covered);
+        layers_cache_valid  = true;
+        layers_cache_state  = rgblight_status.enabled_layer_mask;
+        layers_cache_layers = rgblight_layers;
+#        ifdef RGBLIGHT_LAYERS_RETAIN_VAL
+        layers_cache_val = rgblight_get_val();
+#        endif
+    }
+
+    for (uint8_t i = 0; i < RGBLED_NUM; i++) {
+        if (layers_cache_covered[i / 8] & (1 << (i % 8))) {
+            led[i] = layers_cache[i];
+        }
+    }
+#    else
+    rgblight_layers_render(led, NULL);
+#    endif
+}
+
 #    ifdef RGBLIGHT_LAYER_BLINK
 rgblight_layer_mask_t _blinking_layer_mask = 0;
 static uint16_t       _repeat_timer;
@@ -876,6 +959,10 @@ void rgblight_suspend(void) {
 #    endif
 
         rgblight_disable_noeeprom();
+#    ifdef RGBLIGHT_LED_FLUSH_LIMIT
+        // rgblight_task() won't run again before the keyboard sleeps
+        rgblight_flush();
+#    endif
     }
 }
 
@@ -888,7 +975,7 @@ void rgblight_wakeup(void) {
 #    ifdef RGBLIGHT_LAYERS_OVERRIDE_RGB_OFF
     // Need this or else the LEDs won't be set
     else if (rgblight_status.enabled_layer_mask != 0) {
-        rgblight_set();
+        rgblight_request_set();
     }
 #    endif
 
@@ -1050,6 +1137,10 @@ static void rgblight_effect_dummy(animation_status_t *anim) {
 }
 
 void rgblight_task(void) {
+#    if defined(RGBLIGHT_LED_FLUSH_LIMIT) && defined(DEBUG_RGBLIGHT_FRAME_RATE)
+    uint32_t task_start = RGBLIGHT_PERF_TIMESTAMP();
+#    endif
+
     if (rgblight_status.timer_enabled) {
         effect_func_t effect_func   = rgblight_effect_dummy;
         uint16_t      interval_time = 2000; // dummy interval
@@ -1167,11 +1258,33 @@ void rgblight_task(void) {
 #        ifdef RGBLIGHT_LAYERS_OVERRIDE_RGB_OFF
         // If not enabled, then nothing else will actually set the LEDs...
         if (!rgblight_config.enable) {
-            rgblight_set();
+            rgblight_request_set();
         }
 #        endif
     }
 #    endif
+
+#    ifdef RGBLIGHT_LED_FLUSH_LIMIT
+    if (rgblight_frame_pending && timer_elapsed(rgblight_frame_timer) >= RGBLIGHT_LED_FLUSH_LIMIT) {
+        rgblight_frame_timer = timer_read();
+        rgblight_flush();
+#        ifdef DEBUG_RGBLIGHT_FRAME_RATE
+        rgblight_perf_frame_count++;
+#        endif
+    }
+
+#        ifdef DEBUG_RGBLIGHT_FRAME_RATE
+    rgblight_perf_busy_us += RGBLIGHT_PERF_ELAPSED_US(task_start);
+    uint32_t timer_now = timer_read32();
+    if (TIMER_DIFF_32(timer_now, rgblight_perf_timer) >= 1000) {
+        uint32_t frame_us = rgblight_perf_frame_count ? rgblight_perf_busy_us / rgblight_perf_frame_count : 0;
+        dprintf("rgblight frame rate: %lu, %lu us per frame, %lu us busy in total\n", (unsigned long)rgblight_perf_frame_count, (unsigned long)frame_us, (unsigned long)rgblight_perf_busy_us);
+        rgblight_perf_timer       = timer_now;
+        rgblight_perf_frame_count = 0;
+        rgblight_perf_busy_us     = 0;
+    }
+#        endif
+#    endif
 }
 
 #endif /* RGBLIGHT_USE_TIMER */
@@ -1232,7 +1345,7 @@ void rgblight_effect_rainbow_swirl(animation_status_t *anim) {
         hue = (RGBLIGHT_RAINBOW_SWIRL_RANGE / rgblight_ranges.effect_num_leds * i + anim->current_hue);
         sethsv(hue, rgblight_config.sat, rgblight_config.val, (LED_TYPE *)&led[i + rgblight_ranges.effect_start_pos]);
     }
-    rgblight_set();
+    rgblight_request_set();
 
     if (anim->delta % 2) {
         anim->current_hue++;
@@ -1287,7 +1400,7 @@ void rgblight_effect_snake(animation_status_t *anim) {
             }
         }
     }
-    rgblight_set();
+    rgblight_request_set();
     if (increment == 1) {
         if (pos - RGBLIGHT_EFFECT_SNAKE_INCREMENT < 0) {
             pos = rgblight_ranges.effect_num_leds - 1;
@@ -1350,7 +1463,7 @@ void rgblight_effect_knight(animation_status_t *anim) {
 #    endif
         }
     }
-    rgblight_set();
+    rgblight_request_set();
 
     // Move from low_bound to high_bound changing the direction we increment each
     // time a boundary is hit.
@@ -1394,7 +1507,7 @@ void rgblight_effect_christmas(animation_status_t *anim) {
         uint8_t local_hue = (i / RGBLIGHT_EFFECT_CHRISTMAS_STEP) % 2 ? hue : hue_green - hue;
         sethsv(local_hue, rgblight_config.sat, val, (LED_TYPE *)&led[i + rgblight_ranges.effect_start_pos]);
     }
-    rgblight_set();
+    rgblight_request_set();
 
     if (anim->pos == 0) {
         increment = 1;
@@ -1448,7 +1561,7 @@ void rgblight_effect_alternating(animation_status_t *anim) {
             sethsv(rgblight_config.hue, rgblight_config.sat, 0, ledp);
         }
     }
-    rgblight_set();
+    rgblight_request_set();
     anim->pos = (anim->pos + 1) % 2;
 }
 #endif
@@ -1516,6 +1629,6 @@ void rgblight_effect_twinkle(animation_status_t *anim) {
         sethsv(c->h, c->s, c->v, ledp);
     }
 
-    rgblight_set();
+    rgblight_request_set();
 }
 #endif
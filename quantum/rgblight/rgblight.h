@@ -83,6 +83,11 @@
 #    define RGBLIGHT_USE_TIMER
 #endif
 
+// With a flush limit, LED updates are only sent out from rgblight_task
+#ifdef RGBLIGHT_LED_FLUSH_LIMIT
+#    define RGBLIGHT_USE_TIMER
+#endif
+
 // clang-format on
 
 #define _RGBM_SINGLE_STATIC(sym) RGBLIGHT_MODE_##sym,
@@ -34,7 +34,7 @@ sequencer_config_t sequencer_config = {
     SQ_RES_4, // resolution
 };
 
-sequencer_state_t sequencer_internal_state = {0, 0, 0, 0, SEQUENCER_PHASE_ATTACK};
+sequencer_state_t sequencer_internal_state = {0, 0, 0, 0, SEQUENCER_PHASE_ATTACK, 0};
 
 bool is_sequencer_on(void) {
     return sequencer_config.enabled;
@@ -46,6 +46,7 @@ void sequencer_on(void) {
     sequencer_internal_state.current_track = 0;
     sequencer_internal_state.current_step  = 0;
     sequencer_internal_state.timer         = timer_read();
+    sequencer_internal_state.step_timer    = sequencer_internal_state.timer;
     sequencer_internal_state.phase         = SEQUENCER_PHASE_ATTACK;
 }
 
@@ -227,10 +228,22 @@ void sequencer_phase_release(void) {
 }
 
 void sequencer_phase_pause(void) {
-    if (timer_elapsed(sequencer_internal_state.timer) < sequencer_get_step_duration()) {
+    uint16_t step_duration = sequencer_get_step_duration();
+    uint16_t elapsed       = timer_elapsed(sequencer_internal_state.step_timer);
+    if (elapsed < step_duration) {
         return;
     }
 
+    // Schedule the next step from when this one was due rather than from when the task got to it, so that a slow
+    // main loop delays individual steps without dragging the whole sequence behind the tempo. If we have fallen a
+    // full step behind (a long stall, or a step that takes longer than the tempo allows), start over from now
+    // instead of rushing through the missed steps.
+    if (elapsed < 2 * step_duration) {
+        sequencer_internal_state.step_timer += step_duration;
+    } else {
+        sequencer_internal_state.step_timer = timer_read();
+    }
+
     sequencer_internal_state.current_step = (sequencer_internal_state.current_step + 1) % SEQUENCER_STEPS;
     sequencer_internal_state.phase        = SEQUENCER_PHASE_ATTACK;
 }
@@ -76,8 +76,9 @@ typedef struct {
     uint8_t           active_tracks;
     uint8_t           current_track;
     uint8_t           current_step;
-    uint16_t          timer;
+    uint16_t          timer;      // when the first track of the current step was attacked
     sequencer_phase_t phase;
+    uint16_t          step_timer; // when the current step was due, on the tempo grid
 } sequencer_state_t;
 
 extern sequencer_config_t sequencer_config;
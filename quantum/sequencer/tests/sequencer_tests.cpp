@@ -47,6 +47,7 @@ class SequencerTest : public ::testing::Test {
         state_copy.current_track = sequencer_internal_state.current_track;
         state_copy.current_step  = sequencer_internal_state.current_step;
         state_copy.timer         = sequencer_internal_state.timer;
+        state_copy.step_timer    = sequencer_internal_state.step_timer;
 
         last_noteon  = 0;
         last_noteoff = 0;
@@ -72,6 +73,7 @@ class SequencerTest : public ::testing::Test {
         sequencer_internal_state.current_track = state_copy.current_track;
         sequencer_internal_state.current_step  = state_copy.current_step;
         sequencer_internal_state.timer         = state_copy.timer;
+        sequencer_internal_state.step_timer    = state_copy.step_timer;
     }
 
     sequencer_config_t config_copy;
@@ -590,3 +592,95 @@ TEST_F(SequencerTest, TestMatrixScanSequencerShouldLoopOnceSequenceIsOver) {
     EXPECT_EQ(sequencer_internal_state.current_track, 1);
     EXPECT_EQ(sequencer_internal_state.phase, SEQUENCER_PHASE_ATTACK);
 }
+
+// Runs the sequencer as the main loop would, taking loop_delays[i % count] ms between consecutive tasks, and records
+// when each step's first note was actually sent.
+void runSequencerWithLoopDelays(const uint32_t *loop_delays, int loop_delay_count, uint32_t *attack_times, int steps) {
+    uint32_t now      = 0;
+    int      recorded = 0;
+
+    sequencer_on();
+    for (int i = 0; recorded < steps; i++) {
+        last_noteon = 0;
+        sequencer_task();
+        if (last_noteon == QK_MIDI_NOTE_C_0) {
+            attack_times[recorded++] = now;
+        }
+
+        now += loop_delays[i % loop_delay_count];
+        advance_time(loop_delays[i % loop_delay_count]);
+    }
+}
+
+void setUpJitterTest(void) {
+    setUpMatrixScanSequencerTest();
+
+    // Play the first track on every step, so each step start can be observed
+    for (int i = 0; i < SEQUENCER_STEPS; i++) {
+        sequencer_config.steps[i] = (1 << 0);
+    }
+}
+
+TEST_F(SequencerTest, TestMatrixScanSequencerShouldKeepStepsOnTheTempoGrid) {
+    setUpJitterTest();
+
+    // A busy loop: mostly quick scans, with the occasional slow one (e.g. a display or LED update)
+    const uint32_t loop_delays[] = {1, 2, 1, 9, 1, 1, 3, 14, 1, 2};
+    const int      steps         = 4 * SEQUENCER_STEPS;
+    uint32_t       attack_times[4 * SEQUENCER_STEPS];
+
+    runSequencerWithLoopDelays(loop_delays, sizeof(loop_delays) / sizeof(loop_delays[0]), attack_times, steps);
+
+    // One 16th at tempo=120 lasts 125ms. Every step may be late by at most the slowest loop, but no more.
+    uint32_t max_jitter = 0;
+    for (int i = 0; i < steps; i++) {
+        uint32_t due = i * 125;
+        EXPECT_GE(attack_times[i], due);
+        if (attack_times[i] - due > max_jitter) {
+            max_jitter = attack_times[i] - due;
+        }
+    }
+    EXPECT_LT(max_jitter, 14u);
+}
+
+TEST_F(SequencerTest, TestMatrixScanSequencerShouldNotDriftWithSlowLoop) {
+    setUpJitterTest();
+
+    // Every loop takes 7ms, so steps can never be processed exactly when they are due
+    const uint32_t loop_delays[] = {7};
+    const int      steps         = 4 * SEQUENCER_STEPS;
+    uint32_t       attack_times[4 * SEQUENCER_STEPS];
+
+    runSequencerWithLoopDelays(loop_delays, 1, attack_times, steps);
+
+    // The lateness of one step must not carry over to the next ones
+    EXPECT_LT(attack_times[steps - 1] - (steps - 1) * 125, 7u);
+}
+
+TEST_F(SequencerTest, TestMatrixScanSequencerShouldResyncAfterLongStall) {
+    setUpJitterTest();
+
+    uint32_t attack_times[3];
+    int      recorded = 0;
+
+    sequencer_on();
+    for (uint32_t now = 0; recorded < 3; now++) {
+        last_noteon = 0;
+        sequencer_task();
+        if (last_noteon == QK_MIDI_NOTE_C_0) {
+            attack_times[recorded++] = now;
+        }
+
+        // The loop stalls once for more than two steps, then runs smoothly again
+        if (now == 0) {
+            now += 300;
+            advance_time(300);
+        }
+        advance_time(1);
+    }
+
+    // The missed steps are skipped rather than played back to back, and the sequence carries on at tempo from there
+    EXPECT_EQ(attack_times[0], 0u);
+    EXPECT_GE(attack_times[1], 300u);
+    EXPECT_EQ(attack_times[2] - attack_times[1], 125u);
+}
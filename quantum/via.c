@@ -243,16 +243,268 @@ __attribute__((weak)) bool via_command_kb(uint8_t *data, uint8_t length) {
     return false;
 }
 
+#ifdef VIA_KEYMAP_STREAM_ENABLE
+
+#    define VIA_KEYMAP_STREAM_HEADER_SIZE 3
+
+typedef struct {
+    bool     active;
+    bool     write;
+    bool     rle;
+    uint8_t  window;
+    uint8_t  seq;
+    uint16_t offset;
+    uint16_t end;
+    uint16_t crc;
+} via_keymap_stream_t;
+
+static via_keymap_stream_t via_keymap_stream;
+
+// CRC-16/CCITT-FALSE
+static uint16_t via_keymap_stream_crc_update(uint16_t crc, const uint8_t *data, uint16_t length) {
+    while (length--) {
+        crc ^= (uint16_t)(*data++) << 8;
+        for (uint8_t i = 0; i < 8; i++) {
+            crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : (crc << 1);
+        }
+    }
+    return crc;
+}
+
+static uint16_t via_keymap_stream_read_keycode(uint16_t offset) {
+    uint8_t buf[2];
+    dynamic_keymap_get_buffer(offset, 2, buf);
+    via_keymap_stream.crc = via_keymap_stream_crc_update(via_keymap_stream.crc, buf, 2);
+    return (buf[0] << 8) | buf[1];
+}
+
+static uint16_t via_keymap_stream_peek_keycode(uint16_t offset) {
+    uint8_t buf[2];
+    dynamic_keymap_get_buffer(offset, 2, buf);
+    return (buf[0] << 8) | buf[1];
+}
+
+static void via_keymap_stream_write_bytes(const uint8_t *data, uint16_t length) {
+    if (length > via_keymap_stream.end - via_keymap_stream.offset) {
+        length = via_keymap_stream.end - via_keymap_stream.offset;
+    }
+    dynamic_keymap_set_buffer(via_keymap_stream.offset, length, (uint8_t *)data);
+    via_keymap_stream.crc = via_keymap_stream_crc_update(via_keymap_stream.crc, data, length);
+    via_keymap_stream.offset += length;
+}
+
+// Ends the current stream. Written data is held in RAM (with DYNAMIC_KEYMAP_RAM_CACHE) until the CRC has been checked,
+// and dropped again unless committed, leaving the EEPROM untouched.
+static void via_keymap_stream_close(bool commit) {
+    if (via_keymap_stream.active && via_keymap_stream.write) {
+        if (!commit) {
+            dynamic_keymap_init();
+        }
+        dynamic_keymap_hold(false);
+    }
+    via_keymap_stream.active = false;
+}
+
+// Fills the payload of a data packet from the current stream position, returning the payload length
+static uint8_t via_keymap_stream_encode(uint8_t *payload, uint8_t capacity) {
+    uint8_t used = 0;
+    if (!via_keymap_stream.rle) {
+        uint16_t remaining = via_keymap_stream.end - via_keymap_stream.offset;
+        used               = (remaining < capacity) ? remaining : capacity;
+        dynamic_keymap_get_buffer(via_keymap_stream.offset, used, payload);
+        via_keymap_stream.crc = via_keymap_stream_crc_update(via_keymap_stream.crc, payload, used);
+        via_keymap_stream.offset += used;
+        return used;
+    }
+
+    while (via_keymap_stream.offset < via_keymap_stream.end && (capacity - used) >= 3) {
+        uint16_t start   = via_keymap_stream.offset;
+        uint16_t keycode = via_keymap_stream_peek_keycode(start);
+        uint8_t  count   = 1;
+        while (count < 128 && start + (count * 2) < via_keymap_stream.end && via_keymap_stream_peek_keycode(start + (count * 2)) == keycode) {
+            count++;
+        }
+
+        if (count > 1) {
+            payload[used++] = 0x80 | (count - 1);
+            payload[used++] = keycode >> 8;
+            payload[used++] = keycode & 0xFF;
+            for (uint8_t i = 0; i < count; i++) {
+                via_keymap_stream_read_keycode(via_keymap_stream.offset);
+                via_keymap_stream.offset += 2;
+            }
+            continue;
+        }
+
+        // Collect keycodes up until the start of the next repeated run, or until the packet is full
+        uint8_t *header = &payload[used++];
+        count           = 0;
+        while (count < 128 && via_keymap_stream.offset < via_keymap_stream.end && (capacity - used) >= 2) {
+            uint16_t next = via_keymap_stream.offset + 2;
+            if (count > 0 && next < via_keymap_stream.end && via_keymap_stream_peek_keycode(via_keymap_stream.offset) == via_keymap_stream_peek_keycode(next)) {
+                break;
+            }
+            keycode         = via_keymap_stream_read_keycode(via_keymap_stream.offset);
+            payload[used++] = keycode >> 8;
+            payload[used++] = keycode & 0xFF;
+            via_keymap_stream.offset += 2;
+            count++;
+        }
+        *header = count - 1;
+    }
+    return used;
+}
+
+static bool via_keymap_stream_decode(const uint8_t *payload, uint8_t length) {
+    if (!via_keymap_stream.rle) {
+        via_keymap_stream_write_bytes(payload, length);
+        return true;
+    }
+
+    uint8_t i = 0;
+    while (i < length) {
+        uint8_t token = payload[i++];
+        uint8_t count = (token & 0x7F) + 1;
+        if (token & 0x80) {
+            if (length - i < 2) return false;
+            for (uint8_t j = 0; j < count && via_keymap_stream.offset < via_keymap_stream.end; j++) {
+                via_keymap_stream_write_bytes(&payload[i], 2);
+            }
+            i += 2;
+        } else {
+            if (length - i < count * 2) return false;
+            via_keymap_stream_write_bytes(&payload[i], count * 2);
+            i += count * 2;
+        }
+    }
+    return true;
+}
+
+// Handles the streaming commands, including calling raw_hid_send().
+// Returns false if the command is not a streaming command.
+static bool via_keymap_stream_command(uint8_t *data, uint8_t length) {
+    uint8_t *command_id   = &(data[0]);
+    uint8_t *command_data = &(data[1]);
+
+    switch (*command_id) {
+        case id_dynamic_keymap_stream_begin: {
+            uint16_t offset = (command_data[2] << 8) | command_data[3];
+            uint16_t size   = (command_data[4] << 8) | command_data[5];
+            uint16_t total  = dynamic_keymap_get_layer_count() * MATRIX_ROWS * MATRIX_COLS * 2;
+
+            via_keymap_stream_close(false);
+            via_keymap_stream.write  = command_data[0] == via_keymap_stream_write;
+            via_keymap_stream.rle    = (command_data[1] & via_keymap_stream_rle) != 0;
+            via_keymap_stream.window = command_data[6] ? command_data[6] : 1;
+            via_keymap_stream.seq    = 0;
+            via_keymap_stream.offset = offset;
+            via_keymap_stream.end    = offset + size;
+            via_keymap_stream.crc    = 0xFFFF;
+
+            if (offset > total || size > total - offset || (via_keymap_stream.rle && ((offset | size) & 1))) {
+                command_data[0] = via_keymap_stream_error;
+            } else {
+                via_keymap_stream.active = true;
+                command_data[0]          = via_keymap_stream_ok;
+                if (via_keymap_stream.write) {
+                    dynamic_keymap_hold(true);
+                }
+            }
+            raw_hid_send(data, length);
+            return true;
+        }
+        case id_dynamic_keymap_stream_data: {
+            uint8_t seq = command_data[0];
+#    ifdef DYNAMIC_KEYMAP_RAM_CACHE
+            if (via_keymap_stream.active && via_keymap_stream.write) {
+                if (!dynamic_keymap_is_held()) {
+                    // The hold timed out and what was written so far has been discarded, the host has to start over
+                    via_keymap_stream.active = false;
+                } else {
+                    dynamic_keymap_hold(true);
+                }
+            }
+#    endif
+            if (!via_keymap_stream.active || seq != via_keymap_stream.seq) {
+                command_data[0] = via_keymap_stream.seq;
+                command_data[1] = via_keymap_stream.active ? via_keymap_stream_bad_seq : via_keymap_stream_no_stream;
+                raw_hid_send(data, length);
+                return true;
+            }
+
+            if (!via_keymap_stream.write) {
+                // Send a full window of packets without waiting for the host in between
+                for (uint8_t i = 0; i < via_keymap_stream.window; i++) {
+                    memset(command_data, 0, length - 1);
+                    command_data[0] = via_keymap_stream.seq++;
+                    command_data[1] = via_keymap_stream_encode(&data[VIA_KEYMAP_STREAM_HEADER_SIZE], length - VIA_KEYMAP_STREAM_HEADER_SIZE);
+                    raw_hid_send(data, length);
+                    if (via_keymap_stream.offset >= via_keymap_stream.end) {
+                        break;
+                    }
+                }
+                return true;
+            }
+
+            uint8_t payload_length = command_data[1];
+            bool    ok             = payload_length <= length - VIA_KEYMAP_STREAM_HEADER_SIZE && via_keymap_stream_decode(&data[VIA_KEYMAP_STREAM_HEADER_SIZE], payload_length);
+            via_keymap_stream.seq++;
+
+            // Only acknowledge once per window, so the host can keep several packets in flight
+            if (!ok || (via_keymap_stream.seq % via_keymap_stream.window) == 0 || via_keymap_stream.offset >= via_keymap_stream.end) {
+                command_data[1] = ok ? via_keymap_stream_ok : via_keymap_stream_error;
+                raw_hid_send(data, length);
+            }
+            if (!ok) {
+                via_keymap_stream_close(false);
+            }
+            return true;
+        }
+        case id_dynamic_keymap_stream_end: {
+            uint16_t crc    = (command_data[0] << 8) | command_data[1];
+            uint8_t  status = via_keymap_stream_ok;
+            if (!via_keymap_stream.active) {
+                status = via_keymap_stream_no_stream;
+            } else if (via_keymap_stream.offset != via_keymap_stream.end) {
+                status = via_keymap_stream_error;
+            } else if (via_keymap_stream.write && crc != via_keymap_stream.crc) {
+                status = via_keymap_stream_bad_crc;
+            }
+            via_keymap_stream_close(status == via_keymap_stream_ok);
+
+            command_data[0] = status;
+            command_data[1] = via_keymap_stream.crc >> 8;
+            command_data[2] = via_keymap_stream.crc & 0xFF;
+            raw_hid_send(data, length);
+            return true;
+        }
+        default:
+            return false;
+    }
+}
+
+#endif // VIA_KEYMAP_STREAM_ENABLE
+
 void raw_hid_receive(uint8_t *data, uint8_t length) {
     uint8_t *command_id   = &(data[0]);
     uint8_t *command_data = &(data[1]);
 
+    // lighting and keymap commands may reach subsystems that are not up yet
+    keyboard_deferred_init_finish();
+
     // If via_command_kb() returns true, the command was fully
     // handled, including calling raw_hid_send()
     if (via_command_kb(data, length)) {
         return;
     }
 
+#ifdef VIA_KEYMAP_STREAM_ENABLE
+    // Streaming commands may send zero or several packets in response
+    if (via_keymap_stream_command(data, length)) {
+        return;
+    }
+#endif
+
     switch (*command_id) {
         case id_get_protocol_version: {
             command_data[0] = VIA_PROTOCOL_VERSION >> 8;
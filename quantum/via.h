@@ -92,9 +92,48 @@ enum via_command_id {
     id_dynamic_keymap_set_buffer            = 0x13,
     id_dynamic_keymap_get_encoder           = 0x14,
     id_dynamic_keymap_set_encoder           = 0x15,
+    id_dynamic_keymap_stream_begin          = 0x16,
+    id_dynamic_keymap_stream_data           = 0x17,
+    id_dynamic_keymap_stream_end            = 0x18,
     id_unhandled                            = 0xFF,
 };
 
+// Streaming transfer of the dynamic keymap buffer, enabled with VIA_KEYMAP_STREAM_ENABLE.
+//
+// stream_begin  host -> device  [ id, direction, flags, offset_hi, offset_lo, size_hi, size_lo, window ]
+//               device -> host  same, with data[1] replaced by the status
+// stream_data   host -> device  read:  [ id, seq ] requests the next `window` packets
+//                               write: [ id, seq, length, payload... ]
+//               device -> host  read:  [ id, seq, length, payload... ] x window
+//                               write: [ id, seq, status ] after every `window` packets, the last packet, or an error
+// stream_end    host -> device  [ id, crc_hi, crc_lo ] (crc ignored for reads)
+//               device -> host  [ id, status, crc_hi, crc_lo ]
+//
+// The CRC is CRC-16/CCITT-FALSE over the raw (uncompressed) keymap bytes of the whole transfer.
+// With DYNAMIC_KEYMAP_RAM_CACHE, a write that fails (error, bad CRC, or a new stream_begin before stream_end) is
+// discarded and the previous keymap is restored. Without it, data is written as it arrives, so on failure the host
+// must write the range again. Until a write stream is ended, no keymap changes are committed to EEPROM.
+// With via_keymap_stream_rle set, the payload is a sequence of tokens operating on 16-bit keycodes,
+// which never straddle packets:
+//   0b0nnnnnnn, n+1 keycodes        literal run of n+1 big-endian keycodes
+//   0b1nnnnnnn, keycode             keycode repeated n+1 times
+enum via_keymap_stream_direction {
+    via_keymap_stream_read  = 0x00,
+    via_keymap_stream_write = 0x01,
+};
+
+enum via_keymap_stream_flags {
+    via_keymap_stream_rle = (1 << 0),
+};
+
+enum via_keymap_stream_status {
+    via_keymap_stream_ok        = 0x00,
+    via_keymap_stream_error     = 0x01,
+    via_keymap_stream_bad_seq   = 0x02,
+    via_keymap_stream_bad_crc   = 0x03,
+    via_keymap_stream_no_stream = 0x04,
+};
+
 enum via_keyboard_value_id {
     id_uptime              = 0x01,
     id_layout_options      = 0x02,
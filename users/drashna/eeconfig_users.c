@@ -13,41 +13,46 @@
 #    error "Not enough EEPROM configured for user config."
 #endif
 
-#if (EECONFIG_USER_DATA_SIZE) == 0
-#    define EECONFIG_USER_TEMP EECONFIG_USER
-#else
-#    define EECONFIG_USER_TEMP (uint32_t *)(EECONFIG_USER_DATABLOCK)
+#if (EECONFIG_USER_DATA_SIZE) > 0
+// The datablock is checksummed as a whole by the core, so partial reads and writes go through a copy of all of it
+static uint8_t eeconfig_user_datablock[(EECONFIG_USER_DATA_SIZE)];
+
+void eeconfig_read_user_data_range(void *data, uint16_t offset, uint16_t size) {
+    eeconfig_read_user_datablock(eeconfig_user_datablock);
+    memcpy(data, eeconfig_user_datablock + offset, size);
+}
+
+void eeconfig_update_user_data_range(const void *data, uint16_t offset, uint16_t size) {
+    eeconfig_read_user_datablock(eeconfig_user_datablock);
+    memcpy(eeconfig_user_datablock + offset, data, size);
+    eeconfig_update_user_datablock(eeconfig_user_datablock);
+}
 #endif
 
 void eeconfig_read_user_config(uint32_t *data) {
 #if (EECONFIG_USER_DATA_SIZE) > 0
-    if (!eeconfig_is_user_datablock_valid()) {
-        memset(data, 0, 4);
-    } else
+    eeconfig_read_user_data_range(data, 0, 4);
+#else
+    *data = eeconfig_read_user();
 #endif
-        eeprom_read_block(data, EECONFIG_USER_TEMP, 4);
 }
 
 void eeconfig_update_user_config(const uint32_t *data) {
-    eeprom_update_block(data, EECONFIG_USER_TEMP, 4);
 #if (EECONFIG_USER_DATA_SIZE) > 0
-    eeprom_update_dword(EECONFIG_USER, (EECONFIG_USER_DATA_VERSION));
+    eeconfig_update_user_data_range(data, 0, 4);
+#else
+    eeconfig_update_user(*data);
 #endif
 }
 
 void eeconfig_read_user_data(void *data) {
 #if (EECONFIG_USER_DATA_SIZE) > 4
-    if (eeconfig_is_user_datablock_valid()) {
-        eeprom_read_block(data, EECONFIG_USER_DATABLOCK + 4, (EECONFIG_USER_DATA_SIZE)-4);
-    } else {
-        memset(data, 0, (EECONFIG_USER_DATA_SIZE));
-    }
+    eeconfig_read_user_data_range(data, 4, (EECONFIG_USER_DATA_SIZE)-4);
 #endif
 }
 
 void eeconfig_update_user_data(const void *data) {
 #if (EECONFIG_USER_DATA_SIZE) > 4
-    eeprom_update_dword(EECONFIG_USER, (EECONFIG_USER_DATA_VERSION));
-    eeprom_update_block(data, EECONFIG_USER_DATABLOCK + 4, (EECONFIG_USER_DATA_SIZE)-4);
+    eeconfig_update_user_data_range(data, 4, (EECONFIG_USER_DATA_SIZE)-4);
 #endif
 }
@@ -10,3 +10,7 @@ void eeconfig_update_user_config(const uint32_t *data);
 
 void eeconfig_read_user_data(void *data);
 void eeconfig_update_user_data(const void *data);
+
+// Partial access to the userspace datablock, `offset` being relative to the start of the block
+void eeconfig_read_user_data_range(void *data, uint16_t offset, uint16_t size);
+void eeconfig_update_user_data_range(const void *data, uint16_t offset, uint16_t size);
@@ -9,6 +9,7 @@
 #include "debug.h"
 #include "eeprom.h"
 #include "eeconfig.h"
+#include "eeconfig_users.h"
 #include <string.h>
 
 static uint8_t macro_id        = 255;
@@ -18,7 +19,8 @@ static uint8_t recording_state = STATE_NOT_RECORDING;
 #    error "EECONFIG_USER_DATA_SIZE not set. Don't step on others eeprom."
 #endif
 #ifndef DYNAMIC_MACRO_EEPROM_BLOCK0_ADDR
-#    define DYNAMIC_MACRO_EEPROM_BLOCK0_ADDR (uint8_t*)(EECONFIG_USER_DATABLOCK + 4)
+// Stored in the userspace datablock, after the userspace config
+#    define DYNAMIC_MACRO_USER_DATA_OFFSET 4
 #endif
 
 dynamic_macro_t dynamic_macros[DYNAMIC_MACRO_COUNT];
@@ -243,9 +245,11 @@ uint16_t dynamic_macro_calc_crc(dynamic_macro_t* macro) {
     return crc;
 }
 
+#ifdef DYNAMIC_MACRO_EEPROM_BLOCK0_ADDR
 inline void* dynamic_macro_eeprom_macro_addr(uint8_t macro_id) {
     return DYNAMIC_MACRO_EEPROM_BLOCK0_ADDR + sizeof(dynamic_macro_t) * macro_id;
 }
+#endif
 
 void dynamic_macro_load_eeprom_all(void) {
     for (uint8_t i = 0; i < DYNAMIC_MACRO_COUNT; ++i) {
@@ -256,7 +260,11 @@ void dynamic_macro_load_eeprom_all(void) {
 void dynamic_macro_load_eeprom(uint8_t macro_id) {
     dynamic_macro_t* dst = &dynamic_macros[macro_id];
 
+#ifdef DYNAMIC_MACRO_EEPROM_BLOCK0_ADDR
     eeprom_read_block(dst, dynamic_macro_eeprom_macro_addr(macro_id), sizeof(dynamic_macro_t));
+#else
+    eeconfig_read_user_data_range(dst, DYNAMIC_MACRO_USER_DATA_OFFSET + sizeof(dynamic_macro_t) * macro_id, sizeof(dynamic_macro_t));
+#endif
 
     /* Validate checksum, ifchecksum is NOT valid for macro, set its length to 0 to prevent its use. */
     if (dynamic_macro_calc_crc(dst) != dst->checksum) {
@@ -272,7 +280,11 @@ void dynamic_macro_load_eeprom(uint8_t macro_id) {
 void dynamic_macro_save_eeprom(uint8_t macro_id) {
     dynamic_macro_t* src = &dynamic_macros[macro_id];
 
+#ifdef DYNAMIC_MACRO_EEPROM_BLOCK0_ADDR
     eeprom_update_block(src, dynamic_macro_eeprom_macro_addr(macro_id), sizeof(dynamic_macro_t));
+#else
+    eeconfig_update_user_data_range(src, DYNAMIC_MACRO_USER_DATA_OFFSET + sizeof(dynamic_macro_t) * macro_id, sizeof(dynamic_macro_t));
+#endif
     dprintf("dynamic macro: slot %d saved to eeprom\n", macro_id);
 }
 